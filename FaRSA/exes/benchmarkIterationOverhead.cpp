@@ -0,0 +1,76 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "FaRSAProblem.hpp"
+#include "FaRSASolver.hpp"
+#include "SimpleQuadratic.hpp"
+
+using namespace FaRSA;
+
+// Main function
+int main(int argc, char* argv[])
+{
+
+  // Set usage string
+  std::string usage("Usage: ./benchmarkIterationOverhead [NumberOfSolves] [Dimension]\n"
+                    "       solves a tiny SimpleQuadratic problem repeatedly with all output\n"
+                    "       disabled and reports the average wall-clock time per solve and\n"
+                    "       per iteration (i.e., the fixed per-iteration solver overhead).\n");
+
+  // Read arguments
+  int number_of_solves = (argc > 1) ? atoi(argv[1]) : 100000;
+  int dimension = (argc > 2) ? atoi(argv[2]) : 2;
+
+  // Check arguments
+  if (number_of_solves <= 0 || dimension <= 0) {
+    printf("Invalid arguments. Quitting.\n");
+    printf("%s", usage.c_str());
+    return 1;
+  }
+
+  // Declare problem
+  std::shared_ptr<Problem> problem = std::make_shared<SimpleQuadratic>(dimension);
+
+  // Declare solver object (without output)
+  FaRSASolver farsa;
+  farsa.reporter()->deleteReports();
+
+  // Set default benchmark strategies (monotone Armijo line search with unit initial stepsize)
+  farsa.options()->modifyStringValue(farsa.reporter(), "direction_computation", "ProximalGradient");
+  farsa.options()->modifyStringValue(farsa.reporter(), "line_search", "Backtracking");
+  farsa.options()->modifyStringValue(farsa.reporter(), "LSB_stepsize_initialization", "constant");
+  farsa.options()->modifyDoubleValue(farsa.reporter(), "LSB_stepsize_initial", 1.0);
+
+  // Modify options from file
+  farsa.options()->modifyOptionsFromFile(farsa.reporter(), "farsa.opt");
+
+  // Solve repeatedly
+  long long total_iterations = 0;
+  int number_successful = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < number_of_solves; i++) {
+    farsa.optimize(problem);
+    total_iterations += farsa.iterations();
+    number_successful += (farsa.status() == FARSA_SUCCESS) ? 1 : 0;
+  } // end for
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Print results
+  printf("Number of solves.................... : %d (%d successful)\n", number_of_solves, number_successful);
+  printf("Number of variables................. : %d\n", dimension);
+  printf("Average iterations per solve........ : %.2f\n", (double)total_iterations / (double)number_of_solves);
+  printf("Average time per solve (us)......... : %.3f\n", 1e+06 * elapsed / (double)number_of_solves);
+  printf("Average time per iteration (us)..... : %.3f\n", 1e+06 * elapsed / (double)(total_iterations > 0 ? total_iterations : 1));
+
+  // Return
+  return 0;
+
+} // end main
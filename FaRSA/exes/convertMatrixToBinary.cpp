@@ -0,0 +1,62 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "FaRSADeclarations.hpp"
+#include "FaRSAMatrix.hpp"
+
+using namespace FaRSA;
+
+// Main function
+int main(int argc, char* argv[])
+{
+
+  // Set usage string
+  std::string usage("Usage: ./convertMatrixToBinary InputFile OutputFile [ValueType]\n"
+                    "       where InputFile is a matrix in coordinate list text format\n"
+                    "             or a Matrix Market coordinate file,\n"
+                    "             OutputFile is the binary file to write (compressed sparse row,\n"
+                    "             memory-mapped and streamed when loaded, e.g., by LogisticRegression),\n"
+                    "             ValueType is double (default) or float; all-ones data is\n"
+                    "             written without values.\n");
+
+  // Check number of input arguments
+  if (argc < 3) {
+    printf("Too few arguments. Quitting.\n");
+    printf("%s", usage.c_str());
+    return 1;
+  }
+
+  // Set value type
+  MatrixValueType value_type = M_VALUE_DOUBLE;
+  if (argc > 3) {
+    if (strcmp(argv[3], "float") == 0) {
+      value_type = M_VALUE_FLOAT;
+    }
+    else if (strcmp(argv[3], "double") != 0) {
+      printf("Invalid value type. Quitting.\n");
+      printf("%s", usage.c_str());
+      return 1;
+    }
+  } // end if
+
+  // Convert matrix
+  try {
+    Matrix matrix;
+    matrix.setFromFile(argv[1], Matrix::isMatrixMarketFile(argv[1]) ? M_COMPRESSED_SPARSE_COLUMN : M_COORDINATE_LIST, value_type, true);
+    matrix.writeToBinaryFile(argv[2]);
+  } catch (FARSA_MATRIX_EXCEPTION& exec) {
+    printf("Conversion failed. Quitting.\n");
+    return 1;
+  }
+
+  // Return
+  return 0;
+
+} // end main
@@ -0,0 +1,46 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cstdio>
+#include <string>
+
+#include "FaRSADeclarations.hpp"
+#include "FaRSAVector.hpp"
+
+using namespace FaRSA;
+
+// Main function
+int main(int argc, char* argv[])
+{
+
+  // Set usage string
+  std::string usage("Usage: ./convertVectorToBinary InputFile OutputFile\n"
+                    "       where InputFile is a vector in text format (length followed by\n"
+                    "             elements), e.g., labels or an initial point,\n"
+                    "             OutputFile is the binary file to write (memory-mapped when\n"
+                    "             loaded, e.g., by LogisticRegression).\n");
+
+  // Check number of input arguments
+  if (argc < 3) {
+    printf("Too few arguments. Quitting.\n");
+    printf("%s", usage.c_str());
+    return 1;
+  }
+
+  // Convert vector
+  try {
+    Vector vector;
+    vector.setFromFile(argv[1]);
+    vector.writeToBinaryFile(argv[2]);
+  } catch (FARSA_VECTOR_EXCEPTION& exec) {
+    printf("Conversion failed. Quitting.\n");
+    return 1;
+  }
+
+  // Return
+  return 0;
+
+} // end main
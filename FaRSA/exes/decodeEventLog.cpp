@@ -0,0 +1,40 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cstdio>
+#include <string>
+
+#include "FaRSAEventLog.hpp"
+
+using namespace FaRSA;
+
+// Main function
+int main(int argc, char* argv[])
+{
+
+  // Set usage string
+  std::string usage("Usage: ./decodeEventLog InputFile\n"
+                    "       where InputFile is a binary event log (see option event_log_file);\n"
+                    "             one line per record (event name, then field=value pairs)\n"
+                    "             is written to standard output.\n");
+
+  // Check number of input arguments
+  if (argc < 2) {
+    printf("Too few arguments. Quitting.\n");
+    printf("%s", usage.c_str());
+    return 1;
+  }
+
+  // Decode event log
+  if (!EventLog::decode(argv[1], stdout)) {
+    fprintf(stderr, "Decoding failed (not an event log or truncated). Quitting.\n");
+    return 1;
+  }
+
+  // Return
+  return 0;
+
+} // end main
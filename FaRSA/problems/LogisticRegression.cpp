@@ -5,36 +5,82 @@
 // Author(s) : Frank E. Curtis, Daniel P. Robinson
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unistd.h>
 
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
 #include "LogisticRegression.hpp"
 
 // Constructor
 LogisticRegression::LogisticRegression(char* features_file,
                                        char* labels_file,
                                        char* groups_file,
-                                       char* initial_point_file)
+                                       char* initial_point_file,
+                                       MatrixValueType feature_value_type,
+                                       bool block_features_by_groups,
+                                       int number_of_processes,
+                                       bool cache_data)
+  : weights_computed_(false),
+    working_set_restricted_(false)
 {
 
-  // Read feature data
-  features_.setFromFile(features_file, M_COORDINATE_LIST);
+  // Check for data-parallel evaluation
+  if (number_of_processes <= 1) {
+    readData(features_file, labels_file, groups_file, initial_point_file, feature_value_type, block_features_by_groups, cache_data);
+    computeCurvatureBounds();
+    return;
+  }
 
-  // Read label data
-  labels_.setFromFile(labels_file);
+  // Spawn processes (every process returns here with its own rank)
+  communicator_ = std::make_shared<SharedMemoryCommunicator>(number_of_processes);
+  if (!communicator_->spawnProcesses()) {
+    THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Failed to spawn processes.");
+  }
 
-  // Read group data
-  setGroupsFromFile(groups_file);
+  // Read data in every process (each keeps its shard of rows)
+  double failures = 0.0;
+  try {
+    readData(features_file, labels_file, groups_file, initial_point_file, feature_value_type, block_features_by_groups, cache_data);
+  } catch (...) {
+    failures = 1.0;
+  }
 
-  // Read initial point
-  initial_point_.setFromFile(initial_point_file);
+  // Check for failure in any process
+  communicator_->allReduceSum(&failures, 1);
+  if (failures > 0.0) {
+    if (communicator_->rank() != 0) {
+      _exit(1);
+    }
+    THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Failed to read data.");
+  } // end if
 
-  // Set numbers of variables and data points
-  number_of_variables_ = features_.numberOfColumns();
-  number_of_data_points_ = features_.numberOfRows();
+  // Compute curvature bounds in every process (sums over processes)
+  computeCurvatureBounds();
+
+  // Serve requests from rank 0 (processes other than rank 0 never return)
+  if (communicator_->rank() != 0) {
+    serveRequests();
+    _exit(0);
+  }
 
 } // end constructor
 
 // Destructor
-LogisticRegression::~LogisticRegression(){}
+LogisticRegression::~LogisticRegression()
+{
+
+  // Terminate other processes
+  if (communicator_ != nullptr && communicator_->rank() == 0) {
+    std::vector<int> groups;
+    std::vector<double> x, v;
+    int request = REQUEST_TERMINATE;
+    exchangeRequest(request, groups, x, v);
+  }
+
+} // end destructor
 
 // Initial point
 bool LogisticRegression::initialPoint(double* x)
@@ -50,13 +96,97 @@ bool LogisticRegression::initialPoint(double* x)
 
 } // end initialPoint
 
+// Curvature bounds
+bool LogisticRegression::curvatureBounds(double* variable_bounds,
+                                         double* group_bounds)
+{
+
+  // Check for bounds
+  if ((int)variable_curvature_bounds_.size() != number_of_variables_) {
+    return false;
+  }
+
+  // Set bounds
+  for (int i = 0; i < number_of_variables_; i++) {
+    variable_bounds[i] = variable_curvature_bounds_[i];
+  }
+  for (int i = 0; i < (int)group_curvature_bounds_.size(); i++) {
+    group_bounds[i] = group_curvature_bounds_[i];
+  }
+
+  // Return
+  return true;
+
+} // end curvatureBounds
+
+// Lipschitz constant estimate
+bool LogisticRegression::estimateLipschitzConstant(const std::vector<int>& groups,
+                                                   double& lipschitz_constant)
+{
+
+  // Check for out-of-core data (column views unavailable)
+  if (groups.size() > 0 && features_.isMapped()) {
+    return false;
+  }
+
+  // Set columns corresponding to groups (empty for all columns)
+  std::vector<int> columns;
+  for (int i = 0; i < (int)groups.size(); i++) {
+    const std::vector<int>& group = groups_.at(groups.at(i));
+    columns.insert(columns.end(), group.begin(), group.end());
+  } // end for
+
+  // Send request to other processes
+  if (!sendRequest(REQUEST_LIPSCHITZ_ESTIMATE, groups, nullptr, nullptr, 0)) {
+    return false;
+  }
+
+  // Estimate squared spectral norm (Gram products summed over processes)
+  std::function<bool(double*, int)> sum;
+  if (communicator_ != nullptr) {
+    sum = [&](double* values, int length) { return communicator_->allReduceSum(values, length); };
+  }
+  double squared_norm;
+  if (!features_.estimateSquaredSpectralNorm(columns, FARSA_POWER_ITERATION_LIMIT, FARSA_POWER_ITERATION_TOLERANCE, sum, squared_norm)) {
+    return false;
+  }
+
+  // Set estimate (logistic loss has second derivative at most 1/4)
+  lipschitz_constant = (number_of_data_points_ > 0) ? 0.25 * squared_norm / (double)number_of_data_points_ : 0.0;
+
+  // Return
+  return true;
+
+} // end estimateLipschitzConstant
+
 // Objective value
 bool LogisticRegression::evaluateObjective(const double* x,
                                            double& f)
 {
 
-  // Evaluate function
-  f = 0.0;
+  // Send request to other processes
+  if (!sendRequest(REQUEST_OBJECTIVE, std::vector<int>(), x, nullptr, 0)) {
+    return false;
+  }
+
+  // Compute inner products
+  computeInnerProducts(x);
+
+  // Evaluate function, log(1 + exp(t)) evaluated stably
+  f = sumDataPoints([&](long long begin, long long end) {
+    double sum = 0.0;
+    for (long long i = begin; i < end; i++) {
+      double t = -labels_.values()[i] * inner_products_.values()[i];
+      sum += (t > 0.0) ? t + log1p(exp(-t)) : log1p(exp(t));
+    } // end for
+    return sum;
+  });
+
+  // Sum over processes
+  if (communicator_ != nullptr && !communicator_->allReduceSum(&f, 1)) {
+    return false;
+  }
+  f /= (double)number_of_data_points_;
 
   // Return
   return true;
@@ -68,14 +198,61 @@ bool LogisticRegression::evaluateGradient(const double* x,
                                           double* g)
 {
 
-  // Evaluate gradient
-  int count = 0;
-  for (int i = 0; i < groups_.size(); i++) {
-    for (int j = 0; j < groups_[i].size(); j++) {
-      g[count] = 0.0;
-      count++;
+  // Send request to other processes
+  if (!sendRequest(REQUEST_GRADIENT, std::vector<int>(), x, nullptr, 0)) {
+    return false;
+  }
+
+  // Compute inner products
+  computeInnerProducts(x);
+
+  // Compute gradient weights (separate from curvature weights, which remain valid for
+  // products at this point)
+  double* weights = gradient_weights_.valuesModifiable();
+  forDataPoints([&](long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+      double y = labels_.values()[i];
+      weights[i] = -y / (1.0 + exp(y * inner_products_.values()[i])) / (double)number_of_data_points_;
     } // end for
-  } // end for
+  });
+
+  // Evaluate gradient (column views unavailable for out-of-core data)
+  if (working_set_restricted_ && !features_.isMapped()) {
+
+    // Evaluate gradient elements for working columns
+    Vector g_working((int)working_columns_.size());
+    if (features_.isBlockedByGroups()) {
+      features_.matrixTransposeVectorProductGroups(working_groups_, gradient_weights_, g_working);
+    }
+    else {
+      features_.matrixTransposeVectorProductColumns(working_columns_, gradient_weights_, g_working);
+    }
+
+    // Sum over processes (working columns only)
+    if (communicator_ != nullptr && !communicator_->allReduceSum(g_working.valuesModifiable(), g_working.length())) {
+      return false;
+    }
+
+    // Set gradient elements for working columns (others are zero on entry)
+    for (int k = 0; k < (int)working_columns_.size(); k++) {
+      g[working_columns_[k]] = g_working.values()[k];
+    }
+
+  } // end if
+  else {
+
+    // Evaluate full gradient
+    features_.matrixTransposeVectorProduct(gradient_weights_, gradient_full_);
+    for (int i = 0; i < number_of_variables_; i++) {
+      g[i] = gradient_full_.values()[i];
+    }
+
+    // Sum over processes
+    if (communicator_ != nullptr && !communicator_->allReduceSum(g, number_of_variables_)) {
+      return false;
+    }
+
+  } // end else
 
   // Return
   return true;
@@ -89,20 +266,195 @@ bool LogisticRegression::evaluateHessianVectorProduct(const double* x,
                                                       double* Hv)
 {
 
-  // Evaluate product
-  int count = 0;
-  for (int i = 0; i < groups.size(); i++) {
-    for (int j = 0; j < groups_.at(groups.at(i)).size(); j++) {
-      Hv[count] = 0.0;
-      count++;
-    } // end for
+  // Set columns corresponding to groups
+  std::vector<int> columns;
+  for (int i = 0; i < (int)groups.size(); i++) {
+    const std::vector<int>& group = groups_.at(groups.at(i));
+    columns.insert(columns.end(), group.begin(), group.end());
   } // end for
 
+  // Send request to other processes
+  if (!sendRequest(REQUEST_HESSIAN_VECTOR_PRODUCT, groups, x, v, (int)columns.size())) {
+    return false;
+  }
+
+  // Compute curvature weights
+  computeCurvatureWeights(x);
+
+  // Compute product of column view with v
+  Vector v_columns((int)columns.size());
+  v_columns.copyArray((double*)v);
+  Vector product(number_of_local_data_points_);
+  if (features_.isMapped()) {
+    Vector v_full(number_of_variables_);
+    for (int k = 0; k < (int)columns.size(); k++) {
+      v_full.valuesModifiable()[columns[k]] = v[k];
+    }
+    features_.matrixVectorProduct(v_full, product);
+  }
+  else if (features_.isBlockedByGroups()) {
+    features_.matrixVectorProductGroups(groups, v_columns, product);
+  }
+  else {
+    features_.matrixVectorProductColumns(columns, v_columns, product);
+  }
+
+  // Apply curvature weights
+  for (int i = 0; i < number_of_local_data_points_; i++) {
+    product.valuesModifiable()[i] *= weights_.values()[i];
+  }
+
+  // Compute product of column view transpose with weighted product
+  Vector Hv_columns((int)columns.size());
+  if (features_.isMapped()) {
+    Vector Hv_full(number_of_variables_);
+    features_.matrixTransposeVectorProduct(product, Hv_full);
+    for (int k = 0; k < (int)columns.size(); k++) {
+      Hv_columns.valuesModifiable()[k] = Hv_full.values()[columns[k]];
+    }
+  }
+  else if (features_.isBlockedByGroups()) {
+    features_.matrixTransposeVectorProductGroups(groups, product, Hv_columns);
+  }
+  else {
+    features_.matrixTransposeVectorProductColumns(columns, product, Hv_columns);
+  }
+  for (int k = 0; k < (int)columns.size(); k++) {
+    Hv[k] = Hv_columns.values()[k];
+  }
+
+  // Sum over processes
+  if (communicator_ != nullptr && !communicator_->allReduceSum(Hv, (int)columns.size())) {
+    return false;
+  }
+
   // Return
   return true;
 
 } // end evaluateHessianVectorProduct
 
+// Hessian diagonal
+bool LogisticRegression::evaluateHessianDiagonal(const double* x,
+                                                 const std::vector<int> groups,
+                                                 double* d)
+{
+
+  // Check for out-of-core data (column views unavailable)
+  if (features_.isMapped()) {
+    return false;
+  }
+
+  // Set columns corresponding to groups
+  std::vector<int> columns;
+  for (int i = 0; i < (int)groups.size(); i++) {
+    const std::vector<int>& group = groups_.at(groups.at(i));
+    columns.insert(columns.end(), group.begin(), group.end());
+  } // end for
+
+  // Send request to other processes
+  if (!sendRequest(REQUEST_HESSIAN_DIAGONAL, groups, x, nullptr, 0)) {
+    return false;
+  }
+
+  // Compute curvature weights
+  computeCurvatureWeights(x);
+
+  // Compute curvature-weighted squared column norms
+  Vector d_columns((int)columns.size());
+  if (features_.isBlockedByGroups()) {
+    features_.squaredMatrixTransposeVectorProductGroups(groups, weights_, d_columns);
+  }
+  else {
+    features_.squaredMatrixTransposeVectorProductColumns(columns, weights_, d_columns);
+  }
+  for (int k = 0; k < (int)columns.size(); k++) {
+    d[k] = d_columns.values()[k];
+  }
+
+  // Sum over processes
+  if (communicator_ != nullptr && !communicator_->allReduceSum(d, (int)columns.size())) {
+    return false;
+  }
+
+  // Return
+  return true;
+
+} // end evaluateHessianDiagonal
+
+// Set working groups
+bool LogisticRegression::setWorkingGroups(const std::vector<int>& groups)
+{
+
+  // Check groups
+  for (int i = 0; i < (int)groups.size(); i++) {
+    if (groups[i] < 0 || groups[i] >= (int)groups_.size()) {
+      return false;
+    }
+  } // end for
+
+  // Send request to other processes
+  if (!sendRequest(REQUEST_WORKING_GROUPS, groups, nullptr, nullptr, 0)) {
+    return false;
+  }
+
+  // Check for all groups
+  if (groups.size() == 0) {
+    working_set_restricted_ = false;
+    working_columns_.clear();
+    working_groups_.clear();
+    return true;
+  } // end if
+
+  // Set columns corresponding to working groups
+  working_columns_.clear();
+  for (int i = 0; i < (int)groups.size(); i++) {
+    working_columns_.insert(working_columns_.end(), groups_[groups[i]].begin(), groups_[groups[i]].end());
+  } // end for
+  working_groups_ = groups;
+  working_set_restricted_ = true;
+
+  // Return
+  return true;
+
+} // end setWorkingGroups
+
+// Set thread pool
+bool LogisticRegression::setThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+
+  // Send number of threads to other processes (each runs its own pool, unpinned, so
+  // threads of processes are not pinned to the same CPUs)
+  std::vector<int> settings = {thread_pool ? thread_pool->numberOfThreads() : 0,
+                               (thread_pool && thread_pool->deterministicReductions()) ? 1 : 0};
+  if (!sendRequest(REQUEST_THREAD_POOL, settings, nullptr, nullptr, 0)) {
+    return false;
+  }
+
+  // Store thread pool (also used by products with feature data)
+  thread_pool_ = thread_pool;
+  features_.setThreadPool(thread_pool);
+
+  // Return
+  return true;
+
+} // end setThreadPool
+
+// Set placement
+bool LogisticRegression::setPlacement(Placement& placement)
+{
+
+  // Place data (features by nonzeros per column; vectors by data points)
+  features_.place(placement, "features");
+  labels_.place(placement, "labels");
+  inner_products_.place(placement, "inner products");
+  gradient_weights_.place(placement, "gradient weights");
+  weights_.place(placement, "weights");
+
+  // Return
+  return true;
+
+} // end setPlacement
+
 // Finalize solution
 bool LogisticRegression::finalizeSolution(const double* x,
                                           double f,
@@ -111,8 +463,426 @@ bool LogisticRegression::finalizeSolution(const double* x,
   return true;
 }
 
+// Compute curvature bounds
+void LogisticRegression::computeCurvatureBounds()
+{
+
+  // Set squared column norms of feature data (of shard, norms computed when data was loaded)
+  const std::vector<double>& column_norms = features_.columnNorms();
+  std::vector<double> squared_column_norms(number_of_variables_);
+  for (int j = 0; j < number_of_variables_; j++) {
+    squared_column_norms[j] = column_norms[j] * column_norms[j];
+  }
+
+  // Sum over processes (bounds unavailable on failure)
+  if (communicator_ != nullptr && !communicator_->allReduceSum(squared_column_norms.data(), number_of_variables_)) {
+    return;
+  }
+
+  // Set variable bounds (logistic loss has second derivative at most 1/4)
+  double scale = (number_of_data_points_ > 0) ? 0.25 / (double)number_of_data_points_ : 0.0;
+  variable_curvature_bounds_.resize(number_of_variables_);
+  for (int j = 0; j < number_of_variables_; j++) {
+    variable_curvature_bounds_[j] = scale * squared_column_norms[j];
+  }
+
+  // Set group bounds (squared Frobenius norm bounds squared spectral norm of group columns)
+  group_curvature_bounds_.assign(groups_.size(), 0.0);
+  for (int i = 0; i < (int)groups_.size(); i++) {
+    for (int j = 0; j < (int)groups_[i].size(); j++) {
+      group_curvature_bounds_[i] += variable_curvature_bounds_[groups_[i][j]];
+    }
+  } // end for
+
+} // end computeCurvatureBounds
+
+// Compute curvature weights
+void LogisticRegression::computeCurvatureWeights(const double* x)
+{
+
+  // Check whether weights were computed at this point (e.g., previous product in CG)
+  if (weights_computed_) {
+    bool same_point = true;
+    for (int j = 0; j < number_of_variables_; j++) {
+      if (weights_point_.values()[j] != x[j]) {
+        same_point = false;
+        break;
+      }
+    } // end for
+    if (same_point) {
+      return;
+    }
+  } // end if
+
+  // Compute inner products
+  computeInnerProducts(x);
+
+  // Compute curvature weights
+  double* weights = weights_.valuesModifiable();
+  forDataPoints([&](long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+      double sigma = 1.0 / (1.0 + exp(-inner_products_.values()[i]));
+      weights[i] = sigma * (1.0 - sigma) / (double)number_of_data_points_;
+    } // end for
+  });
+
+  // Store point
+  weights_point_.copyArray((double*)x);
+  weights_computed_ = true;
+
+} // end computeCurvatureWeights
+
+// Compute inner products
+void LogisticRegression::computeInnerProducts(const double* x)
+{
+
+  // Check for restriction to working set (column views unavailable for out-of-core data)
+  if (working_set_restricted_ && !features_.isMapped()) {
+
+    // Multiply by working columns only (point is zero outside of working groups)
+    Vector x_working((int)working_columns_.size());
+    for (int k = 0; k < (int)working_columns_.size(); k++) {
+      x_working.valuesModifiable()[k] = x[working_columns_[k]];
+    }
+    if (features_.isBlockedByGroups()) {
+      features_.matrixVectorProductGroups(working_groups_, x_working, inner_products_);
+    }
+    else {
+      features_.matrixVectorProductColumns(working_columns_, x_working, inner_products_);
+    }
+
+  } // end if
+  else {
+
+    // Multiply by all columns
+    Vector x_full(number_of_variables_);
+    x_full.copyArray((double*)x);
+    features_.matrixVectorProduct(x_full, inner_products_);
+
+  } // end else
+
+} // end computeInnerProducts
+
+// Run body over data points
+void LogisticRegression::forDataPoints(const std::function<void(long long, long long)>& body) const
+{
+
+  // Run on thread pool, if set and there are many data points, otherwise serially
+  if (thread_pool_ && number_of_local_data_points_ > FARSA_THREAD_POOL_GRAIN_SIZE) {
+    thread_pool_->parallelFor(0, number_of_local_data_points_, FARSA_THREAD_POOL_GRAIN_SIZE, body);
+  }
+  else {
+    body(0, number_of_local_data_points_);
+  }
+
+} // end forDataPoints
+
+// Read data
+void LogisticRegression::readData(char* features_file,
+                                  char* labels_file,
+                                  char* groups_file,
+                                  char* initial_point_file,
+                                  MatrixValueType feature_value_type,
+                                  bool block_features_by_groups,
+                                  bool cache_data)
+{
+
+  // Read feature data (binary file is memory-mapped and streamed by rows, out-of-core;
+  // otherwise compressed sparse column for column views; binary data stored as pattern;
+  // text data cached in sidecar if requested)
+  if (Matrix::isBinaryFile(features_file)) {
+    features_.setFromBinaryFile(features_file);
+  }
+  else {
+    features_.setFromFile(features_file, M_COMPRESSED_SPARSE_COLUMN, feature_value_type, true, cache_data);
+  }
+
+  // Read label data
+  Vector labels;
+  labels.setFromFile(labels_file, cache_data);
+
+  // Set numbers of variables and data points
+  number_of_variables_ = features_.numberOfColumns();
+  number_of_data_points_ = features_.numberOfRows();
+
+  // Keep shard of rows of this process (out-of-core rows of other shards are never read)
+  int row_begin = 0;
+  int row_end = number_of_data_points_;
+  if (communicator_ != nullptr) {
+    row_begin = (int)((long long)number_of_data_points_ * communicator_->rank() / communicator_->size());
+    row_end = (int)((long long)number_of_data_points_ * (communicator_->rank() + 1) / communicator_->size());
+    features_.restrictToRows(row_begin, row_end);
+  } // end if
+  number_of_local_data_points_ = row_end - row_begin;
+  labels_.setLength(number_of_local_data_points_);
+  labels_.copyArray((double*)labels.values() + row_begin);
+
+  // Read group data
+  setGroupsFromFile(groups_file, cache_data);
+
+  // Block feature columns by groups
+  if (block_features_by_groups && features_.sparseFormat() == M_COMPRESSED_SPARSE_COLUMN) {
+    features_.blockColumnsByGroups(groups_);
+  }
+
+  // Read initial point
+  initial_point_.setFromFile(initial_point_file, cache_data);
+
+  // Allocate work vectors
+  inner_products_.setLength(number_of_local_data_points_);
+  gradient_weights_.setLength(number_of_local_data_points_);
+  gradient_full_.setLength(number_of_variables_);
+  weights_.setLength(number_of_local_data_points_);
+  weights_point_.setLength(number_of_variables_);
+
+} // end readData
+
+// Send request
+bool LogisticRegression::sendRequest(int request,
+                                     const std::vector<int>& groups,
+                                     const double* x,
+                                     const double* v,
+                                     int v_length)
+{
+
+  // Check for rank 0 of data-parallel evaluation
+  if (communicator_ == nullptr || communicator_->rank() != 0) {
+    return true;
+  }
+
+  // Set request data
+  std::vector<int> request_groups(groups);
+  std::vector<double> request_x, request_v;
+  if (x != nullptr) {
+    request_x.assign(x, x + number_of_variables_);
+  }
+  if (v != nullptr) {
+    request_v.assign(v, v + v_length);
+  }
+
+  // Exchange request
+  return exchangeRequest(request, request_groups, request_x, request_v);
+
+} // end sendRequest
+
+// Exchange request
+bool LogisticRegression::exchangeRequest(int& request,
+                                         std::vector<int>& groups,
+                                         std::vector<double>& x,
+                                         std::vector<double>& v)
+{
+
+  // Broadcast request and lengths
+  double header[4] = {(double)request, (double)groups.size(), (double)x.size(), (double)v.size()};
+  if (!communicator_->broadcast(header, 4)) {
+    return false;
+  }
+  request = (int)header[0];
+
+  // Broadcast groups
+  std::vector<double> groups_values(groups.begin(), groups.end());
+  groups_values.resize((size_t)header[1]);
+  if (!communicator_->broadcast(groups_values.data(), (int)groups_values.size())) {
+    return false;
+  }
+  groups.assign(groups_values.begin(), groups_values.end());
+
+  // Broadcast point and vector
+  x.resize((size_t)header[2]);
+  v.resize((size_t)header[3]);
+  return (communicator_->broadcast(x.data(), (int)x.size()) &&
+          communicator_->broadcast(v.data(), (int)v.size()));
+
+} // end exchangeRequest
+
+// Serve requests
+void LogisticRegression::serveRequests()
+{
+
+  // Loop until terminated
+  while (true) {
+
+    // Receive request
+    int request = REQUEST_TERMINATE;
+    std::vector<int> groups;
+    std::vector<double> x, v;
+    if (!exchangeRequest(request, groups, x, v)) {
+      return;
+    }
+
+    // Evaluate shard (evaluations sum results over processes)
+    if (request == REQUEST_OBJECTIVE) {
+      double f;
+      evaluateObjective(x.data(), f);
+    }
+    else if (request == REQUEST_GRADIENT) {
+      std::vector<double> g(number_of_variables_);
+      evaluateGradient(x.data(), g.data());
+    }
+    else if (request == REQUEST_HESSIAN_VECTOR_PRODUCT) {
+      std::vector<double> Hv(v.size());
+      evaluateHessianVectorProduct(x.data(), groups, v.data(), Hv.data());
+    }
+    else if (request == REQUEST_HESSIAN_DIAGONAL) {
+      int length = 0;
+      for (int i = 0; i < (int)groups.size(); i++) {
+        length += (int)groups_[groups[i]].size();
+      }
+      std::vector<double> d(length);
+      evaluateHessianDiagonal(x.data(), groups, d.data());
+    }
+    else if (request == REQUEST_WORKING_GROUPS) {
+      setWorkingGroups(groups);
+    }
+    else if (request == REQUEST_THREAD_POOL && groups.size() == 2) {
+      std::shared_ptr<ThreadPool> thread_pool = thread_pool_;
+      if (!thread_pool || thread_pool->numberOfThreads() != groups[0]) {
+        thread_pool = (groups[0] > 0) ? std::make_shared<ThreadPool>(groups[0], false) : nullptr;
+      }
+      if (thread_pool) {
+        thread_pool->setDeterministicReductions(groups[1] != 0);
+      }
+      setThreadPool(thread_pool);
+    }
+    else if (request == REQUEST_LIPSCHITZ_ESTIMATE) {
+      double lipschitz_constant;
+      estimateLipschitzConstant(groups, lipschitz_constant);
+    }
+    else {
+      return;
+    }
+
+  } // end while
+
+} // end serveRequests
+
+// Set groups from cache
+bool LogisticRegression::setGroupsFromCache(const FileCache& cache)
+{
+
+  // Read number of groups
+  long long number_of_groups;
+  if (cache.length() < sizeof(long long)) {
+    return false;
+  }
+  memcpy(&number_of_groups, cache.data(), sizeof(long long));
+  if (number_of_groups < 0 || (cache.length() - sizeof(long long)) / sizeof(int) < (size_t)number_of_groups) {
+    return false;
+  }
+
+  // Read group sizes and check length of data (sizes and members, padded to a multiple of 8 bytes)
+  const int* group_sizes = (const int*)(cache.data() + sizeof(long long));
+  long long number_of_members = 0;
+  for (long long i = 0; i < number_of_groups; i++) {
+    if (group_sizes[i] < 0) {
+      return false;
+    }
+    number_of_members += group_sizes[i];
+  } // end for
+  if (cache.length() != sizeof(long long) + ((number_of_groups + 1) / 2 + (number_of_members + 1) / 2) * 2 * sizeof(int)) {
+    return false;
+  }
+
+  // Read groups (members are checked, since features may have changed)
+  const int* members = group_sizes + (number_of_groups + 1) / 2 * 2;
+  std::vector<std::vector<int> > groups((size_t)number_of_groups);
+  for (long long i = 0; i < number_of_groups; i++) {
+    groups[i].assign(members, members + group_sizes[i]);
+    for (int j = 0; j < group_sizes[i]; j++) {
+      if (groups[i][j] < 0 || groups[i][j] >= number_of_variables_) {
+        return false;
+      }
+    } // end for
+    members += group_sizes[i];
+  } // end for
+
+  // Set groups
+  groups_.swap(groups);
+
+  // Return
+  return true;
+
+} // end setGroupsFromCache
+
 // Set groups from file
-void LogisticRegression::setGroupsFromFile(char* groups_file)
+void LogisticRegression::setGroupsFromFile(char* groups_file,
+                                           bool use_cache)
 {
 
-}
+  // Read groups from sidecar, if sidecar matches file
+  std::unique_ptr<FileCache> cache;
+  if (use_cache) {
+    cache.reset(new FileCache(groups_file, C_GROUP_DATA, 0));
+    if (cache->map() && setGroupsFromCache(*cache)) {
+      return;
+    }
+  } // end if
+
+  // Open file
+  FILE* f_in = fopen(groups_file, "r");
+
+  // Check for failed opening
+  if (f_in == NULL) {
+    THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Failed to open groups file.");
+  }
+
+  // Read number of groups (assumed first entry in file)
+  int number_of_groups;
+  int scan_value = fscanf(f_in, "%d", &number_of_groups);
+  if (scan_value != 1 || number_of_groups < 0) {
+    fclose(f_in);
+    THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Number of groups not read.");
+  }
+
+  // Read groups (assumes each group given as size followed by variable indices)
+  groups_.clear();
+  groups_.resize(number_of_groups);
+  for (int i = 0; i < number_of_groups; i++) {
+    int group_size;
+    if (fscanf(f_in, "%d", &group_size) != 1 || group_size < 0) {
+      fclose(f_in);
+      THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Group size not read.");
+    }
+    groups_[i].resize(group_size);
+    for (int j = 0; j < group_size; j++) {
+      if (fscanf(f_in, "%d", &groups_[i][j]) != 1 || groups_[i][j] < 0 || groups_[i][j] >= number_of_variables_) {
+        fclose(f_in);
+        THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Invalid group member read.");
+      }
+    } // end for
+  }   // end for
+
+  // Close file
+  fclose(f_in);
+
+  // Write number of groups, group sizes, and members to sidecar (failure is ignored)
+  if (use_cache) {
+    long long number_of_groups_written = number_of_groups;
+    std::vector<int> group_sizes(number_of_groups);
+    std::vector<int> members;
+    for (int i = 0; i < number_of_groups; i++) {
+      group_sizes[i] = (int)groups_[i].size();
+      members.insert(members.end(), groups_[i].begin(), groups_[i].end());
+    } // end for
+    std::vector<std::pair<const void*, size_t> > parts;
+    parts.push_back(std::make_pair((const void*)&number_of_groups_written, sizeof(long long)));
+    parts.push_back(std::make_pair((const void*)group_sizes.data(), group_sizes.size() * sizeof(int)));
+    parts.push_back(std::make_pair((const void*)members.data(), members.size() * sizeof(int)));
+    cache->write(parts);
+  } // end if
+
+} // end setGroupsFromFile
+
+// Sum body over data points
+double LogisticRegression::sumDataPoints(const std::function<double(long long, long long)>& body) const
+{
+
+  // Sum on thread pool, if set and there are many data points, otherwise serially
+  if (thread_pool_ && number_of_local_data_points_ > FARSA_THREAD_POOL_GRAIN_SIZE) {
+    return thread_pool_->parallelSum(0, number_of_local_data_points_, FARSA_THREAD_POOL_GRAIN_SIZE, body);
+  }
+  else {
+    return body(0, number_of_local_data_points_);
+  }
+
+} // end sumDataPoints
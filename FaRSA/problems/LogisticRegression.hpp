@@ -10,8 +10,12 @@
 #ifndef __LOGISTICREGRESSION_HPP__
 #define __LOGISTICREGRESSION_HPP__
 
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include "FaRSACommunicator.hpp"
+#include "FaRSAFileCache.hpp"
 #include "FaRSAMatrix.hpp"
 #include "FaRSAProblem.hpp"
 #include "FaRSAVector.hpp"
@@ -29,17 +33,41 @@ public:
   //@{
   /**
    * Constructor
+   * \param[in] features_file is name of file with feature data (coordinate list, Matrix
+   *            Market file, or binary file written by Matrix::writeToBinaryFile, which is
+   *            then processed out-of-core)
+   * \param[in] labels_file is name of file with label data
+   * \param[in] groups_file is name of file with group data
+   * \param[in] initial_point_file is name of file with initial point
+   * \param[in] feature_value_type is type in which to store feature values
+   *            (M_VALUE_FLOAT halves memory of feature data; products accumulate in double precision)
+   *            (if all feature values equal one, features are stored as pattern without values)
+   * \param[in] block_features_by_groups indicates whether to store feature columns blocked
+   *            by groups, so group-restricted products read one contiguous block per group
+   *            (requires disjoint groups)
+   * \param[in] number_of_processes is number of processes among which rows of feature data
+   *            are sharded; if greater than one, processes are spawned (by fork) that
+   *            evaluate their shards on request and results are summed over shared memory
+   *            (if a process exits, e.g., when killed, then evaluations fail)
+   * \param[in] cache_data indicates whether to cache parsed text data in binary sidecars
+   *            (file name followed by FARSA_CACHE_SUFFIX) that are memory-mapped instead
+   *            of parsing files again while they are unchanged (see FileCache; sidecars
+   *            that cannot be written, e.g., in a read-only directory, are skipped)
    */
   LogisticRegression(char* features_file,
                      char* labels_file,
                      char* groups_file,
-                     char* initial_point_file);
+                     char* initial_point_file,
+                     MatrixValueType feature_value_type = M_VALUE_DOUBLE,
+                     bool block_features_by_groups = false,
+                     int number_of_processes = 1,
+                     bool cache_data = true);
   //@}
 
   /** @name Destructor */
   //@{
   /**
-   * Destructor
+   * Destructor (terminates spawned processes)
    */
   ~LogisticRegression();
   //@}
@@ -58,6 +86,29 @@ public:
    * \return indicator of success (true) or failure (false)
    */
   bool initialPoint(double* x);
+  /**
+   * Upper bounds on curvature (Hessian is bounded by X'X/(4N) for feature data X and
+   * number of data points N; bounds use squared column norms of X computed when data is
+   * loaded, summed over groups for group bounds, which bounds squared spectral norms)
+   * \param[out] variable_bounds is, for each variable, an upper bound on the second
+   *             derivative with respect to the variable, a double array (return value)
+   * \param[out] group_bounds is, for each group, an upper bound on the Lipschitz constant
+   *             of the gradient with respect to the variables of the group, a double
+   *             array (return value)
+   * \return indicator of success (true) or failure (false)
+   */
+  bool curvatureBounds(double* variable_bounds,
+                       double* group_bounds);
+  /**
+   * Estimate of Lipschitz constant of gradient (squared spectral norm of feature data X,
+   * or of its columns of given groups, estimated by power iteration, divided by 4N)
+   * \param[in] groups is a vector of group indices; empty vector indicates all groups
+   * \param[out] lipschitz_constant is the estimate, a double (return value)
+   * \return indicator of success (true) or failure, e.g., for groups of out-of-core
+   *         data (false)
+   */
+  bool estimateLipschitzConstant(const std::vector<int>& groups,
+                                 double& lipschitz_constant);
   //@}
 
   /** @name Evaluate methods */
@@ -90,6 +141,48 @@ public:
                                     const std::vector<int> groups,
                                     const double* v,
                                     double* Hv);
+  /**
+   * Evaluates Hessian diagonal
+   * \param[in] x is a given point/iterate, a constant double array
+   * \param[in] groups is a vector of group indices
+   * \param[out] d is the Hessian diagonal at "x", a double array (return value)
+   * \return indicator of success (true) or failure (false)
+   */
+  bool evaluateHessianDiagonal(const double* x,
+                               const std::vector<int> groups,
+                               double* d);
+  //@}
+
+  /** @name Working set methods */
+  //@{
+  /**
+   * Sets working groups; evaluations then only use the feature columns of these groups
+   * \param[in] groups is a vector of group indices; empty vector indicates all groups
+   * \return indicator of success (true) or failure (false)
+   */
+  bool setWorkingGroups(const std::vector<int>& groups);
+  //@}
+
+  /** @name Thread pool methods */
+  //@{
+  /**
+   * Sets thread pool; loops over data points of this process run on this pool, and
+   * other processes of data-parallel evaluation run theirs on unpinned pools of the
+   * same number of threads
+   * \param[in] thread_pool is pointer to ThreadPool owned by the solver
+   * \return indicator of success (true) or failure (false)
+   */
+  bool setThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+  //@}
+
+  /** @name Placement methods */
+  //@{
+  /**
+   * Places feature, label, inner product, and weight data of this process for parallel kernels
+   * \param[in] placement is reference to Placement object
+   * \return indicator of success (true) or failure (false)
+   */
+  bool setPlacement(Placement& placement);
   //@}
 
   /** @name Finalize methods */
@@ -123,15 +216,68 @@ private:
 
   /** @name Private members */
   //@{
-  int number_of_data_points_; /**< Number of data points */
-  Vector initial_point_;      /**< Initial point         */
-  Matrix features_;           /**< Feature data          */
-  Vector labels_;             /**< Label data            */
+  int number_of_data_points_;        /**< Number of data points                   */
+  int number_of_local_data_points_;  /**< Number of data points in shard          */
+  Vector initial_point_;             /**< Initial point                           */
+  Matrix features_;                  /**< Feature data                            */
+  Vector labels_;                    /**< Label data                              */
+  Vector inner_products_;            /**< Feature-point inner products            */
+  Vector gradient_weights_;          /**< Data point weights of gradient          */
+  Vector gradient_full_;             /**< Gradient over all columns (buffer)      */
+  Vector weights_;                   /**< Data point weights of curvature         */
+  Vector weights_point_;             /**< Point at which weights were computed    */
+  bool weights_computed_;            /**< Indicator of computed weights           */
+  bool working_set_restricted_;      /**< Indicator of restriction to working set */
+  std::vector<int> working_columns_; /**< Feature columns of working groups       */
+  std::vector<int> working_groups_;  /**< Working groups                          */
+  std::vector<double> variable_curvature_bounds_; /**< Curvature bounds of variables  */
+  std::vector<double> group_curvature_bounds_;    /**< Curvature bounds of groups     */
+  std::shared_ptr<SharedMemoryCommunicator> communicator_; /**< Communicator (data-parallel evaluation) */
+  std::shared_ptr<ThreadPool> thread_pool_;                /**< Thread pool (loops over data points) */
   //@}
 
-  /** @name Private members */
+  /** @name Private methods */
+  //@{
+  void computeCurvatureBounds();
+  void computeCurvatureWeights(const double* x);
+  void computeInnerProducts(const double* x);
+  bool exchangeRequest(int& request,
+                       std::vector<int>& groups,
+                       std::vector<double>& x,
+                       std::vector<double>& v);
+  void forDataPoints(const std::function<void(long long, long long)>& body) const;
+  void readData(char* features_file,
+                char* labels_file,
+                char* groups_file,
+                char* initial_point_file,
+                MatrixValueType feature_value_type,
+                bool block_features_by_groups,
+                bool cache_data);
+  bool sendRequest(int request,
+                   const std::vector<int>& groups,
+                   const double* x,
+                   const double* v,
+                   int v_length);
+  void serveRequests();
+  bool setGroupsFromCache(const FileCache& cache);
+  void setGroupsFromFile(char* groups_file,
+                         bool use_cache);
+  double sumDataPoints(const std::function<double(long long, long long)>& body) const;
+  //@}
+
+  /** @name Requests (data-parallel evaluation) */
   //@{
-  void setGroupsFromFile(char* groups_file);
+  enum Request
+  {
+    REQUEST_OBJECTIVE = 0,
+    REQUEST_GRADIENT,
+    REQUEST_HESSIAN_VECTOR_PRODUCT,
+    REQUEST_HESSIAN_DIAGONAL,
+    REQUEST_WORKING_GROUPS,
+    REQUEST_LIPSCHITZ_ESTIMATE,
+    REQUEST_THREAD_POOL,
+    REQUEST_TERMINATE
+  };
   //@}
 
 }; // end LogisticRegression
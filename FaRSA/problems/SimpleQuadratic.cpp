@@ -17,7 +17,7 @@ SimpleQuadratic::SimpleQuadratic(int n)
 
   // Set groups
   for (int i = 0; i < number_of_variables_; i++) {
-    groups_[i].push_back(i);
+    groups_.push_back(std::vector<int>(1, i));
   }
 
 } // end constructor
@@ -77,16 +77,40 @@ bool SimpleQuadratic::evaluateHessianVectorProduct(const double* x,
                                                    double* Hv)
 {
 
-  // Evaluate product
-  for (int i = 0; i < number_of_variables_; i++) {
-    Hv[i] = (double)(i+1) * 2.0;
-  }
+  // Evaluate product (Hessian is diagonal)
+  int k = 0;
+  for (int i = 0; i < (int)groups.size(); i++) {
+    for (int j = 0; j < (int)groups_[groups[i]].size(); j++) {
+      Hv[k] = (double)(groups_[groups[i]][j]+1) * 2.0 * v[k];
+      k++;
+    }
+  } // end for
 
   // Return
   return true;
 
 } // end evaluateHessianVectorProduct
 
+// Hessian diagonal
+bool SimpleQuadratic::evaluateHessianDiagonal(const double* x,
+                                              const std::vector<int> groups,
+                                              double* d)
+{
+
+  // Evaluate diagonal
+  int k = 0;
+  for (int i = 0; i < (int)groups.size(); i++) {
+    for (int j = 0; j < (int)groups_[groups[i]].size(); j++) {
+      d[k] = (double)(groups_[groups[i]][j]+1) * 2.0;
+      k++;
+    }
+  } // end for
+
+  // Return
+  return true;
+
+} // end evaluateHessianDiagonal
+
 // Finalize solution
 bool SimpleQuadratic::finalizeSolution(const double* x,
                                        double f,
@@ -82,6 +82,16 @@ public:
                                     const std::vector<int> groups,
                                     const double* v,
                                     double* Hv);
+  /**
+   * Evaluates Hessian diagonal
+   * \param[in] x is a given point/iterate, a constant double array
+   * \param[in] groups is a vector of group indices
+   * \param[out] d is the Hessian diagonal at "x", a double array (return value)
+   * \return indicator of success (true) or failure (false)
+   */
+  bool evaluateHessianDiagonal(const double* x,
+                               const std::vector<int> groups,
+                               double* d);
   //@}
 
   /** @name Finalize methods */
@@ -11,8 +11,11 @@ extern "C"
 {
 
   // Subroutines
+  void daxpy_(int* n, double* a, double* x, int* incx, double* y, int* incy);
+  void dscal_(int* n, double* a, double* x, int* incx);
 
   // Scalar functions
+  double ddot_(int* n, double* x, int* incx, double* y, int* incy);
 
 } // end extern "C"
 
@@ -0,0 +1,144 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSABINARYIO_HPP__
+#define __FARSABINARYIO_HPP__
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "FaRSADefinitions.hpp"
+
+namespace FaRSA
+{
+
+/** @name Binary input/output methods (used for checkpoint files) */
+//@{
+/**
+ * Write value to binary file
+ * \param[in] file is pointer to open file
+ * \param[in] value is value to write
+ * \return indicator of success (true) or failure (false)
+ */
+template <typename T>
+inline bool writeBinary(FILE* file,
+                        const T& value)
+{
+  return (fwrite(&value, sizeof(T), 1, file) == 1);
+}
+/**
+ * Read value from binary file
+ * \param[in] file is pointer to open file
+ * \param[out] value is value read
+ * \return indicator of success (true) or failure (false)
+ */
+template <typename T>
+inline bool readBinary(FILE* file,
+                       T& value)
+{
+  return (fread(&value, sizeof(T), 1, file) == 1);
+}
+/**
+ * Write vector (length followed by elements) to binary file
+ * \param[in] file is pointer to open file
+ * \param[in] values is vector to write
+ * \return indicator of success (true) or failure (false)
+ */
+template <typename T>
+inline bool writeBinary(FILE* file,
+                        const std::vector<T>& values)
+{
+  long long length = (long long)values.size();
+  return (writeBinary(file, length) &&
+          (length == 0 || fwrite(values.data(), sizeof(T), (size_t)length, file) == (size_t)length));
+}
+/**
+ * Get number of bytes remaining in binary file
+ * \param[in] file is pointer to open file
+ * \return number of bytes from current position to end of file, or -1 if file is not
+ *         seekable
+ */
+inline long long bytesRemaining(FILE* file)
+{
+  long position = ftell(file);
+  if (position < 0 || fseek(file, 0, SEEK_END) != 0) {
+    return -1;
+  }
+  long end = ftell(file);
+  if (fseek(file, position, SEEK_SET) != 0 || end < position) {
+    return -1;
+  }
+  return (long long)(end - position);
+}
+/**
+ * Read vector (length followed by elements) from binary file
+ * (length is checked against bytes remaining before allocation, so a corrupt length
+ *  fails the read; if file is not seekable, elements are read in bounded chunks)
+ * \param[in] file is pointer to open file
+ * \param[out] values is vector read
+ * \return indicator of success (true) or failure (false)
+ */
+template <typename T>
+inline bool readBinary(FILE* file,
+                       std::vector<T>& values)
+{
+  long long length;
+  if (!readBinary(file, length) || length < 0) {
+    return false;
+  }
+  long long remaining = bytesRemaining(file);
+  if (remaining >= 0) {
+    if (length > remaining / (long long)sizeof(T)) {
+      return false;
+    }
+    values.resize((size_t)length);
+    return (length == 0 || fread(values.data(), sizeof(T), (size_t)length, file) == (size_t)length);
+  }
+  values.clear();
+  while ((long long)values.size() < length) {
+    size_t offset = values.size();
+    size_t chunk = (size_t)std::min(length - (long long)offset, (long long)FARSA_BINARY_READ_CHUNK_LENGTH);
+    values.resize(offset + chunk);
+    if (fread(values.data() + offset, sizeof(T), chunk, file) != chunk) {
+      return false;
+    }
+  } // end while
+  return true;
+}
+/**
+ * Write string (length followed by characters) to binary file
+ * \param[in] file is pointer to open file
+ * \param[in] value is string to write
+ * \return indicator of success (true) or failure (false)
+ */
+inline bool writeBinary(FILE* file,
+                        const std::string& value)
+{
+  return writeBinary(file, std::vector<char>(value.begin(), value.end()));
+}
+/**
+ * Read string (length followed by characters) from binary file
+ * \param[in] file is pointer to open file
+ * \param[out] value is string read
+ * \return indicator of success (true) or failure (false)
+ */
+inline bool readBinary(FILE* file,
+                       std::string& value)
+{
+  std::vector<char> characters;
+  if (!readBinary(file, characters)) {
+    return false;
+  }
+  value.assign(characters.begin(), characters.end());
+  return true;
+}
+//@}
+
+} // namespace FaRSA
+
+#endif /* __FARSABINARYIO_HPP__ */
@@ -0,0 +1,271 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FaRSACommunicator.hpp"
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+
+namespace FaRSA
+{
+
+// Synchronization state in shared memory
+struct SharedMemoryState
+{
+  pthread_mutex_t mutex;      /**< Robust process-shared mutex */
+  pthread_cond_t condition;   /**< Process-shared condition variable (monotonic clock) */
+  int count;                  /**< Number of processes waiting at barrier */
+  int generation;             /**< Number of completed barriers */
+  int failed;                 /**< Indicator of a process having exited */
+};
+
+// Lock state (marks failure if owner of mutex exited while holding it)
+static bool lockState(SharedMemoryState* state)
+{
+  int error = pthread_mutex_lock(&state->mutex);
+  if (error == EOWNERDEAD) {
+    state->failed = 1;
+    pthread_mutex_consistent(&state->mutex);
+    return true;
+  }
+  return (error == 0);
+}
+
+// Constructor
+SharedMemoryCommunicator::SharedMemoryCommunicator(int number_of_processes,
+                                                   int buffer_length)
+  : rank_(0),
+    size_(std::max(number_of_processes, 1)),
+    buffer_length_(std::max(buffer_length, 1)),
+    shared_memory_(nullptr),
+    shared_memory_length_(0),
+    buffers_(nullptr),
+    parent_id_(getpid())
+{
+
+  // Set length of shared memory (state padded to keep buffers aligned)
+  size_t state_length = (sizeof(SharedMemoryState) + 63) / 64 * 64;
+  shared_memory_length_ = state_length + (size_t)size_ * (size_t)buffer_length_ * sizeof(double);
+
+  // Map shared memory (inherited by spawned processes)
+  shared_memory_ = mmap(nullptr, shared_memory_length_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared_memory_ == MAP_FAILED) {
+    shared_memory_ = nullptr;
+    THROW_EXCEPTION(FARSA_COMMUNICATOR_EXCEPTION, "Failed to map shared memory.");
+  }
+  buffers_ = (double*)((char*)shared_memory_ + state_length);
+
+  // Initialize robust process-shared mutex and condition variable (mapping is zero, so
+  // counters start at zero)
+  SharedMemoryState* state = (SharedMemoryState*)shared_memory_;
+  pthread_mutexattr_t mutex_attributes;
+  pthread_mutexattr_init(&mutex_attributes);
+  pthread_mutexattr_setpshared(&mutex_attributes, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&mutex_attributes, PTHREAD_MUTEX_ROBUST);
+  int error = pthread_mutex_init(&state->mutex, &mutex_attributes);
+  pthread_mutexattr_destroy(&mutex_attributes);
+  pthread_condattr_t condition_attributes;
+  pthread_condattr_init(&condition_attributes);
+  pthread_condattr_setpshared(&condition_attributes, PTHREAD_PROCESS_SHARED);
+  pthread_condattr_setclock(&condition_attributes, CLOCK_MONOTONIC);
+  error = (error != 0) ? error : pthread_cond_init(&state->condition, &condition_attributes);
+  pthread_condattr_destroy(&condition_attributes);
+  if (error != 0) {
+    munmap(shared_memory_, shared_memory_length_);
+    shared_memory_ = nullptr;
+    THROW_EXCEPTION(FARSA_COMMUNICATOR_EXCEPTION, "Failed to initialize shared synchronization.");
+  }
+
+} // end constructor
+
+// Destructor
+SharedMemoryCommunicator::~SharedMemoryCommunicator()
+{
+
+  // Wait for spawned processes (those that exited early were waited for already)
+  for (int i = 0; i < (int)process_ids_.size(); i++) {
+    waitpid(process_ids_[i], nullptr, 0);
+  }
+
+  // Unmap shared memory
+  if (shared_memory_ != nullptr) {
+    // Destroy synchronization state (not after a failure, since destroying a condition
+    // variable waits for waiters, and a process that exited while waiting never leaves)
+    SharedMemoryState* state = (SharedMemoryState*)shared_memory_;
+    if (rank_ == 0 && !state->failed) {
+      pthread_cond_destroy(&state->condition);
+      pthread_mutex_destroy(&state->mutex);
+    }
+    munmap(shared_memory_, shared_memory_length_);
+    shared_memory_ = nullptr;
+  } // end if
+
+} // end destructor
+
+// Spawn processes
+bool SharedMemoryCommunicator::spawnProcesses()
+{
+
+  // Spawn processes for ranks 1,...,size-1
+  for (int rank = 1; rank < size_; rank++) {
+    pid_t process_id = fork();
+    if (process_id < 0) {
+      return false;
+    }
+    if (process_id == 0) {
+      rank_ = rank;
+      process_ids_.clear();
+      return true;
+    }
+    process_ids_.push_back(process_id);
+  } // end for
+
+  // Return
+  return true;
+
+} // end spawnProcesses
+
+// Broadcast
+bool SharedMemoryCommunicator::broadcast(double* values,
+                                         int length)
+{
+
+  // Exchange in steps of buffer length (rank 0 writes its buffer, others read it)
+  for (int start = 0; start < length; start += buffer_length_) {
+    int count = std::min(buffer_length_, length - start);
+    if (rank_ == 0) {
+      memcpy(buffers_, values + start, count * sizeof(double));
+    }
+    if (!barrier()) {
+      return false;
+    }
+    if (rank_ != 0) {
+      memcpy(values + start, buffers_, count * sizeof(double));
+    }
+    if (!barrier()) {
+      return false;
+    }
+  } // end for
+
+  // Return
+  return true;
+
+} // end broadcast
+
+// Sum over all processes
+bool SharedMemoryCommunicator::allReduceSum(double* values,
+                                            int length)
+{
+
+  // Exchange in steps of buffer length (each rank writes its buffer, all sum in rank order)
+  for (int start = 0; start < length; start += buffer_length_) {
+    int count = std::min(buffer_length_, length - start);
+    memcpy(buffers_ + (size_t)rank_ * buffer_length_, values + start, count * sizeof(double));
+    if (!barrier()) {
+      return false;
+    }
+    for (int i = 0; i < count; i++) {
+      double sum = 0.0;
+      for (int rank = 0; rank < size_; rank++) {
+        sum += buffers_[(size_t)rank * buffer_length_ + i];
+      }
+      values[start + i] = sum;
+    } // end for
+    if (!barrier()) {
+      return false;
+    }
+  } // end for
+
+  // Return
+  return true;
+
+} // end allReduceSum
+
+// Barrier
+bool SharedMemoryCommunicator::barrier()
+{
+
+  // Lock state
+  SharedMemoryState* state = (SharedMemoryState*)shared_memory_;
+  if (!lockState(state)) {
+    return false;
+  }
+
+  // Arrive at barrier (last process to arrive completes it)
+  bool success = false;
+  if (!state->failed) {
+    int generation = state->generation;
+    state->count++;
+    if (state->count == size_) {
+      state->count = 0;
+      state->generation++;
+      pthread_cond_broadcast(&state->condition);
+    }
+
+    // Wait for completion, checking other processes after each wait time
+    while (state->generation == generation && !state->failed) {
+      struct timespec deadline;
+      clock_gettime(CLOCK_MONOTONIC, &deadline);
+      deadline.tv_nsec += (long)FARSA_COMMUNICATOR_WAIT_MILLISECONDS * 1000000L;
+      deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+      deadline.tv_nsec %= 1000000000L;
+      int error = pthread_cond_timedwait(&state->condition, &state->mutex, &deadline);
+      if (error == EOWNERDEAD) {
+        state->failed = 1;
+        pthread_mutex_consistent(&state->mutex);
+      }
+      else if (error == ETIMEDOUT && !processesAlive()) {
+        state->failed = 1;
+      }
+    } // end while
+
+    // Wake other waiting processes on failure
+    if (state->failed) {
+      pthread_cond_broadcast(&state->condition);
+    }
+    success = (state->generation != generation);
+
+  } // end if
+
+  // Unlock state
+  pthread_mutex_unlock(&state->mutex);
+
+  // Return
+  return success;
+
+} // end barrier
+
+// Check whether other processes are alive
+bool SharedMemoryCommunicator::processesAlive()
+{
+
+  // Check rank 0 process (a process whose parent exits is reparented)
+  if (rank_ != 0) {
+    return (getppid() == parent_id_);
+  }
+
+  // Check spawned processes (exited processes are waited for)
+  bool alive = true;
+  for (int i = 0; i < (int)process_ids_.size(); i++) {
+    if (waitpid(process_ids_[i], nullptr, WNOHANG) != 0) {
+      alive = false;
+    }
+  } // end for
+
+  // Return
+  return alive;
+
+} // end processesAlive
+
+} // namespace FaRSA
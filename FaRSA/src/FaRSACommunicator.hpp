@@ -0,0 +1,198 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSACOMMUNICATOR_HPP__
+#define __FARSACOMMUNICATOR_HPP__
+
+#include <cstddef>
+#include <sys/types.h>
+#include <vector>
+
+namespace FaRSA
+{
+
+/**
+ * Forward declarations
+ */
+class SharedMemoryCommunicator;
+
+/**
+  * Communicator class
+  * (collective operations among processes; every process must call each
+  *  collective operation in the same order)
+  */
+class Communicator
+{
+
+public:
+  /** @name Destructor */
+  //@{
+  /**
+    * Destructor
+    */
+  virtual ~Communicator(){};
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+    * Get rank of this process
+    * \return rank in {0,...,size-1}; rank 0 is the process that runs the solver
+    */
+  virtual int rank() const = 0;
+  /**
+    * Get number of processes
+    * \return number of processes
+    */
+  virtual int size() const = 0;
+  //@}
+
+  /** @name Collective methods */
+  //@{
+  /**
+    * Broadcast values from rank 0 to all processes
+    * \param[in,out] values is array of values (input on rank 0, output on other ranks)
+    * \param[in] length is length of array
+    * \return indicator of success (true) or failure (false)
+    */
+  virtual bool broadcast(double* values,
+                         int length) = 0;
+  /**
+    * Sum values over all processes; every process receives the same sum
+    * (summed in order of rank, so results do not depend on timing)
+    * \param[in,out] values is array of values (input is contribution, output is sum)
+    * \param[in] length is length of array
+    * \return indicator of success (true) or failure (false)
+    */
+  virtual bool allReduceSum(double* values,
+                            int length) = 0;
+  //@}
+
+}; // end Communicator
+
+/**
+  * SharedMemoryCommunicator class
+  * (local processes created by fork, communicating through an anonymous shared
+  *  memory mapping synchronized by a robust process-shared mutex and condition
+  *  variable; waiting processes check every FARSA_COMMUNICATOR_WAIT_MILLISECONDS
+  *  that the other processes are alive, so if one exits, e.g., when killed, then
+  *  this and all later collective operations fail instead of blocking)
+  */
+class SharedMemoryCommunicator : public Communicator
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Constructor (allocates shared memory; processes are created by spawnProcesses)
+    * \param[in] number_of_processes is number of processes, including this one
+    * \param[in] buffer_length is number of doubles per process exchanged in one step
+    *            (longer arrays are exchanged in several steps)
+    */
+  SharedMemoryCommunicator(int number_of_processes,
+                           int buffer_length = 65536);
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Destructor (on rank 0, waits for other processes to exit)
+    */
+  ~SharedMemoryCommunicator();
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+    * Get rank of this process
+    * \return rank in {0,...,size-1}
+    */
+  inline int rank() const { return rank_; };
+  /**
+    * Get number of processes
+    * \return number of processes
+    */
+  inline int size() const { return size_; };
+  //@}
+
+  /** @name Process methods */
+  //@{
+  /**
+    * Spawn processes; returns in every process, with rank set accordingly
+    * (should be called before any threads are started)
+    * \return indicator of success (true) or failure (false)
+    */
+  bool spawnProcesses();
+  //@}
+
+  /** @name Collective methods */
+  //@{
+  /**
+    * Broadcast values from rank 0 to all processes
+    * \param[in,out] values is array of values (input on rank 0, output on other ranks)
+    * \param[in] length is length of array
+    * \return indicator of success (true) or failure (false)
+    */
+  bool broadcast(double* values,
+                 int length);
+  /**
+    * Sum values over all processes; every process receives the same sum
+    * \param[in,out] values is array of values (input is contribution, output is sum)
+    * \param[in] length is length of array
+    * \return indicator of success (true) or failure (false)
+    */
+  bool allReduceSum(double* values,
+                    int length);
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Copy constructor
+    */
+  SharedMemoryCommunicator(const SharedMemoryCommunicator&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const SharedMemoryCommunicator&);
+  //@}
+
+  /** @name Private members */
+  //@{
+  int rank_;                           /**< Rank of this process */
+  int size_;                           /**< Number of processes */
+  int buffer_length_;                  /**< Number of doubles per process in shared buffer */
+  void* shared_memory_;                /**< Shared memory mapping (synchronization state, then buffers) */
+  size_t shared_memory_length_;        /**< Length of shared memory mapping */
+  double* buffers_;                    /**< Buffers, one per process, in shared memory */
+  std::vector<pid_t> process_ids_;     /**< Identifiers of spawned processes (rank 0 only) */
+  pid_t parent_id_;                    /**< Identifier of rank 0 process */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+    * Wait until all processes reach the barrier
+    * \return indicator of success (true) or failure, e.g., if a process exited (false)
+    */
+  bool barrier();
+  /**
+    * Check whether other processes are alive (on rank 0, spawned processes that have
+    *  not exited; on other ranks, rank 0 process)
+    * \return indicator of other processes alive (true) or not (false)
+    */
+  bool processesAlive();
+  //@}
+
+}; // end SharedMemoryCommunicator
+
+} // namespace FaRSA
+
+#endif /* __FARSACOMMUNICATOR_HPP__ */
@@ -11,5 +11,42 @@
 
 #define FARSA_DOUBLE_INFINITY 1e+50
 #define FARSA_INT_INFINITY std::numeric_limits<int>::max()
+#define FARSA_CHECKPOINT_IDENTIFIER "FaRSA checkpoint"
+#define FARSA_CHECKPOINT_VERSION 1
+#define FARSA_BINARY_READ_CHUNK_LENGTH 1048576
+#define FARSA_MATRIX_IDENTIFIER "FaRSA matrix"
+#define FARSA_MATRIX_VERSION 1
+#define FARSA_MATRIX_HEADER_SIZE 64
+#define FARSA_MATRIX_STREAM_BLOCK_SIZE 67108864
+#define FARSA_VECTOR_IDENTIFIER "FaRSA vector"
+#define FARSA_VECTOR_VERSION 1
+#define FARSA_VECTOR_HEADER_SIZE 64
+#define FARSA_TEXT_PARSER_CHUNK_SIZE 4194304
+#define FARSA_CACHE_IDENTIFIER "FaRSA cache"
+#define FARSA_CACHE_VERSION 2
+#define FARSA_CACHE_HEADER_SIZE 64
+#define FARSA_CACHE_SUFFIX ".farsa-cache"
+#define FARSA_CACHE_HASH_SAMPLES 64
+#define FARSA_CACHE_HASH_SAMPLE_SIZE 4096
+#define FARSA_THREAD_POOL_GRAIN_SIZE 32768
+#define FARSA_POWER_ITERATION_LIMIT 50
+#define FARSA_POWER_ITERATION_TOLERANCE 1e-03
+#define FARSA_POWER_ITERATION_SEED 1
+#define FARSA_DETERMINISTIC_SCATTER_PARTS 8
+#define FARSA_ASYNC_REPORT_SLOT_SIZE 256
+#define FARSA_ASYNC_REPORT_WAIT_MILLISECONDS 10
+#define FARSA_COMMUNICATOR_WAIT_MILLISECONDS 100
+#define FARSA_EVENT_LOG_IDENTIFIER "FaRSA event log"
+#define FARSA_EVENT_LOG_VERSION 1
+#define FARSA_EVENT_LOG_BUFFER_SIZE 65536
+
+// Compile-time limits of output (e.g., -DFARSA_REPORT_LEVEL_LIMIT=0 removes per-iteration
+// output of FARSA_PRINTF; -DFARSA_EVENT_LOG_ENABLED=0 removes FARSA_EVENT records)
+#ifndef FARSA_REPORT_LEVEL_LIMIT
+#define FARSA_REPORT_LEVEL_LIMIT 2
+#endif
+#ifndef FARSA_EVENT_LOG_ENABLED
+#define FARSA_EVENT_LOG_ENABLED 1
+#endif
 
 #endif /* __FARSADEFINITIONS_HPP__ */
@@ -104,6 +104,13 @@ public:
    * \return current status of direction computation
    */
   inline DC_Status status() { return status_; };
+  /**
+   * Get indicator of unit stepsize (if true, line searches try a unit stepsize first,
+   * regardless of their stepsize initialization, e.g., for a direction toward a point
+   * that the direction computation has accepted)
+   * \return true if direction is intended for a unit stepsize, false otherwise
+   */
+  virtual bool unitStepsize() { return false; };
   //@}
 
   /** @name Set method */
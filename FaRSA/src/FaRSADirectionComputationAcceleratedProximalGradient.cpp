@@ -0,0 +1,319 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cmath>
+
+#include "FaRSABinaryIO.hpp"
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSADirectionComputationAcceleratedProximalGradient.hpp"
+
+namespace FaRSA
+{
+
+// Add options
+void DirectionComputationAcceleratedProximalGradient::addOptions(Options* options,
+                                                                 const Reporter* reporter)
+{
+
+  // Add bool options
+  options->addBoolOption(reporter,
+                         "APG_use_lipschitz_estimate",
+                         false,
+                         "Indicator for whether to replace APG_lipschitz_estimate_initial by\n"
+                         "              an estimate of the Lipschitz constant of the gradient, computed\n"
+                         "              by the problem during initialization (e.g., by power iteration\n"
+                         "              over its data), if available.\n"
+                         "Default     : false.");
+
+  // Add double options
+  options->addDoubleOption(reporter,
+                           "APG_lipschitz_estimate_initial",
+                           1.0,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Initial estimate of the Lipschitz constant of the gradient.  The\n"
+                           "              first proximal gradient step uses the reciprocal of this value\n"
+                           "              as its stepsize (before backtracking).\n"
+                           "Default     : 1.0.");
+  options->addDoubleOption(reporter,
+                           "APG_lipschitz_estimate_maximum",
+                           1e+20,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Maximum estimate of the Lipschitz constant of the gradient.  If\n"
+                           "              backtracking would increase the estimate beyond this value,\n"
+                           "              then the step is taken with this value.\n"
+                           "Default     : 1e+20.");
+  options->addDoubleOption(reporter,
+                           "APG_lipschitz_estimate_increase_factor",
+                           2.0,
+                           1.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Factor by which the Lipschitz constant estimate is increased when\n"
+                           "              the quadratic upper bound fails to hold at the trial point.\n"
+                           "Default     : 2.0.");
+  options->addDoubleOption(reporter,
+                           "APG_lipschitz_estimate_decrease_factor",
+                           9e-01,
+                           0.0,
+                           1.0,
+                           "Factor by which the Lipschitz constant estimate is decreased at\n"
+                           "              the start of each iteration, allowing the estimate to adapt to\n"
+                           "              local curvature.  A value of 1 yields a nondecreasing estimate.\n"
+                           "Default     : 9e-01.");
+
+  // Add string options
+  options->addStringOption(reporter,
+                           "APG_restart",
+                           "gradient",
+                           "Adaptive restart strategy for the momentum.\n"
+                           "              'none' never restarts.\n"
+                           "              'gradient' restarts if the gradient at the extrapolated point\n"
+                           "                makes a positive inner product with the step.\n"
+                           "              'function' restarts if the objective at the new point is\n"
+                           "                greater than at the current iterate.\n"
+                           "              In all cases, the momentum is restarted if the resulting\n"
+                           "                direction is not a descent direction at the current iterate.\n"
+                           "Default     : gradient.");
+
+} // end addOptions
+
+// Set options
+void DirectionComputationAcceleratedProximalGradient::getOptions(const Options* options,
+                                                                 const Reporter* reporter)
+{
+
+  // Read bool options
+  options->valueAsBool(reporter, "APG_use_lipschitz_estimate", use_lipschitz_estimate_);
+
+  // Read double options
+  options->valueAsDouble(reporter, "APG_lipschitz_estimate_initial", lipschitz_estimate_initial_);
+  options->valueAsDouble(reporter, "APG_lipschitz_estimate_maximum", lipschitz_estimate_maximum_);
+  options->valueAsDouble(reporter, "APG_lipschitz_estimate_increase_factor", lipschitz_estimate_increase_factor_);
+  options->valueAsDouble(reporter, "APG_lipschitz_estimate_decrease_factor", lipschitz_estimate_decrease_factor_);
+
+  // Read string options
+  options->valueAsString(reporter, "APG_restart", restart_);
+
+} // end getOptions
+
+// Initialize
+void DirectionComputationAcceleratedProximalGradient::initialize(const Options* options,
+                                                                 Quantities* quantities,
+                                                                 const Reporter* reporter)
+{
+
+  // Initialize Lipschitz constant estimate (from problem, if requested and available)
+  lipschitz_estimate_ = fmin(lipschitz_estimate_maximum_, lipschitz_estimate_initial_);
+  if (use_lipschitz_estimate_ && quantities->lipschitzEstimate() > 0.0) {
+    lipschitz_estimate_ = fmin(lipschitz_estimate_maximum_, quantities->lipschitzEstimate());
+  }
+
+  // Initialize momentum
+  momentum_ = 1.0;
+  number_of_restarts_ = 0;
+
+} // end initialize
+
+// Iteration header
+std::string DirectionComputationAcceleratedProximalGradient::iterationHeader()
+{
+  return "  |Step|  Lipschitz R";
+}
+
+// Iteration null values string
+std::string DirectionComputationAcceleratedProximalGradient::iterationNullValues()
+{
+  return "--------- --------- -";
+}
+
+// Compute direction
+void DirectionComputationAcceleratedProximalGradient::computeDirection(const Options* options,
+                                                                       Quantities* quantities,
+                                                                       const Reporter* reporter,
+                                                                       Strategies* strategies)
+{
+
+  // Initialize values
+  setStatus(DC_UNSET);
+  quantities->setTrialIterateToCurrentIterate();
+  quantities->setDirectionPoint(nullptr);
+  bool restarted = false;
+
+  // Evaluate current objective and gradient
+  bool evaluation_success = (quantities->currentIterate()->evaluateObjective(*quantities) &&
+                             quantities->currentIterate()->evaluateGradient(*quantities));
+
+  // Check for successful evaluation
+  if (!evaluation_success) {
+    setStatus(DC_EVALUATION_FAILURE);
+  }
+  else {
+
+    // Reset momentum in first iteration
+    if (quantities->previousIterate() == nullptr) {
+      momentum_ = 1.0;
+    }
+
+    // Compute next momentum and extrapolation parameter
+    double momentum_next = 0.5 * (1.0 + sqrt(1.0 + 4.0 * momentum_ * momentum_));
+    double extrapolation = (momentum_ - 1.0) / momentum_next;
+
+    // Set extrapolated point (current iterate if no extrapolation, so its evaluated
+    // objective and gradient are reused)
+    std::shared_ptr<Point> extrapolated_point = quantities->currentIterate();
+    if (extrapolation > 0.0) {
+      std::shared_ptr<Vector> step = quantities->currentIterate()->vector()->makeNewLinearCombination(1.0, -1.0, *quantities->previousIterate()->vector());
+      extrapolated_point = quantities->currentIterate()->makeNewLinearCombination(1.0, extrapolation, *step);
+    }
+
+    // Decrease Lipschitz constant estimate
+    lipschitz_estimate_ = lipschitz_estimate_decrease_factor_ * lipschitz_estimate_;
+
+    // Compute proximal gradient point from extrapolated point
+    std::shared_ptr<Point> proximal_point;
+    bool bound_satisfied = false;
+    evaluation_success = computeProximalGradientPoint(quantities, extrapolated_point, proximal_point, bound_satisfied);
+
+    // Check for successful evaluation
+    if (evaluation_success) {
+
+      // Set direction
+      quantities->direction()->copy(*proximal_point->vector());
+      quantities->direction()->addScaledVector(-1.0, *quantities->currentIterate()->vector());
+
+      // Check restart conditions
+      if (extrapolation > 0.0) {
+        if (restart_.compare("gradient") == 0) {
+          restarted = (extrapolated_point->gradient()->innerProduct(*quantities->direction()) > 0.0);
+        }
+        else if (restart_.compare("function") == 0) {
+          restarted = (proximal_point->objective() > quantities->currentIterate()->objective());
+        }
+        restarted = restarted || (quantities->currentIterate()->gradient()->innerProduct(*quantities->direction()) >= 0.0);
+        restarted = restarted || !bound_satisfied;
+      } // end if
+
+    } // end if
+
+    // Restart from current iterate
+    if (evaluation_success && restarted) {
+
+      // Reset momentum
+      momentum_ = 1.0;
+      momentum_next = 0.5 * (1.0 + sqrt(5.0));
+      number_of_restarts_++;
+
+      // Compute proximal gradient point from current iterate
+      evaluation_success = computeProximalGradientPoint(quantities, quantities->currentIterate(), proximal_point, bound_satisfied);
+
+      // Set direction
+      if (evaluation_success) {
+        quantities->direction()->copy(*proximal_point->vector());
+        quantities->direction()->addScaledVector(-1.0, *quantities->currentIterate()->vector());
+      }
+
+    } // end if
+
+    // Set direction point (proximal gradient point, with evaluated objective, so line
+    // search accepts a unit step without evaluating objective again), unless quadratic
+    // upper bound does not hold at maximum estimate (then line search checks decrease)
+    if (evaluation_success && bound_satisfied) {
+      quantities->setDirectionPoint(proximal_point);
+    }
+
+    // Update momentum
+    momentum_ = momentum_next;
+
+    // Set status
+    setStatus(evaluation_success ? DC_SUCCESS : DC_EVALUATION_FAILURE);
+
+  } // end else
+
+  // Print iteration information
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %+.2e %+.2e %d", quantities->direction()->normInf(), lipschitz_estimate_, (restarted ? 1 : 0));
+
+  // Record event
+  FARSA_EVENT(reporter, E_DIRECTION, quantities->direction()->normInf());
+
+} // end computeDirection
+
+// Compute proximal gradient point
+bool DirectionComputationAcceleratedProximalGradient::computeProximalGradientPoint(Quantities* quantities,
+                                                                                   const std::shared_ptr<Point> point,
+                                                                                   std::shared_ptr<Point>& proximal_point,
+                                                                                   bool& bound_satisfied)
+{
+
+  // Initialize indicator
+  bound_satisfied = false;
+
+  // Evaluate objective and gradient at given point
+  if (!point->evaluateObjective(*quantities) ||
+      !point->evaluateGradient(*quantities)) {
+    return false;
+  }
+
+  // Compute squared norm of gradient
+  double gradient_norm_squared = point->gradient()->innerProduct(*point->gradient());
+
+  // Loop until quadratic upper bound holds
+  while (true) {
+
+    // Compute proximal gradient point (gradient step, since no regularizer)
+    proximal_point = point->makeNewLinearCombination(1.0, -1.0 / lipschitz_estimate_, *point->gradient());
+
+    // Evaluate objective at proximal gradient point
+    bool evaluation_success = proximal_point->evaluateObjective(*quantities);
+
+    // Check quadratic upper bound, i.e., f(p) <= f(y) + g(y)'(p-y) + (L/2)*||p-y||^2 with p-y = -g(y)/L
+    if (evaluation_success &&
+        proximal_point->objective() <= point->objective() - 0.5 * gradient_norm_squared / lipschitz_estimate_) {
+      break;
+    }
+
+    // Check for maximum estimate (bound does not hold)
+    if (lipschitz_estimate_ >= lipschitz_estimate_maximum_) {
+      return evaluation_success;
+    }
+
+    // Increase Lipschitz constant estimate
+    lipschitz_estimate_ = fmin(lipschitz_estimate_maximum_, lipschitz_estimate_increase_factor_ * lipschitz_estimate_);
+
+  } // end while
+
+  // Set indicator
+  bound_satisfied = true;
+
+  // Return
+  return true;
+
+} // end computeProximalGradientPoint
+
+// Read state
+bool DirectionComputationAcceleratedProximalGradient::readState(FILE* file)
+{
+
+  // Read Lipschitz constant estimate and momentum
+  return (readBinary(file, lipschitz_estimate_) &&
+          readBinary(file, momentum_) &&
+          readBinary(file, number_of_restarts_));
+
+} // end readState
+
+// Write state
+bool DirectionComputationAcceleratedProximalGradient::writeState(FILE* file) const
+{
+
+  // Write Lipschitz constant estimate and momentum
+  return (writeBinary(file, lipschitz_estimate_) &&
+          writeBinary(file, momentum_) &&
+          writeBinary(file, number_of_restarts_));
+
+} // end writeState
+
+} // namespace FaRSA
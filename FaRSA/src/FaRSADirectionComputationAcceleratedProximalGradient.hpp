@@ -0,0 +1,191 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSADIRECTIONCOMPUTATIONACCELERATEDPROXIMALGRADIENT_HPP__
+#define __FARSADIRECTIONCOMPUTATIONACCELERATEDPROXIMALGRADIENT_HPP__
+
+#include <string>
+
+#include "FaRSADirectionComputation.hpp"
+
+namespace FaRSA
+{
+
+/**
+ * DirectionComputationAcceleratedProximalGradient class
+ *
+ * Direction toward the accelerated (FISTA) proximal gradient point, computed
+ * from an extrapolation of the current and previous iterates with a Lipschitz
+ * constant estimate determined by backtracking.  The momentum is reset when the
+ * gradient- or function-based restart test is triggered.  The direction is
+ * intended for a unit stepsize, which line searches try first; the proximal
+ * gradient point is set as direction point, so it is accepted without being
+ * evaluated again.
+ */
+class DirectionComputationAcceleratedProximalGradient : public DirectionComputation
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+   * Constructor
+   */
+  DirectionComputationAcceleratedProximalGradient()
+    : lipschitz_estimate_(1.0),
+      momentum_(1.0),
+      number_of_restarts_(0){};
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+   * Destructor
+   */
+  ~DirectionComputationAcceleratedProximalGradient(){};
+
+  /** @name Options handling methods */
+  //@{
+  /**
+   * Add options
+   * \param[in,out] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void addOptions(Options* options,
+                  const Reporter* reporter);
+  /**
+   * Set options
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void getOptions(const Options* options,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Initialization method */
+  //@{
+  /**
+   * Initialize strategy
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void initialize(const Options* options,
+                  Quantities* quantities,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+   * Get iteration header string
+   * \return string of header values
+   */
+  std::string iterationHeader();
+  /**
+   * Get iteration null values string
+   * \return string of null values
+   */
+  std::string iterationNullValues();
+  /**
+   * Get name of strategy
+   * \return string with name of strategy
+   */
+  std::string name() { return "Accelerated Proximal Gradient"; };
+  /**
+   * Get indicator of unit stepsize
+   * \return true, since direction is toward proximal gradient point
+   */
+  bool unitStepsize() { return true; };
+  //@}
+
+  /** @name Direction computation method */
+  //@{
+  /**
+   * Run direction computation
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   * \param[in,out] strategies is pointer to Strategies object from FaRSA
+   */
+  void computeDirection(const Options* options,
+                        Quantities* quantities,
+                        const Reporter* reporter,
+                        Strategies* strategies);
+  //@}
+
+  /** @name Checkpoint methods */
+  //@{
+  /**
+   * Read strategy state from open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool readState(FILE* file);
+  /**
+   * Write strategy state (Lipschitz constant estimate and momentum) to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeState(FILE* file) const;
+  //@}
+
+private:
+  /** @name Private members (options) */
+  //@{
+  bool use_lipschitz_estimate_;
+  double lipschitz_estimate_initial_;
+  double lipschitz_estimate_maximum_;
+  double lipschitz_estimate_increase_factor_;
+  double lipschitz_estimate_decrease_factor_;
+  std::string restart_;
+  //@}
+
+  /** @name Private members */
+  //@{
+  double lipschitz_estimate_; /**< Current estimate of Lipschitz constant of gradient */
+  double momentum_;           /**< Current momentum parameter (t_k in FISTA)          */
+  int number_of_restarts_;    /**< Number of momentum restarts                        */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Compute proximal gradient point from given point, increasing the Lipschitz
+   * constant estimate until the quadratic upper bound holds at the new point
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] point is pointer to Point at which proximal gradient step is taken
+   *             (objective and gradient are evaluated here, if needed)
+   * \param[out] proximal_point is pointer to proximal gradient Point
+   * \param[out] bound_satisfied is indicator of quadratic upper bound holding at
+   *             proximal_point (false if it does not hold at maximum estimate)
+   * \return indicator of evaluation success
+   */
+  bool computeProximalGradientPoint(Quantities* quantities,
+                                    const std::shared_ptr<Point> point,
+                                    std::shared_ptr<Point>& proximal_point,
+                                    bool& bound_satisfied);
+  //@}
+
+  /** @name Default compiler generated methods
+   * (Hidden to avoid implicit creation/calling.)
+   */
+  //@{
+  /**
+   * Copy constructor
+   */
+  DirectionComputationAcceleratedProximalGradient(const DirectionComputationAcceleratedProximalGradient&);
+  /**
+   * Overloaded equals operator
+   */
+  void operator=(const DirectionComputationAcceleratedProximalGradient&);
+  //@}
+
+}; // end DirectionComputationAcceleratedProximalGradient
+
+} // namespace FaRSA
+
+#endif /* __FARSADIRECTIONCOMPUTATIONACCELERATEDPROXIMALGRADIENT_HPP__ */
@@ -0,0 +1,361 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <algorithm>
+#include <cmath>
+
+#include "FaRSABLASLAPACK.hpp"
+#include "FaRSABinaryIO.hpp"
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSADirectionComputationLBFGS.hpp"
+
+namespace FaRSA
+{
+
+// Add options
+void DirectionComputationLBFGS::addOptions(Options* options,
+                                           const Reporter* reporter)
+{
+
+  // Add double options
+  options->addDoubleOption(reporter,
+                           "LBFGS_curvature_threshold",
+                           1e-08,
+                           0.0,
+                           1.0,
+                           "Threshold for updating the L-BFGS history.  A displacement pair\n"
+                           "              (s,y) is added to the history only if s'y is greater than this\n"
+                           "              value times ||s||_2*||y||_2.\n"
+                           "Default     : 1e-08.");
+
+  // Add integer options
+  options->addIntegerOption(reporter,
+                            "LBFGS_history_length",
+                            10,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Number of displacement pairs stored in the L-BFGS history.\n"
+                            "Default     : 10.");
+
+} // end addOptions
+
+// Set options
+void DirectionComputationLBFGS::getOptions(const Options* options,
+                                           const Reporter* reporter)
+{
+
+  // Read double options
+  options->valueAsDouble(reporter, "LBFGS_curvature_threshold", curvature_threshold_);
+
+  // Read integer options
+  options->valueAsInteger(reporter, "LBFGS_history_length", history_length_);
+
+} // end getOptions
+
+// Initialize
+void DirectionComputationLBFGS::initialize(const Options* options,
+                                           Quantities* quantities,
+                                           const Reporter* reporter)
+{
+
+  // Initialize free set and history
+  free_indices_.clear();
+  resetHistory();
+
+} // end initialize
+
+// Iteration header
+std::string DirectionComputationLBFGS::iterationHeader()
+{
+  return "  |Step|  Mem";
+}
+
+// Iteration null values string
+std::string DirectionComputationLBFGS::iterationNullValues()
+{
+  return "--------- ---";
+}
+
+// Compute direction
+void DirectionComputationLBFGS::computeDirection(const Options* options,
+                                                 Quantities* quantities,
+                                                 const Reporter* reporter,
+                                                 Strategies* strategies)
+{
+
+  // Initialize values
+  setStatus(DC_UNSET);
+  quantities->setTrialIterateToCurrentIterate();
+
+  // Evaluate current objective and gradient
+  bool evaluation_success = (quantities->currentIterate()->evaluateObjective(*quantities) &&
+                             quantities->currentIterate()->evaluateGradient(*quantities));
+
+  // Check for successful evaluation
+  if (!evaluation_success) {
+    setStatus(DC_EVALUATION_FAILURE);
+  }
+  else {
+
+    // Determine free variables
+    quantities->partitionGroups();
+    std::vector<int> free_indices;
+    for (int k = 0; k < (int)quantities->groupsFree().size(); k++) {
+      const std::vector<int>& group = quantities->groups()[quantities->groupsFree()[k]];
+      free_indices.insert(free_indices.end(), group.begin(), group.end());
+    }
+
+    // Remap history if free set has changed, then update history
+    if (free_indices != free_indices_) {
+      remapHistory(quantities->numberOfVariables(), free_indices);
+    }
+    if (quantities->previousIterate() != nullptr) {
+      updateHistory(quantities);
+    }
+
+    // Set direction as negative gradient
+    quantities->direction()->copy(*quantities->currentIterate()->gradient());
+    quantities->direction()->scale(-1.0);
+
+    // Apply inverse Hessian approximation in free subspace
+    if (history_count_ > 0) {
+
+      // Gather free elements of direction
+      double* d = quantities->direction()->valuesModifiable();
+      std::vector<double> d_free(free_indices_.size());
+      for (int i = 0; i < (int)free_indices_.size(); i++) {
+        d_free[i] = d[free_indices_[i]];
+      }
+
+      // Apply two-loop recursion
+      applyInverseHessianApproximation(d_free.data());
+
+      // Scatter free elements of direction
+      for (int i = 0; i < (int)free_indices_.size(); i++) {
+        d[free_indices_[i]] = d_free[i];
+      }
+
+      // Check for descent (fall back to negative gradient if not)
+      if (quantities->currentIterate()->gradient()->innerProduct(*quantities->direction()) >= 0.0) {
+        resetHistory();
+        quantities->direction()->copy(*quantities->currentIterate()->gradient());
+        quantities->direction()->scale(-1.0);
+      } // end if
+
+    } // end if
+
+    // Set status
+    setStatus(DC_SUCCESS);
+
+  } // end else
+
+  // Print iteration information
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %+.2e %3d", quantities->direction()->normInf(), history_count_);
+
+  // Record event
+  FARSA_EVENT(reporter, E_DIRECTION, quantities->direction()->normInf());
+
+} // end computeDirection
+
+// Reset history
+void DirectionComputationLBFGS::resetHistory()
+{
+
+  // Allocate contiguous storage for current free set
+  iterate_history_.assign(free_indices_.size() * history_length_, 0.0);
+  gradient_history_.assign(free_indices_.size() * history_length_, 0.0);
+  curvature_history_.assign(history_length_, 0.0);
+
+  // Set history as empty
+  history_start_ = 0;
+  history_count_ = 0;
+
+} // end resetHistory
+
+// Remap history
+void DirectionComputationLBFGS::remapHistory(int number_of_variables,
+                                             const std::vector<int>& free_indices)
+{
+
+  // Determine positions of variables in previous free set (-1 if not free)
+  std::vector<int> positions(number_of_variables, -1);
+  for (int i = 0; i < (int)free_indices_.size(); i++) {
+    positions[free_indices_[i]] = i;
+  }
+
+  // Declare storage for new free set
+  size_t n = free_indices.size();
+  std::vector<double> iterate_history(n * history_length_, 0.0);
+  std::vector<double> gradient_history(n * history_length_, 0.0);
+  std::vector<double> curvature_history(history_length_, 0.0);
+  int history_count = 0;
+
+  // Copy pairs (oldest to newest) restricted to new free set, keeping rows of variables
+  // that stay free, leaving rows of variables that join as zero, and dropping pairs that
+  // no longer satisfy curvature condition
+  for (int k = 0; k < history_count_; k++) {
+    int column = (history_start_ + k) % history_length_;
+    const double* s_column = &iterate_history_[(size_t)column * free_indices_.size()];
+    const double* y_column = &gradient_history_[(size_t)column * free_indices_.size()];
+    double* s_new = &iterate_history[(size_t)history_count * n];
+    double* y_new = &gradient_history[(size_t)history_count * n];
+    double sy = 0.0;
+    double ss = 0.0;
+    double yy = 0.0;
+    for (int i = 0; i < (int)n; i++) {
+      if (positions[free_indices[i]] >= 0) {
+        s_new[i] = s_column[positions[free_indices[i]]];
+        y_new[i] = y_column[positions[free_indices[i]]];
+        sy += s_new[i] * y_new[i];
+        ss += s_new[i] * s_new[i];
+        yy += y_new[i] * y_new[i];
+      } // end if
+    }   // end for
+    if (sy > curvature_threshold_ * sqrt(ss) * sqrt(yy) && sy > 0.0) {
+      curvature_history[history_count] = 1.0 / sy;
+      history_count++;
+    }
+    else {
+      std::fill(s_new, s_new + n, 0.0);
+      std::fill(y_new, y_new + n, 0.0);
+    }
+  } // end for
+
+  // Set free set and history
+  free_indices_ = free_indices;
+  iterate_history_.swap(iterate_history);
+  gradient_history_.swap(gradient_history);
+  curvature_history_.swap(curvature_history);
+  history_start_ = 0;
+  history_count_ = history_count;
+
+} // end remapHistory
+
+// Update history
+void DirectionComputationLBFGS::updateHistory(Quantities* quantities)
+{
+
+  // Set values
+  const double* x = quantities->currentIterate()->vector()->values();
+  const double* x_previous = quantities->previousIterate()->vector()->values();
+  const double* g = quantities->currentIterate()->gradient()->values();
+  const double* g_previous = quantities->previousIterate()->gradient()->values();
+
+  // Compute inner products of displacements
+  double sy = 0.0;
+  double ss = 0.0;
+  double yy = 0.0;
+  for (int i = 0; i < (int)free_indices_.size(); i++) {
+    double s = x[free_indices_[i]] - x_previous[free_indices_[i]];
+    double y = g[free_indices_[i]] - g_previous[free_indices_[i]];
+    sy += s * y;
+    ss += s * s;
+    yy += y * y;
+  } // end for
+
+  // Check curvature condition
+  if (sy <= curvature_threshold_ * sqrt(ss) * sqrt(yy) || sy <= 0.0) {
+    return;
+  }
+
+  // Determine column for new pair (overwrite oldest pair if history is full)
+  int column = (history_start_ + history_count_) % history_length_;
+  if (history_count_ < history_length_) {
+    history_count_++;
+  }
+  else {
+    history_start_ = (history_start_ + 1) % history_length_;
+  }
+
+  // Store displacements
+  double* s_column = &iterate_history_[(size_t)column * free_indices_.size()];
+  double* y_column = &gradient_history_[(size_t)column * free_indices_.size()];
+  for (int i = 0; i < (int)free_indices_.size(); i++) {
+    s_column[i] = x[free_indices_[i]] - x_previous[free_indices_[i]];
+    y_column[i] = g[free_indices_[i]] - g_previous[free_indices_[i]];
+  }
+  curvature_history_[column] = 1.0 / sy;
+
+} // end updateHistory
+
+// Apply inverse Hessian approximation
+void DirectionComputationLBFGS::applyInverseHessianApproximation(double* vector) const
+{
+
+  // Set BLAS inputs
+  int n = (int)free_indices_.size();
+  int increment = 1;
+
+  // Declare coefficients
+  std::vector<double> alpha(history_length_);
+
+  // First loop (newest to oldest)
+  for (int k = history_count_ - 1; k >= 0; k--) {
+    int column = (history_start_ + k) % history_length_;
+    double* s_column = const_cast<double*>(&iterate_history_[(size_t)column * n]);
+    double* y_column = const_cast<double*>(&gradient_history_[(size_t)column * n]);
+    alpha[column] = curvature_history_[column] * ddot_(&n, s_column, &increment, vector, &increment);
+    double scalar = -alpha[column];
+    daxpy_(&n, &scalar, y_column, &increment, vector, &increment);
+  } // end for
+
+  // Scale by initial inverse Hessian approximation (s'y/y'y of newest pair)
+  int newest = (history_start_ + history_count_ - 1) % history_length_;
+  double* y_newest = const_cast<double*>(&gradient_history_[(size_t)newest * n]);
+  double scale = 1.0 / (curvature_history_[newest] * ddot_(&n, y_newest, &increment, y_newest, &increment));
+  dscal_(&n, &scale, vector, &increment);
+
+  // Second loop (oldest to newest)
+  for (int k = 0; k < history_count_; k++) {
+    int column = (history_start_ + k) % history_length_;
+    double* s_column = const_cast<double*>(&iterate_history_[(size_t)column * n]);
+    double* y_column = const_cast<double*>(&gradient_history_[(size_t)column * n]);
+    double beta = curvature_history_[column] * ddot_(&n, y_column, &increment, vector, &increment);
+    double scalar = alpha[column] - beta;
+    daxpy_(&n, &scalar, s_column, &increment, vector, &increment);
+  } // end for
+
+} // end applyInverseHessianApproximation
+
+// Read state
+bool DirectionComputationLBFGS::readState(FILE* file)
+{
+
+  // Read free set and history
+  if (!readBinary(file, free_indices_) ||
+      !readBinary(file, iterate_history_) ||
+      !readBinary(file, gradient_history_) ||
+      !readBinary(file, curvature_history_) ||
+      !readBinary(file, history_start_) ||
+      !readBinary(file, history_count_)) {
+    return false;
+  }
+
+  // Check consistency with history length
+  return ((int)curvature_history_.size() == history_length_ &&
+          iterate_history_.size() == free_indices_.size() * history_length_ &&
+          gradient_history_.size() == free_indices_.size() * history_length_ &&
+          history_count_ >= 0 && history_count_ <= history_length_ &&
+          history_start_ >= 0 && history_start_ < history_length_);
+
+} // end readState
+
+// Write state
+bool DirectionComputationLBFGS::writeState(FILE* file) const
+{
+
+  // Write free set and history
+  return (writeBinary(file, free_indices_) &&
+          writeBinary(file, iterate_history_) &&
+          writeBinary(file, gradient_history_) &&
+          writeBinary(file, curvature_history_) &&
+          writeBinary(file, history_start_) &&
+          writeBinary(file, history_count_));
+
+} // end writeState
+
+} // namespace FaRSA
@@ -0,0 +1,193 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSADIRECTIONCOMPUTATIONLBFGS_HPP__
+#define __FARSADIRECTIONCOMPUTATIONLBFGS_HPP__
+
+#include <string>
+#include <vector>
+
+#include "FaRSADirectionComputation.hpp"
+
+namespace FaRSA
+{
+
+/**
+ * DirectionComputationLBFGS class
+ *
+ * Limited-memory BFGS direction in the subspace of free groups (those that are
+ * nonzero at the current iterate) and negative gradient direction in the zero
+ * groups.  The iterate and gradient displacements are stored in contiguous
+ * column-major (number of free variables)-by-(history length) arrays, so each
+ * step of the two-loop recursion is a single BLAS dot product or axpy.  When the
+ * set of free variables changes, the rows of variables that leave are dropped, the
+ * rows of variables that join are zero, and pairs that no longer satisfy the
+ * curvature condition are dropped.
+ */
+class DirectionComputationLBFGS : public DirectionComputation
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+   * Constructor
+   */
+  DirectionComputationLBFGS()
+    : history_length_(0),
+      history_start_(0),
+      history_count_(0){};
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+   * Destructor
+   */
+  ~DirectionComputationLBFGS(){};
+
+  /** @name Options handling methods */
+  //@{
+  /**
+   * Add options
+   * \param[in,out] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void addOptions(Options* options,
+                  const Reporter* reporter);
+  /**
+   * Set options
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void getOptions(const Options* options,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Initialization method */
+  //@{
+  /**
+   * Initialize strategy
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void initialize(const Options* options,
+                  Quantities* quantities,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+   * Get iteration header string
+   * \return string of header values
+   */
+  std::string iterationHeader();
+  /**
+   * Get iteration null values string
+   * \return string of null values
+   */
+  std::string iterationNullValues();
+  /**
+   * Get name of strategy
+   * \return string with name of strategy
+   */
+  std::string name() { return "L-BFGS"; };
+  //@}
+
+  /** @name Direction computation method */
+  //@{
+  /**
+   * Run direction computation
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   * \param[in,out] strategies is pointer to Strategies object from FaRSA
+   */
+  void computeDirection(const Options* options,
+                        Quantities* quantities,
+                        const Reporter* reporter,
+                        Strategies* strategies);
+  //@}
+
+  /** @name Checkpoint methods */
+  //@{
+  /**
+   * Read strategy state from open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool readState(FILE* file);
+  /**
+   * Write strategy state (free set and displacement history) to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeState(FILE* file) const;
+  //@}
+
+private:
+  /** @name Private members (options) */
+  //@{
+  double curvature_threshold_;
+  int history_length_;
+  //@}
+
+  /** @name Private members, history */
+  //@{
+  std::vector<int> free_indices_;         /**< Indices of variables in free groups                */
+  std::vector<double> iterate_history_;   /**< Iterate displacements (column-major)               */
+  std::vector<double> gradient_history_;  /**< Gradient displacements (column-major)              */
+  std::vector<double> curvature_history_; /**< Reciprocals of inner products of displacements     */
+  int history_start_;                     /**< Column of oldest pair in history                   */
+  int history_count_;                     /**< Number of pairs in history                         */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Reset history
+   */
+  void resetHistory();
+  /**
+   * Remap history to new free set
+   * \param[in] number_of_variables is number of variables
+   * \param[in] free_indices is indices of variables in new free set
+   */
+  void remapHistory(int number_of_variables,
+                    const std::vector<int>& free_indices);
+  /**
+   * Update history with displacements from previous to current iterate
+   * \param[in] quantities is pointer to Quantities object from FaRSA
+   */
+  void updateHistory(Quantities* quantities);
+  /**
+   * Apply inverse Hessian approximation (two-loop recursion) in place
+   * \param[in,out] vector is array of length equal to number of free variables
+   */
+  void applyInverseHessianApproximation(double* vector) const;
+  //@}
+
+  /** @name Default compiler generated methods
+   * (Hidden to avoid implicit creation/calling.)
+   */
+  //@{
+  /**
+   * Copy constructor
+   */
+  DirectionComputationLBFGS(const DirectionComputationLBFGS&);
+  /**
+   * Overloaded equals operator
+   */
+  void operator=(const DirectionComputationLBFGS&);
+  //@}
+
+}; // end DirectionComputationLBFGS
+
+} // namespace FaRSA
+
+#endif /* __FARSADIRECTIONCOMPUTATIONLBFGS_HPP__ */
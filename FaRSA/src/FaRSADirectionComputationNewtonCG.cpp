@@ -0,0 +1,256 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cmath>
+#include <vector>
+
+#include "FaRSABLASLAPACK.hpp"
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSADirectionComputationNewtonCG.hpp"
+
+namespace FaRSA
+{
+
+// Add options
+void DirectionComputationNewtonCG::addOptions(Options* options,
+                                              const Reporter* reporter)
+{
+
+  // Add bool options
+  options->addBoolOption(reporter,
+                         "NCG_use_preconditioner",
+                         true,
+                         "Indicator for whether to precondition CG with the Hessian diagonal\n"
+                         "              when the problem supplies it.\n"
+                         "Default     : true.");
+
+  // Add double options
+  options->addDoubleOption(reporter,
+                           "NCG_forcing_exponent",
+                           5e-01,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Exponent in the forcing term for terminating CG.  CG terminates\n"
+                           "              when the residual norm is at most the forcing term\n"
+                           "              min(NCG_forcing_maximum, ||g||^NCG_forcing_exponent) times\n"
+                           "              the norm of the gradient g over the free groups.\n"
+                           "Default     : 5e-01.");
+  options->addDoubleOption(reporter,
+                           "NCG_forcing_maximum",
+                           5e-01,
+                           0.0,
+                           1.0,
+                           "Maximum value of the forcing term for terminating CG.\n"
+                           "Default     : 5e-01.");
+
+  // Add integer options
+  options->addIntegerOption(reporter,
+                            "NCG_cg_iteration_limit",
+                            100,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Limit on the number of CG iterations per direction computation.\n"
+                            "Default     : 100.");
+
+} // end addOptions
+
+// Set options
+void DirectionComputationNewtonCG::getOptions(const Options* options,
+                                              const Reporter* reporter)
+{
+
+  // Read bool options
+  options->valueAsBool(reporter, "NCG_use_preconditioner", use_preconditioner_);
+
+  // Read double options
+  options->valueAsDouble(reporter, "NCG_forcing_exponent", forcing_exponent_);
+  options->valueAsDouble(reporter, "NCG_forcing_maximum", forcing_maximum_);
+
+  // Read integer options
+  options->valueAsInteger(reporter, "NCG_cg_iteration_limit", cg_iteration_limit_);
+
+} // end getOptions
+
+// Initialize
+void DirectionComputationNewtonCG::initialize(const Options* options,
+                                              Quantities* quantities,
+                                              const Reporter* reporter)
+{
+  cg_iterations_ = 0;
+}
+
+// Iteration header
+std::string DirectionComputationNewtonCG::iterationHeader()
+{
+  return "  |Step|   CG";
+}
+
+// Iteration null values string
+std::string DirectionComputationNewtonCG::iterationNullValues()
+{
+  return "--------- ----";
+}
+
+// Compute direction
+void DirectionComputationNewtonCG::computeDirection(const Options* options,
+                                                    Quantities* quantities,
+                                                    const Reporter* reporter,
+                                                    Strategies* strategies)
+{
+
+  // Initialize values
+  setStatus(DC_UNSET);
+  quantities->setTrialIterateToCurrentIterate();
+  cg_iterations_ = 0;
+
+  // Evaluate current objective and gradient
+  bool evaluation_success = (quantities->currentIterate()->evaluateObjective(*quantities) &&
+                             quantities->currentIterate()->evaluateGradient(*quantities));
+
+  // Check for successful evaluation
+  if (!evaluation_success) {
+    setStatus(DC_EVALUATION_FAILURE);
+  }
+  else {
+
+    // Set direction as negative gradient
+    quantities->direction()->copy(*quantities->currentIterate()->gradient());
+    quantities->direction()->scale(-1.0);
+
+    // Determine free variables
+    quantities->partitionGroups();
+    const std::vector<int>& groups_free = quantities->groupsFree();
+    std::vector<int> free_indices;
+    for (int k = 0; k < (int)groups_free.size(); k++) {
+      const std::vector<int>& group = quantities->groups()[groups_free[k]];
+      free_indices.insert(free_indices.end(), group.begin(), group.end());
+    }
+    int n = (int)free_indices.size();
+
+    // Compute Newton direction over free variables (if any)
+    if (n > 0) {
+      evaluation_success = computeNewtonStep(quantities, groups_free, free_indices);
+    }
+
+    // Set status
+    setStatus(evaluation_success ? DC_SUCCESS : DC_EVALUATION_FAILURE);
+
+  } // end else
+
+  // Print iteration information
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %+.2e %4d", quantities->direction()->normInf(), cg_iterations_);
+
+  // Record event
+  FARSA_EVENT(reporter, E_DIRECTION, quantities->direction()->normInf());
+
+} // end computeDirection
+
+// Compute Newton step
+bool DirectionComputationNewtonCG::computeNewtonStep(Quantities* quantities,
+                                                     const std::vector<int>& groups_free,
+                                                     const std::vector<int>& free_indices)
+{
+
+  // Set number of free variables
+  int n = (int)free_indices.size();
+
+  // Set problem, point, and scale
+  std::shared_ptr<Problem> problem = quantities->currentIterate()->problem();
+  const double* x = quantities->currentIterate()->vector()->values();
+  double scale = quantities->currentIterate()->scale();
+
+  // Set residual as negative gradient over free variables
+  std::vector<double> residual(n);
+  const double* g = quantities->currentIterate()->gradient()->values();
+  for (int i = 0; i < n; i++) {
+    residual[i] = -g[free_indices[i]];
+  }
+
+  // Set BLAS inputs
+  int increment = 1;
+
+  // Set termination tolerance by forcing sequence
+  double gradient_norm = sqrt(ddot_(&n, residual.data(), &increment, residual.data(), &increment));
+  double tolerance = fmin(forcing_maximum_, pow(gradient_norm, forcing_exponent_)) * gradient_norm;
+
+  // Set preconditioner (inverse of diagonal, or identity if unavailable)
+  std::vector<double> preconditioner(n, 1.0);
+  if (use_preconditioner_ && problem->evaluateHessianDiagonal(x, groups_free, preconditioner.data())) {
+    for (int i = 0; i < n; i++) {
+      preconditioner[i] = (scale * preconditioner[i] > 0.0 && std::isfinite(preconditioner[i])) ? 1.0 / (scale * preconditioner[i]) : 1.0;
+    }
+  }
+  else {
+    preconditioner.assign(n, 1.0);
+  }
+
+  // Initialize CG
+  std::vector<double> step(n, 0.0);
+  std::vector<double> preconditioned_residual(n);
+  std::vector<double> search_direction(n);
+  std::vector<double> product(n);
+  for (int i = 0; i < n; i++) {
+    preconditioned_residual[i] = preconditioner[i] * residual[i];
+  }
+  search_direction = preconditioned_residual;
+  double residual_inner_product = ddot_(&n, residual.data(), &increment, preconditioned_residual.data(), &increment);
+
+  // CG loop
+  while (cg_iterations_ < cg_iteration_limit_ && gradient_norm > tolerance) {
+
+    // Compute Hessian-vector product
+    if (!problem->evaluateHessianVectorProduct(x, groups_free, search_direction.data(), product.data())) {
+      return false;
+    }
+    dscal_(&n, &scale, product.data(), &increment);
+
+    // Check for nonpositive curvature (keep current step, or preconditioned gradient in first iteration)
+    double curvature = ddot_(&n, search_direction.data(), &increment, product.data(), &increment);
+    if (curvature <= 0.0 || !std::isfinite(curvature)) {
+      if (cg_iterations_ == 0) {
+        step = search_direction;
+      }
+      break;
+    } // end if
+
+    // Update step and residual
+    double alpha = residual_inner_product / curvature;
+    double minus_alpha = -alpha;
+    daxpy_(&n, &alpha, search_direction.data(), &increment, step.data(), &increment);
+    daxpy_(&n, &minus_alpha, product.data(), &increment, residual.data(), &increment);
+    cg_iterations_++;
+
+    // Check residual
+    if (sqrt(ddot_(&n, residual.data(), &increment, residual.data(), &increment)) <= tolerance) {
+      break;
+    }
+
+    // Update search direction
+    for (int i = 0; i < n; i++) {
+      preconditioned_residual[i] = preconditioner[i] * residual[i];
+    }
+    double residual_inner_product_new = ddot_(&n, residual.data(), &increment, preconditioned_residual.data(), &increment);
+    double beta = residual_inner_product_new / residual_inner_product;
+    residual_inner_product = residual_inner_product_new;
+    for (int i = 0; i < n; i++) {
+      search_direction[i] = preconditioned_residual[i] + beta * search_direction[i];
+    }
+
+  } // end while
+
+  // Set direction over free variables
+  double* d = quantities->direction()->valuesModifiable();
+  for (int i = 0; i < n; i++) {
+    d[free_indices[i]] = step[i];
+  }
+
+  // Return
+  return true;
+
+} // end computeNewtonStep
+
+} // namespace FaRSA
@@ -0,0 +1,161 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSADIRECTIONCOMPUTATIONNEWTONCG_HPP__
+#define __FARSADIRECTIONCOMPUTATIONNEWTONCG_HPP__
+
+#include <vector>
+
+#include "FaRSADirectionComputation.hpp"
+
+namespace FaRSA
+{
+
+/**
+ * DirectionComputationNewtonCG class
+ *
+ * Truncated Newton direction in the subspace of free groups (those that are
+ * nonzero at the current iterate), computed by preconditioned conjugate gradient
+ * applied to the Newton system using Hessian-vector products, and negative
+ * gradient direction in the zero groups.  The preconditioner is the Hessian
+ * diagonal when the problem supplies it (and the identity otherwise).  CG is
+ * terminated when the residual satisfies a forcing-sequence condition relative
+ * to the gradient norm, when the iteration limit is reached, or when
+ * nonpositive curvature is detected.
+ */
+class DirectionComputationNewtonCG : public DirectionComputation
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+   * Constructor
+   */
+  DirectionComputationNewtonCG()
+    : cg_iterations_(0){};
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+   * Destructor
+   */
+  ~DirectionComputationNewtonCG(){};
+
+  /** @name Options handling methods */
+  //@{
+  /**
+   * Add options
+   * \param[in,out] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void addOptions(Options* options,
+                  const Reporter* reporter);
+  /**
+   * Set options
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void getOptions(const Options* options,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Initialization method */
+  //@{
+  /**
+   * Initialize strategy
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void initialize(const Options* options,
+                  Quantities* quantities,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+   * Get iteration header string
+   * \return string of header values
+   */
+  std::string iterationHeader();
+  /**
+   * Get iteration null values string
+   * \return string of null values
+   */
+  std::string iterationNullValues();
+  /**
+   * Get name of strategy
+   * \return string with name of strategy
+   */
+  std::string name() { return "Newton-CG"; };
+  //@}
+
+  /** @name Direction computation method */
+  //@{
+  /**
+   * Run direction computation
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   * \param[in,out] strategies is pointer to Strategies object from FaRSA
+   */
+  void computeDirection(const Options* options,
+                        Quantities* quantities,
+                        const Reporter* reporter,
+                        Strategies* strategies);
+  //@}
+
+private:
+  /** @name Private members (options) */
+  //@{
+  bool use_preconditioner_;
+  double forcing_exponent_;
+  double forcing_maximum_;
+  int cg_iteration_limit_;
+  //@}
+
+  /** @name Private members */
+  //@{
+  int cg_iterations_; /**< Number of CG iterations in latest direction computation */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Compute truncated Newton step over free variables by preconditioned CG and
+   * set corresponding elements of direction
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] groups_free is vector of indices of free groups
+   * \param[in] free_indices is vector of indices of variables in free groups
+   * \return indicator of evaluation success
+   */
+  bool computeNewtonStep(Quantities* quantities,
+                         const std::vector<int>& groups_free,
+                         const std::vector<int>& free_indices);
+  //@}
+
+  /** @name Default compiler generated methods
+   * (Hidden to avoid implicit creation/calling.)
+   */
+  //@{
+  /**
+   * Copy constructor
+   */
+  DirectionComputationNewtonCG(const DirectionComputationNewtonCG&);
+  /**
+   * Overloaded equals operator
+   */
+  void operator=(const DirectionComputationNewtonCG&);
+  //@}
+
+}; // end DirectionComputationNewtonCG
+
+} // namespace FaRSA
+
+#endif /* __FARSADIRECTIONCOMPUTATIONNEWTONCG_HPP__ */
@@ -53,49 +53,30 @@ void DirectionComputationProximalGradient::computeDirection(const Options* optio
   setStatus(DC_UNSET);
   quantities->setTrialIterateToCurrentIterate();
 
-  // try direction computation, terminate on any exception
-  try {
+  // Evaluate current objective and gradient
+  bool evaluation_success = (quantities->currentIterate()->evaluateObjective(*quantities) &&
+                             quantities->currentIterate()->evaluateGradient(*quantities));
 
-    // Initialize boolean for evaluation
-    bool evaluation_success = false;
-
-    // Evaluate current objective
-    evaluation_success = quantities->currentIterate()->evaluateObjective(*quantities);
-
-    // Check for successful evaluation
-    if (!evaluation_success) {
-      THROW_EXCEPTION(DC_EVALUATION_FAILURE_EXCEPTION, "Direction computation unsuccessful. Evaluation failed.");
-    }
-
-    // Evaluate current gradient
-    evaluation_success = quantities->currentIterate()->evaluateGradient(*quantities);
-
-    // Check for successful evaluation
-    if (!evaluation_success) {
-      THROW_EXCEPTION(DC_EVALUATION_FAILURE_EXCEPTION, "Direction computation unsuccessful. Evaluation failed.");
-    }
+  // Check for successful evaluation
+  if (!evaluation_success) {
+    setStatus(DC_EVALUATION_FAILURE);
+  }
+  else {
 
-    // Set trial iterate
+    // Set direction as negative gradient
     quantities->direction()->copy(*quantities->currentIterate()->gradient());
     quantities->direction()->scale(-1.0);
 
     // Set status
     setStatus(DC_SUCCESS);
 
-    // Check for success
-    THROW_EXCEPTION(DC_SUCCESS_EXCEPTION, "Direction computation successful.")
-
-  } // end try
-
-  // catch exceptions
-  catch (DC_SUCCESS_EXCEPTION& exec) {
-    setStatus(DC_SUCCESS);
-  } catch (DC_EVALUATION_FAILURE_EXCEPTION& exec) {
-    setStatus(DC_EVALUATION_FAILURE);
-  }
+  } // end else
 
   // Print iteration information
-  reporter->printf(R_SOLVER, R_PER_ITERATION, " %+.2e", quantities->direction()->normInf());
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %+.2e", quantities->direction()->normInf());
+
+  // Record event
+  FARSA_EVENT(reporter, E_DIRECTION, quantities->direction()->normInf());
 
 } // end computeDirection
 
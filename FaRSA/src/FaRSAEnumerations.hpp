@@ -76,6 +76,31 @@ enum ReportLevel
   R_PER_ITERATION,
   R_PER_INNER_ITERATION
 };
+/**
+ * Report full policy enumerations (asynchronous reports)
+ */
+enum ReportFullPolicy
+{
+  R_BLOCK_WHEN_FULL = 0,
+  R_DROP_WHEN_FULL
+};
+/**
+ * Event type enumerations (built-in events of event log)
+ */
+enum EventType
+{
+  E_ITERATION = 0,
+  E_DIRECTION,
+  E_STEPSIZE
+};
+/**
+ * Event field type enumerations
+ */
+enum EventFieldType
+{
+  E_FIELD_INT = 0,
+  E_FIELD_DOUBLE
+};
 /**
  * Sparse format enumerations
  */
@@ -85,6 +110,24 @@ enum SparseFormatType
   M_COMPRESSED_SPARSE_COLUMN,
   M_COMPRESSED_SPARSE_ROW
 };
+/**
+ * Matrix value type enumerations
+ */
+enum MatrixValueType
+{
+  M_VALUE_DOUBLE = 0,
+  M_VALUE_FLOAT,
+  M_VALUE_PATTERN
+};
+/**
+ * Cache data type enumerations
+ */
+enum CacheDataType
+{
+  C_MATRIX_DATA = 0,
+  C_VECTOR_DATA,
+  C_GROUP_DATA
+};
 //@}
 
 } // namespace FaRSA
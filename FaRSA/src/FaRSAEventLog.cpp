@@ -0,0 +1,251 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include "FaRSABinaryIO.hpp"
+#include "FaRSAEventLog.hpp"
+
+namespace FaRSA
+{
+
+// Constructor
+EventLog::EventLog()
+  : file_(nullptr)
+{
+
+  // Define built-in events (in order of EventType)
+  defineEvent("iteration", {"iteration", "objective"}, {E_FIELD_INT, E_FIELD_DOUBLE});
+  defineEvent("direction", {"norm_inf"}, {E_FIELD_DOUBLE});
+  defineEvent("stepsize", {"stepsize"}, {E_FIELD_DOUBLE});
+
+} // end constructor
+
+// Destructor
+EventLog::~EventLog()
+{
+
+  // Close file
+  close();
+
+} // end destructor
+
+// Open file
+bool EventLog::open(std::string file_name)
+{
+
+  // Close open file
+  close();
+
+  // Open file
+  file_ = fopen(file_name.c_str(), "wb");
+  if (file_ == nullptr) {
+    return false;
+  }
+
+  // Write header
+  if (!writeBinary(file_, std::string(FARSA_EVENT_LOG_IDENTIFIER)) ||
+      !writeBinary(file_, (int)FARSA_EVENT_LOG_VERSION)) {
+    fclose(file_);
+    file_ = nullptr;
+    return false;
+  } // end if
+
+  // Write event definitions
+  for (int event = 0; event < (int)events_.size(); event++) {
+    appendDefinition(event);
+  }
+  flush();
+
+  // Return
+  return true;
+
+} // end open
+
+// Flush
+void EventLog::flush()
+{
+
+  // Write buffer
+  if (file_ && buffer_.size() > 0) {
+    fwrite(buffer_.data(), 1, buffer_.size(), file_);
+  }
+  buffer_.clear();
+
+} // end flush
+
+// Close
+void EventLog::close()
+{
+
+  // Flush, then close file
+  if (file_) {
+    flush();
+    fclose(file_);
+  }
+
+  // Set pointer to null
+  file_ = nullptr;
+
+} // end close
+
+// Define event
+int EventLog::defineEvent(std::string name,
+                          const std::vector<std::string>& field_names,
+                          const std::vector<EventFieldType>& field_types)
+{
+
+  // Add event (fields without a type are ignored)
+  Event event;
+  event.name = name;
+  event.field_types = field_types;
+  event.field_names = field_names;
+  event.field_names.resize(field_types.size());
+  events_.push_back(event);
+
+  // Write definition
+  if (file_) {
+    appendDefinition((int)events_.size() - 1);
+  }
+
+  // Return event
+  return (int)events_.size() - 1;
+
+} // end defineEvent
+
+// Append string
+void EventLog::appendString(const std::string& value)
+{
+
+  // Append length, then characters
+  append((long long)value.size());
+  buffer_.insert(buffer_.end(), value.begin(), value.end());
+
+} // end appendString
+
+// Append value of field
+void EventLog::appendField(const Event& event,
+                           int field,
+                           double value)
+{
+
+  // Append value as field type
+  if (event.field_types[field] == E_FIELD_INT) {
+    append((int)value);
+  }
+  else {
+    append(value);
+  }
+
+} // end appendField
+
+// Append values of missing fields
+void EventLog::appendValues(const Event& event,
+                            int field)
+{
+
+  // Append zeros
+  for (; field < (int)event.field_types.size(); field++) {
+    appendField(event, field, 0.0);
+  }
+
+} // end appendValues
+
+// Append definition
+void EventLog::appendDefinition(int event)
+{
+
+  // Append tag, event, name, and fields
+  append((unsigned char)0);
+  append(event);
+  appendString(events_[event].name);
+  append((int)events_[event].field_types.size());
+  for (int field = 0; field < (int)events_[event].field_types.size(); field++) {
+    appendString(events_[event].field_names[field]);
+    append((unsigned char)events_[event].field_types[field]);
+  } // end for
+
+} // end appendDefinition
+
+// Decode
+bool EventLog::decode(std::string file_name,
+                      FILE* output)
+{
+
+  // Open file
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  // Read and check header
+  std::string identifier;
+  int version;
+  bool success = (readBinary(file, identifier) && identifier == FARSA_EVENT_LOG_IDENTIFIER &&
+                  readBinary(file, version) && version == FARSA_EVENT_LOG_VERSION);
+
+  // Read records (until end of file)
+  std::vector<Event> events;
+  unsigned char tag;
+  while (success && readBinary(file, tag)) {
+    int event;
+    success = (readBinary(file, event) && event >= 0);
+    if (!success) {
+      break;
+    }
+
+    // Read definition
+    if (tag == 0) {
+      if (event >= (int)events.size()) {
+        events.resize(event + 1);
+      }
+      int number_of_fields;
+      success = (readBinary(file, events[event].name) && readBinary(file, number_of_fields) && number_of_fields >= 0);
+      events[event].field_names.resize(success ? number_of_fields : 0);
+      events[event].field_types.resize(success ? number_of_fields : 0);
+      for (int field = 0; success && field < number_of_fields; field++) {
+        unsigned char field_type;
+        success = (readBinary(file, events[event].field_names[field]) && readBinary(file, field_type));
+        events[event].field_types[field] = (EventFieldType)field_type;
+      } // end for
+    }   // end if
+
+    // Read data and write line
+    else {
+      success = (tag == 1 && event < (int)events.size());
+      if (success) {
+        fprintf(output, "%s", events[event].name.c_str());
+      }
+      for (int field = 0; success && field < (int)events[event].field_types.size(); field++) {
+        if (events[event].field_types[field] == E_FIELD_INT) {
+          int value;
+          success = readBinary(file, value);
+          if (success) {
+            fprintf(output, " %s=%d", events[event].field_names[field].c_str(), value);
+          }
+        }
+        else {
+          double value;
+          success = readBinary(file, value);
+          if (success) {
+            fprintf(output, " %s=%.17g", events[event].field_names[field].c_str(), value);
+          }
+        }
+      } // end for
+      if (success) {
+        fprintf(output, "\n");
+      }
+    } // end else
+
+  } // end while
+
+  // Close file
+  fclose(file);
+
+  // Return
+  return success;
+
+} // end decode
+
+} // namespace FaRSA
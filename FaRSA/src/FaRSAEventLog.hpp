@@ -0,0 +1,213 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSAEVENTLOG_HPP__
+#define __FARSAEVENTLOG_HPP__
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "FaRSADefinitions.hpp"
+#include "FaRSAEnumerations.hpp"
+
+namespace FaRSA
+{
+
+/**
+  * EventLog class
+  * (compact binary log of typed records, decoded offline (see decode); the file holds
+  *  an identifier and version, then definition records (name, field names, and field
+  *  types of an event) and data records (event and field values in binary); the
+  *  built-in events (see EventType) are defined on construction and written on open,
+  *  other events may be added with defineEvent)
+  */
+class EventLog
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Construct EventLog (defines built-in events)
+    */
+  EventLog();
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Delete EventLog (closes file)
+    */
+  ~EventLog();
+  //@}
+
+  /** @name Open and close methods */
+  //@{
+  /**
+    * Open file and write header and event definitions
+    * \param[in] file_name is name of file to write
+    * \return indicator of success (true) or failure (false)
+    */
+  bool open(std::string file_name);
+  /**
+    * Flush records to file
+    */
+  void flush();
+  /**
+    * Flush records to file and close it
+    */
+  void close();
+  /**
+    * Get indicator of open file
+    * \return true if file is open, false otherwise
+    */
+  inline bool isOpen() const { return file_ != nullptr; };
+  //@}
+
+  /** @name Event methods */
+  //@{
+  /**
+    * Define event (definition written to file, if open, and on open)
+    * \param[in] name is name of event
+    * \param[in] field_names is vector of names of fields
+    * \param[in] field_types is vector of EventFieldTypes of fields
+    * \return event (index) to use in record
+    */
+  int defineEvent(std::string name,
+                  const std::vector<std::string>& field_names,
+                  const std::vector<EventFieldType>& field_types);
+  /**
+    * Record event (values converted to field types; missing fields recorded as zero,
+    * extra values ignored; nothing recorded if file is not open)
+    * \param[in] event is event (EventType or index returned by defineEvent)
+    * \param[in] values are values of fields (int or double)
+    */
+  template <typename... T>
+  inline void record(int event,
+                     T... values)
+  {
+    if (file_ == nullptr || event < 0 || event >= (int)events_.size()) {
+      return;
+    }
+    append((unsigned char)1);
+    append(event);
+    appendValues(events_[event], 0, values...);
+    if (buffer_.size() >= FARSA_EVENT_LOG_BUFFER_SIZE) {
+      flush();
+    }
+  }
+  //@}
+
+  /** @name Decode method */
+  //@{
+  /**
+    * Decode event log, writing one line per record (event name, then field=value pairs)
+    * \param[in] file_name is name of event log file
+    * \param[in] output is pointer to open file to which to write
+    * \return indicator of success (true) or failure, e.g., if file is not an event log (false)
+    */
+  static bool decode(std::string file_name,
+                     FILE* output);
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Copy constructor
+    */
+  EventLog(const EventLog&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const EventLog&);
+  //@}
+
+  /**
+    * Event (definition)
+    */
+  struct Event
+  {
+    std::string name;                        /**< Name of event */
+    std::vector<std::string> field_names;    /**< Names of fields */
+    std::vector<EventFieldType> field_types; /**< Types of fields */
+  };
+
+  /** @name Private members */
+  //@{
+  FILE* file_;                /**< File (nullptr if not open) */
+  std::vector<Event> events_; /**< Event definitions */
+  std::vector<char> buffer_;  /**< Records not yet written to file */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+    * Append value to buffer
+    * \param[in] value is value to append
+    */
+  template <typename T>
+  inline void append(const T& value)
+  {
+    size_t size = buffer_.size();
+    buffer_.resize(size + sizeof(T));
+    memcpy(&buffer_[size], &value, sizeof(T));
+  }
+  /**
+    * Append string (length followed by characters) to buffer
+    * \param[in] value is string to append
+    */
+  void appendString(const std::string& value);
+  /**
+    * Append value of field to buffer (converted to field type)
+    * \param[in] event is event of record
+    * \param[in] field is index of field
+    * \param[in] value is value of field
+    */
+  void appendField(const Event& event,
+                   int field,
+                   double value);
+  /**
+    * Append values of fields (missing fields as zero)
+    * \param[in] event is event of record
+    * \param[in] field is index of first field to append
+    */
+  void appendValues(const Event& event,
+                    int field);
+  /**
+    * Append values of fields (first value, then remaining values)
+    * \param[in] event is event of record
+    * \param[in] field is index of first field to append
+    * \param[in] value is value of field
+    * \param[in] values are values of remaining fields
+    */
+  template <typename V, typename... T>
+  inline void appendValues(const Event& event,
+                           int field,
+                           V value,
+                           T... values)
+  {
+    if (field < (int)event.field_types.size()) {
+      appendField(event, field, (double)value);
+      appendValues(event, field + 1, values...);
+    }
+  }
+  /**
+    * Append definition of event to buffer
+    * \param[in] event is event (index)
+    */
+  void appendDefinition(int event);
+  //@}
+
+}; // end EventLog
+
+} // namespace FaRSA
+
+#endif /* __FARSAEVENTLOG_HPP__ */
@@ -0,0 +1,204 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FaRSAFileCache.hpp"
+
+namespace FaRSA
+{
+
+// Constructor
+FileCache::FileCache(const char* file_name,
+                     CacheDataType data_type,
+                     long long parameters)
+  : sidecar_file_name_(std::string(file_name) + FARSA_CACHE_SUFFIX),
+    key_computed_(false),
+    mapped_data_(nullptr),
+    mapped_length_(0)
+{
+
+  // Initialize header
+  memset(header_, 0, FARSA_CACHE_HEADER_SIZE);
+
+  // Open file
+  int file_descriptor = open(file_name, O_RDONLY);
+  if (file_descriptor < 0) {
+    return;
+  }
+
+  // Get file size and modification time
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0) {
+    close(file_descriptor);
+    return;
+  }
+  long long size = (long long)file_status.st_size;
+  long long modification_seconds = (long long)file_status.st_mtim.tv_sec;
+  long long modification_nanoseconds = (long long)file_status.st_mtim.tv_nsec;
+
+  // Hash evenly spaced samples (whole file if small) with FNV-1a, so a file rewritten
+  // with equal size within the resolution of the modification time is still detected
+  unsigned long long hash = 14695981039346656037ULL;
+  long long number_of_samples = FARSA_CACHE_HASH_SAMPLES;
+  long long sample_size = FARSA_CACHE_HASH_SAMPLE_SIZE;
+  long long stride = (size - sample_size) / (number_of_samples - 1);
+  if (size <= number_of_samples * sample_size) {
+    number_of_samples = (size + sample_size - 1) / sample_size;
+    stride = sample_size;
+  }
+  char sample[FARSA_CACHE_HASH_SAMPLE_SIZE];
+  for (long long i = 0; i < number_of_samples; i++) {
+    ssize_t bytes_read = pread(file_descriptor, sample, (size_t)sample_size, (off_t)(i * stride));
+    if (bytes_read < 0) {
+      close(file_descriptor);
+      return;
+    }
+    for (ssize_t j = 0; j < bytes_read; j++) {
+      hash = (hash ^ (unsigned char)sample[j]) * 1099511628211ULL;
+    }
+  } // end for
+
+  // Close file
+  close(file_descriptor);
+
+  // Set header (identifier, version, type of data, key, and parameters)
+  int version = FARSA_CACHE_VERSION;
+  int type = (int)data_type;
+  strncpy(header_, FARSA_CACHE_IDENTIFIER, 16);
+  memcpy(header_ + 16, &version, sizeof(int));
+  memcpy(header_ + 20, &type, sizeof(int));
+  memcpy(header_ + 24, &size, sizeof(long long));
+  memcpy(header_ + 32, &modification_seconds, sizeof(long long));
+  memcpy(header_ + 40, &modification_nanoseconds, sizeof(long long));
+  memcpy(header_ + 48, &hash, sizeof(unsigned long long));
+  memcpy(header_ + 56, &parameters, sizeof(long long));
+  key_computed_ = true;
+
+} // end constructor
+
+// Destructor
+FileCache::~FileCache()
+{
+
+  // Unmap sidecar
+  if (mapped_data_ != nullptr) {
+    munmap(mapped_data_, mapped_length_);
+    mapped_data_ = nullptr;
+  }
+
+} // end destructor
+
+// Map sidecar
+bool FileCache::map()
+{
+
+  // Check key
+  if (!key_computed_ || mapped_data_ != nullptr) {
+    return mapped_data_ != nullptr;
+  }
+
+  // Open sidecar
+  int file_descriptor = open(sidecar_file_name_.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    return false;
+  }
+
+  // Get sidecar length
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size < FARSA_CACHE_HEADER_SIZE) {
+    close(file_descriptor);
+    return false;
+  }
+
+  // Map sidecar (private and writable, so modified pages are copied, never written to
+  // sidecar; mapping persists after sidecar is closed)
+  size_t mapped_length = (size_t)file_status.st_size;
+  void* mapped_data = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+  close(file_descriptor);
+  if (mapped_data == MAP_FAILED) {
+    return false;
+  }
+
+  // Check header
+  if (memcmp(mapped_data, header_, FARSA_CACHE_HEADER_SIZE) != 0) {
+    munmap(mapped_data, mapped_length);
+    return false;
+  }
+
+  // Set mapping
+  mapped_data_ = mapped_data;
+  mapped_length_ = mapped_length;
+
+  // Return
+  return true;
+
+} // end map
+
+// Release mapping
+void* FileCache::releaseMapping(size_t& mapped_length)
+{
+
+  // Transfer mapping
+  void* mapped_data = mapped_data_;
+  mapped_length = mapped_length_;
+  mapped_data_ = nullptr;
+  mapped_length_ = 0;
+
+  // Return
+  return mapped_data;
+
+} // end releaseMapping
+
+// Write sidecar
+bool FileCache::write(const std::vector<std::pair<const void*, size_t> >& parts) const
+{
+
+  // Check key
+  if (!key_computed_) {
+    return false;
+  }
+
+  // Open temporary file (named by process, so concurrent writers do not interfere)
+  std::string temporary_file = sidecar_file_name_ + ".tmp." + std::to_string((long long)getpid());
+  FILE* f_out = fopen(temporary_file.c_str(), "wb");
+  if (f_out == NULL) {
+    return false;
+  }
+
+  // Write header
+  bool written = (fwrite(header_, 1, FARSA_CACHE_HEADER_SIZE, f_out) == FARSA_CACHE_HEADER_SIZE);
+
+  // Write parts (padded, so each part is aligned when mapped)
+  const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (size_t i = 0; written && i < parts.size(); i++) {
+    written = (parts[i].second == 0 || fwrite(parts[i].first, 1, parts[i].second, f_out) == parts[i].second);
+    size_t padding_length = (8 - parts[i].second % 8) % 8;
+    written = written && (padding_length == 0 || fwrite(padding, 1, padding_length, f_out) == padding_length);
+  } // end for
+
+  // Close file
+  written = (fclose(f_out) == 0) && written;
+
+  // Replace previous sidecar (rename is atomic, so readers see old or new sidecar)
+  if (written) {
+    written = (rename(temporary_file.c_str(), sidecar_file_name_.c_str()) == 0);
+  }
+  if (!written) {
+    remove(temporary_file.c_str());
+  }
+
+  // Return
+  return written;
+
+} // end write
+
+} // namespace FaRSA
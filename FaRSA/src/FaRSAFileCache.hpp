@@ -0,0 +1,124 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSAFILECACHE_HPP__
+#define __FARSAFILECACHE_HPP__
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FaRSADefinitions.hpp"
+#include "FaRSAEnumerations.hpp"
+
+namespace FaRSA
+{
+
+/**
+  * FileCache class
+  * (binary sidecar of a parsed text file, written next to the file (file name followed
+  *  by FARSA_CACHE_SUFFIX) and memory-mapped instead of parsing the file again; the
+  *  sidecar header holds a key of the file (size, modification time, and hash of
+  *  sampled blocks), the type of data, and the parameters with which it was parsed,
+  *  so a sidecar of a modified file, or of other data or parameters, is not used)
+  */
+class FileCache
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Constructor (computes key of file)
+    * \param[in] file_name is name of parsed file
+    * \param[in] data_type is type of data parsed from file
+    * \param[in] parameters is value encoding parameters with which file is parsed
+    */
+  FileCache(const char* file_name,
+            CacheDataType data_type,
+            long long parameters);
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Destructor (unmaps sidecar, unless mapping was released)
+    */
+  ~FileCache();
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+    * Get name of sidecar
+    * \return name of sidecar file
+    */
+  inline const std::string& sidecarFileName() const { return sidecar_file_name_; };
+  /**
+    * Get data of mapped sidecar (after header)
+    * \return pointer to data (nullptr if not mapped)
+    */
+  inline const char* data() const { return (mapped_data_ != nullptr) ? (const char*)mapped_data_ + FARSA_CACHE_HEADER_SIZE : nullptr; };
+  /**
+    * Get length of data of mapped sidecar (after header)
+    * \return length of data
+    */
+  inline size_t length() const { return (mapped_data_ != nullptr) ? mapped_length_ - FARSA_CACHE_HEADER_SIZE : 0; };
+  //@}
+
+  /** @name Map and write methods */
+  //@{
+  /**
+    * Map sidecar (privately and writable, so modified pages are never written to sidecar)
+    * \return true if sidecar exists and its key, type of data, and parameters match,
+    *         false otherwise
+    */
+  bool map();
+  /**
+    * Release mapping (caller unmaps, e.g., if data is aliased)
+    * \param[out] mapped_length is length of mapping
+    * \return pointer to mapping (header, then data)
+    */
+  void* releaseMapping(size_t& mapped_length);
+  /**
+    * Write sidecar (header, then parts, each padded to a multiple of 8 bytes); written
+    * under a temporary name and renamed, so concurrent readers never see a partial file
+    * \param[in] parts is vector of (pointer, length) pairs of data to write
+    * \return indicator of success (true) or failure, e.g., if directory is not writable (false)
+    */
+  bool write(const std::vector<std::pair<const void*, size_t> >& parts) const;
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Copy constructor
+    */
+  FileCache(const FileCache&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const FileCache&);
+  //@}
+
+  /** @name Private members */
+  //@{
+  std::string sidecar_file_name_;         /**< Name of sidecar file */
+  char header_[FARSA_CACHE_HEADER_SIZE];  /**< Header (key of file, type of data, and parameters) */
+  bool key_computed_;                     /**< Indicator of key computed (file exists) */
+  void* mapped_data_;                     /**< Memory-mapped sidecar */
+  size_t mapped_length_;                  /**< Length of memory-mapped sidecar */
+  //@}
+
+}; // end FileCache
+
+} // namespace FaRSA
+
+#endif /* __FARSAFILECACHE_HPP__ */
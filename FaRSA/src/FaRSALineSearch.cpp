@@ -0,0 +1,76 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cmath>
+
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSALineSearch.hpp"
+
+namespace FaRSA
+{
+
+// Initial stepsize
+double LineSearch::initialStepsize(Quantities* quantities,
+                                   const std::string& initialization,
+                                   double stepsize_initial,
+                                   double stepsize_increase_factor,
+                                   double stepsize_minimum,
+                                   double stepsize_maximum)
+{
+
+  // Initialize stepsize
+  double stepsize = stepsize_initial;
+
+  // Check for previous iterate (none in first iteration)
+  if (quantities->previousIterate() == nullptr) {
+    return fmax(stepsize_minimum, stepsize);
+  }
+
+  // Set stepsize based on initialization strategy
+  if (initialization.compare("previous") == 0) {
+    if (quantities->stepsize() > 0.0) {
+      stepsize = fmin(stepsize_initial, stepsize_increase_factor * quantities->stepsize());
+    }
+  } // end if
+  else if (initialization.compare("BB1") == 0 ||
+           initialization.compare("BB2") == 0) {
+
+    // Allocate work vectors (once, sharing thread pool of iterates)
+    const Vector& x = *quantities->currentIterate()->vector();
+    if (iterate_difference_.length() != x.length()) {
+      iterate_difference_.setLength(x.length());
+      gradient_difference_.setLength(x.length());
+    }
+    iterate_difference_.setThreadPool(x.threadPool());
+    gradient_difference_.setThreadPool(x.threadPool());
+
+    // Compute iterate and gradient differences
+    iterate_difference_.linearCombination(1.0, x, -1.0, *quantities->previousIterate()->vector());
+    gradient_difference_.linearCombination(1.0, *quantities->currentIterate()->gradient(), -1.0, *quantities->previousIterate()->gradient());
+
+    // Compute inner products
+    double sy = iterate_difference_.innerProduct(gradient_difference_);
+
+    // Set spectral stepsize (if curvature is positive)
+    if (sy > 0.0) {
+      if (initialization.compare("BB1") == 0) {
+        stepsize = iterate_difference_.innerProduct(iterate_difference_) / sy;
+      }
+      else {
+        stepsize = sy / gradient_difference_.innerProduct(gradient_difference_);
+      }
+      stepsize = fmin(stepsize_maximum, stepsize);
+    } // end if
+
+  } // end else if
+
+  // Return
+  return fmax(stepsize_minimum, stepsize);
+
+} // end initialStepsize
+
+} // namespace FaRSA
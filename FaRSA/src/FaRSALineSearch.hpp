@@ -16,6 +16,7 @@
 #include "FaRSAReporter.hpp"
 #include "FaRSAStrategies.hpp"
 #include "FaRSAStrategy.hpp"
+#include "FaRSAVector.hpp"
 
 namespace FaRSA
 {
@@ -130,6 +131,30 @@ public:
                              Strategies* strategies) = 0;
   //@}
 
+protected:
+  /** @name Stepsize initialization method */
+  //@{
+  /**
+   * Compute initial stepsize for line search (strategies described with option
+   * LSB_stepsize_initialization; iterate and gradient differences are computed in work
+   * vectors that persist over iterations)
+   * \param[in] quantities is pointer to Quantities object from FaRSA
+   * \param[in] initialization is stepsize initialization strategy ('constant', 'previous',
+   *            'BB1', or 'BB2')
+   * \param[in] stepsize_initial is initial stepsize (used in first iteration and as fallback)
+   * \param[in] stepsize_increase_factor is factor for increasing previous stepsize
+   * \param[in] stepsize_minimum is minimum stepsize
+   * \param[in] stepsize_maximum is maximum spectral stepsize
+   * \return initial stepsize
+   */
+  double initialStepsize(Quantities* quantities,
+                         const std::string& initialization,
+                         double stepsize_initial,
+                         double stepsize_increase_factor,
+                         double stepsize_minimum,
+                         double stepsize_maximum);
+  //@}
+
 private:
   /** @name Default compiler generated methods
    * (Hidden to avoid implicit creation/calling.)
@@ -147,7 +172,9 @@ private:
 
   /** @name Private members */
   //@{
-  LS_Status status_; /**< Termination status */
+  LS_Status status_;           /**< Termination status */
+  Vector iterate_difference_;  /**< Work vector for iterate difference (spectral stepsizes)  */
+  Vector gradient_difference_; /**< Work vector for gradient difference (spectral stepsizes) */
   //@}
 
 }; // end LineSearch
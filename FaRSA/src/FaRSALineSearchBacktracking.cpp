@@ -24,6 +24,21 @@ void LineSearchBacktracking::addOptions(Options* options,
                          false,
                          "Indicator for whether to indicate failure on small stepsize.\n"
                          "Default     : false.");
+  options->addBoolOption(reporter,
+                         "LSB_use_lipschitz_estimate",
+                         false,
+                         "Indicator for whether to replace LSB_stepsize_initial by the\n"
+                         "              reciprocal of an estimate of the Lipschitz constant of the\n"
+                         "              gradient, computed by the problem during initialization (e.g.,\n"
+                         "              by power iteration over its data), if available.  This suits\n"
+                         "              gradient-type directions, e.g., ProximalGradient, on badly\n"
+                         "              scaled problems, for which a unit stepsize requires many\n"
+                         "              backtracks in early iterations.  Since the estimate also caps\n"
+                         "              stepsizes when LSB_stepsize_initialization is 'previous', it\n"
+                         "              may yield more iterations than a unit stepsize; with 'BB1' or\n"
+                         "              'BB2', it only sets the stepsize of the first iteration and of\n"
+                         "              iterations without positive curvature (s'y <= 0).\n"
+                         "Default     : false.");
 
   // Add double options
   options->addDoubleOption(reporter,
@@ -33,9 +48,25 @@ void LineSearchBacktracking::addOptions(Options* options,
                            FARSA_DOUBLE_INFINITY,
                            "Initial stepsize to be used in the first iteration.  Note that\n"
                            "              the initial stepsize used in the line search in subsequent\n"
-                           "              iterations is set the minimum of this value and a factor times\n"
-                           "              the stepsize accepted in the previous iteration.\n"
+                           "              iterations depends on LSB_stepsize_initialization.\n"
                            "Default     : 1.0.");
+  options->addDoubleOption(reporter,
+                           "LSB_stepsize_increase_factor",
+                           2.0,
+                           1.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Factor for increasing the stepsize accepted in the previous\n"
+                           "              iteration when LSB_stepsize_initialization is 'previous'.\n"
+                           "Default     : 2.0.");
+  options->addDoubleOption(reporter,
+                           "LSB_stepsize_maximum",
+                           1e+10,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Safeguard on the initial stepsize when LSB_stepsize_initialization\n"
+                           "              is 'BB1' or 'BB2'.  Spectral stepsizes are projected onto the\n"
+                           "              interval [LSB_stepsize_minimum, LSB_stepsize_maximum].\n"
+                           "Default     : 1e+10.");
   options->addDoubleOption(reporter,
                            "LSB_stepsize_minimum",
                            1e-20,
@@ -67,6 +98,23 @@ void LineSearchBacktracking::addOptions(Options* options,
                            "Factor for updating the stepsize during the line search.\n"
                            "Default     : 5e-01.");
 
+  // Add string options
+  options->addStringOption(reporter,
+                           "LSB_stepsize_initialization",
+                           "previous",
+                           "Initial stepsize strategy for iterations after the first (shared\n"
+                           "              with LSN_stepsize_initialization).\n"
+                           "              'constant' uses LSB_stepsize_initial in every iteration.\n"
+                           "              'previous' uses the minimum of LSB_stepsize_initial and\n"
+                           "                LSB_stepsize_increase_factor times the stepsize accepted in\n"
+                           "                the previous iteration.\n"
+                           "              'BB1' uses the (long) Barzilai-Borwein stepsize s's/s'y and\n"
+                           "              'BB2' uses the (short) Barzilai-Borwein stepsize s'y/y'y,\n"
+                           "                where s and y are the differences between the current and\n"
+                           "                previous iterates and gradients, respectively.  If s'y is\n"
+                           "                not positive, then LSB_stepsize_initial is used.\n"
+                           "Default     : previous.");
+
 } // end addOptions
 
 // Set options
@@ -76,14 +124,20 @@ void LineSearchBacktracking::getOptions(const Options* options,
 
   // Read bool options
   options->valueAsBool(reporter, "LSB_fail_on_small_stepsize", fail_on_small_stepsize_);
+  options->valueAsBool(reporter, "LSB_use_lipschitz_estimate", use_lipschitz_estimate_);
 
   // Read options
   options->valueAsDouble(reporter, "LSB_stepsize_initial", stepsize_initial_);
+  options->valueAsDouble(reporter, "LSB_stepsize_increase_factor", stepsize_increase_factor_);
+  options->valueAsDouble(reporter, "LSB_stepsize_maximum", stepsize_maximum_);
   options->valueAsDouble(reporter, "LSB_stepsize_minimum", stepsize_minimum_);
   options->valueAsDouble(reporter, "LSB_stepsize_sufficient_decrease_threshold", stepsize_sufficient_decrease_threshold_);
   options->valueAsDouble(reporter, "LSB_stepsize_sufficient_decrease_fudge_factor", stepsize_sufficient_decrease_fudge_factor_);
   options->valueAsDouble(reporter, "LSB_stepsize_decrease_factor", stepsize_decrease_factor_);
 
+  // Read string options
+  options->valueAsString(reporter, "LSB_stepsize_initialization", stepsize_initialization_);
+
 } // end getOptions
 
 // Initialize
@@ -91,8 +145,16 @@ void LineSearchBacktracking::initialize(const Options* options,
                                         Quantities* quantities,
                                         const Reporter* reporter)
 {
+
+  // Set initial stepsize as reciprocal of Lipschitz constant estimate (if available)
+  if (use_lipschitz_estimate_ && quantities->lipschitzEstimate() > 0.0) {
+    stepsize_initial_ = 1.0 / quantities->lipschitzEstimate();
+  }
+
+  // Initialize stepsize
   quantities->setStepsize(fmax(stepsize_minimum_, stepsize_initial_));
-}
+
+} // end initialize
 
 // Run line search
 void LineSearchBacktracking::runLineSearch(const Options* options,
@@ -104,30 +166,35 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
   // Initialize values
   setStatus(LS_UNSET);
   quantities->setTrialIterateToCurrentIterate();
+  std::shared_ptr<Point> direction_point = quantities->directionPoint();
+  quantities->setDirectionPoint(nullptr);
 
-  // try line search, terminate on any exception
-  try {
-
-    // Evaluate objective at current point
-    bool evaluation_success = quantities->currentIterate()->evaluateObjective(*quantities);
+  // Evaluate objective at current point
+  bool evaluation_success = quantities->currentIterate()->evaluateObjective(*quantities);
 
-    // Check for successful evaluation
-    if (!evaluation_success) {
-      quantities->setStepsize(0.0);
-      THROW_EXCEPTION(LS_EVALUATION_FAILURE_EXCEPTION, "Line search unsuccessful. Evaluation failed.");
-    }
+  // Check for successful evaluation
+  if (!evaluation_success) {
+    quantities->setStepsize(0.0);
+    setStatus(LS_EVALUATION_FAILURE);
+  }
+  else {
 
-    // Initialize stepsize
-    quantities->setStepsize(fmax(stepsize_minimum_, stepsize_initial_));
+    // Initialize stepsize (unit stepsize if requested by direction computation)
+    quantities->setStepsize(strategies->directionComputation()->unitStepsize() ? 1.0 : initialStepsize(quantities, stepsize_initialization_, stepsize_initial_, stepsize_increase_factor_, stepsize_minimum_, stepsize_maximum_));
 
     // Compute directional derivative
     double directional_derivative = quantities->currentIterate()->gradient()->innerProduct(*quantities->direction());
 
-    // Loop
-    while (true) {
+    // Loop (until status is set)
+    while (status() == LS_UNSET) {
 
-      // Declare new point
-      quantities->setTrialIterate(quantities->currentIterate()->makeNewLinearCombination(1.0, quantities->stepsize(), *quantities->direction()));
+      // Declare new point (direction point for unit stepsize, if computed)
+      if (direction_point && quantities->stepsize() == 1.0) {
+        quantities->setTrialIterate(direction_point);
+      }
+      else {
+        quantities->setTrialIterate(quantities->currentIterate()->makeNewLinearCombination(1.0, quantities->stepsize(), *quantities->direction()));
+      }
 
       // Evaluate trial objective
       evaluation_success = quantities->trialIterate()->evaluateObjective(*quantities);
@@ -136,7 +203,7 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
       if (evaluation_success) {
 
         // Check for sufficient decrease
-        bool sufficient_decrease = (quantities->trialIterate()->objective() - quantities->currentIterate()->objective() <= -stepsize_sufficient_decrease_threshold_ * quantities->stepsize() * directional_derivative);
+        bool sufficient_decrease = (quantities->trialIterate()->objective() - quantities->currentIterate()->objective() <= stepsize_sufficient_decrease_threshold_ * quantities->stepsize() * directional_derivative);
 
         // Check Armijo condition
         if (sufficient_decrease) {
@@ -146,7 +213,8 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
 
           // Check for gradient evaluation success
           if (evaluation_success) {
-            THROW_EXCEPTION(LS_SUCCESS_EXCEPTION, "Line search successful.");
+            setStatus(LS_SUCCESS);
+            break;
           }
 
         } // end if
@@ -158,7 +226,8 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
 
         // Check for failure on small stepsize
         if (fail_on_small_stepsize_) {
-          THROW_EXCEPTION(LS_STEPSIZE_TOO_SMALL_EXCEPTION, "Line search unsuccessful.  Stepsize too small.");
+          setStatus(LS_STEPSIZE_TOO_SMALL);
+          break;
         }
 
         // Evaluate objective at trial iterate
@@ -175,7 +244,8 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
 
             // Check for successful evaluation
             if (evaluation_success) {
-              THROW_EXCEPTION(LS_SUCCESS_EXCEPTION, "Line search successful.");
+              setStatus(LS_SUCCESS);
+              break;
             }
 
           } // end if
@@ -189,7 +259,8 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
         quantities->setTrialIterateToCurrentIterate();
 
         // Terminate
-        THROW_EXCEPTION(LS_SUCCESS_EXCEPTION, "Line search successful.");
+        setStatus(LS_SUCCESS);
+        break;
 
       } // end if
 
@@ -198,19 +269,13 @@ void LineSearchBacktracking::runLineSearch(const Options* options,
 
     } // end while
 
-  } // end try
-
-  // catch exceptions
-  catch (LS_SUCCESS_EXCEPTION& exec) {
-    setStatus(LS_SUCCESS);
-  } catch (LS_EVALUATION_FAILURE_EXCEPTION& exec) {
-    setStatus(LS_EVALUATION_FAILURE);
-  } catch (LS_STEPSIZE_TOO_SMALL_EXCEPTION& exec) {
-    setStatus(LS_STEPSIZE_TOO_SMALL);
-  } // end catch
+  } // end else
 
   // Print iteration information
-  reporter->printf(R_SOLVER, R_PER_ITERATION, " %+.2e", quantities->stepsize());
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %+.2e", quantities->stepsize());
+
+  // Record event
+  FARSA_EVENT(reporter, E_STEPSIZE, quantities->stepsize());
 
 } // end runLineSearch
 
@@ -117,11 +117,15 @@ private:
   /** @name Private members */
   //@{
   bool fail_on_small_stepsize_;
+  bool use_lipschitz_estimate_;
   double stepsize_initial_;
+  double stepsize_increase_factor_;
+  double stepsize_maximum_;
   double stepsize_minimum_;
   double stepsize_sufficient_decrease_threshold_;
   double stepsize_sufficient_decrease_fudge_factor_;
   double stepsize_decrease_factor_;
+  std::string stepsize_initialization_;
   //@}
 
 }; // end LineSearchBacktracking
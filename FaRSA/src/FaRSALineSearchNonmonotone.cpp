@@ -0,0 +1,342 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <cmath>
+
+#include "FaRSABinaryIO.hpp"
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSALineSearchNonmonotone.hpp"
+
+namespace FaRSA
+{
+
+// Add options
+void LineSearchNonmonotone::addOptions(Options* options,
+                                       const Reporter* reporter)
+{
+
+  // Add bool options
+  options->addBoolOption(reporter,
+                         "LSN_fail_on_small_stepsize",
+                         false,
+                         "Indicator for whether to indicate failure on small stepsize.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "LSN_use_lipschitz_estimate",
+                         false,
+                         "Indicator for whether to replace LSN_stepsize_initial by the\n"
+                         "              reciprocal of an estimate of the Lipschitz constant of the\n"
+                         "              gradient, computed by the problem during initialization, if\n"
+                         "              available (see LSB_use_lipschitz_estimate).\n"
+                         "Default     : false.");
+
+  // Add double options
+  options->addDoubleOption(reporter,
+                           "LSN_stepsize_initial",
+                           1.0,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Initial stepsize to be used in the first iteration.  Note that\n"
+                           "              the initial stepsize used in the line search in subsequent\n"
+                           "              iterations depends on LSN_stepsize_initialization.\n"
+                           "Default     : 1.0.");
+  options->addDoubleOption(reporter,
+                           "LSN_stepsize_increase_factor",
+                           2.0,
+                           1.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Factor for increasing the stepsize accepted in the previous\n"
+                           "              iteration when LSN_stepsize_initialization is 'previous'.\n"
+                           "Default     : 2.0.");
+  options->addDoubleOption(reporter,
+                           "LSN_stepsize_maximum",
+                           1e+10,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Safeguard on the initial stepsize when LSN_stepsize_initialization\n"
+                           "              is 'BB1' or 'BB2'.  Spectral stepsizes are projected onto the\n"
+                           "              interval [LSN_stepsize_minimum, LSN_stepsize_maximum].\n"
+                           "Default     : 1e+10.");
+  options->addDoubleOption(reporter,
+                           "LSN_stepsize_minimum",
+                           1e-20,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Tolerance for determining an insufficient stepsize.  If the\n"
+                           "              line search yields a stepsize below this tolerance, then the\n"
+                           "              algorithm may terminate with a message of a small stepsize.\n"
+                           "Default     : 1e-20.");
+  options->addDoubleOption(reporter,
+                           "LSN_stepsize_sufficient_decrease_threshold",
+                           1e-04,
+                           0.0,
+                           1.0,
+                           "Sufficient decrease constant for the nonmonotone line search.\n"
+                           "              A trial stepsize is accepted if the objective at the trial\n"
+                           "              point is at most the maximum objective over the last\n"
+                           "              LSN_memory_length iterations plus this constant times the\n"
+                           "              stepsize times the directional derivative.\n"
+                           "Default     : 1e-04.");
+  options->addDoubleOption(reporter,
+                           "LSN_stepsize_decrease_factor",
+                           5e-01,
+                           0.0,
+                           1.0,
+                           "Factor for updating the stepsize during the line search.\n"
+                           "Default     : 5e-01.");
+
+  // Add integer options
+  options->addIntegerOption(reporter,
+                            "LSN_memory_length",
+                            10,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Number of recent objective values over which the maximum is taken\n"
+                            "              for the reference value in the sufficient decrease condition.\n"
+                            "              A value of 1 yields a monotone line search.\n"
+                            "Default     : 10.");
+
+  // Add string options
+  options->addStringOption(reporter,
+                           "LSN_stepsize_initialization",
+                           "BB1",
+                           "Initial stepsize strategy for iterations after the first.  The\n"
+                           "              strategies ('constant', 'previous', 'BB1', and 'BB2') are those\n"
+                           "              of LSB_stepsize_initialization, with the corresponding LSN\n"
+                           "              options in place of the LSB options.\n"
+                           "Default     : BB1.");
+
+} // end addOptions
+
+// Set options
+void LineSearchNonmonotone::getOptions(const Options* options,
+                                       const Reporter* reporter)
+{
+
+  // Read bool options
+  options->valueAsBool(reporter, "LSN_fail_on_small_stepsize", fail_on_small_stepsize_);
+  options->valueAsBool(reporter, "LSN_use_lipschitz_estimate", use_lipschitz_estimate_);
+
+  // Read double options
+  options->valueAsDouble(reporter, "LSN_stepsize_initial", stepsize_initial_);
+  options->valueAsDouble(reporter, "LSN_stepsize_increase_factor", stepsize_increase_factor_);
+  options->valueAsDouble(reporter, "LSN_stepsize_maximum", stepsize_maximum_);
+  options->valueAsDouble(reporter, "LSN_stepsize_minimum", stepsize_minimum_);
+  options->valueAsDouble(reporter, "LSN_stepsize_sufficient_decrease_threshold", stepsize_sufficient_decrease_threshold_);
+  options->valueAsDouble(reporter, "LSN_stepsize_decrease_factor", stepsize_decrease_factor_);
+
+  // Read integer options
+  options->valueAsInteger(reporter, "LSN_memory_length", memory_length_);
+
+  // Read string options
+  options->valueAsString(reporter, "LSN_stepsize_initialization", stepsize_initialization_);
+
+} // end getOptions
+
+// Initialize
+void LineSearchNonmonotone::initialize(const Options* options,
+                                       Quantities* quantities,
+                                       const Reporter* reporter)
+{
+
+  // Set initial stepsize as reciprocal of Lipschitz constant estimate (if available)
+  if (use_lipschitz_estimate_ && quantities->lipschitzEstimate() > 0.0) {
+    stepsize_initial_ = 1.0 / quantities->lipschitzEstimate();
+  }
+
+  // Initialize stepsize
+  quantities->setStepsize(fmax(stepsize_minimum_, stepsize_initial_));
+
+  // Initialize objective history
+  objective_history_.assign(memory_length_, -FARSA_DOUBLE_INFINITY);
+  history_index_ = 0;
+  history_count_ = 0;
+
+} // end initialize
+
+// Run line search
+void LineSearchNonmonotone::runLineSearch(const Options* options,
+                                          Quantities* quantities,
+                                          const Reporter* reporter,
+                                          Strategies* strategies)
+{
+
+  // Initialize values
+  setStatus(LS_UNSET);
+  quantities->setTrialIterateToCurrentIterate();
+  std::shared_ptr<Point> direction_point = quantities->directionPoint();
+  quantities->setDirectionPoint(nullptr);
+
+  // Evaluate objective at current point
+  bool evaluation_success = quantities->currentIterate()->evaluateObjective(*quantities);
+
+  // Check for successful evaluation
+  if (!evaluation_success) {
+    quantities->setStepsize(0.0);
+    setStatus(LS_EVALUATION_FAILURE);
+  }
+  else {
+
+    // Add current objective to history and set reference value
+    pushObjective(quantities->currentIterate()->objective());
+    double reference_objective = referenceObjective();
+
+    // Initialize stepsize (unit stepsize if requested by direction computation)
+    quantities->setStepsize(strategies->directionComputation()->unitStepsize() ? 1.0 : initialStepsize(quantities, stepsize_initialization_, stepsize_initial_, stepsize_increase_factor_, stepsize_minimum_, stepsize_maximum_));
+
+    // Compute directional derivative
+    double directional_derivative = quantities->currentIterate()->gradient()->innerProduct(*quantities->direction());
+
+    // Loop (until status is set)
+    while (status() == LS_UNSET) {
+
+      // Declare new point (direction point for unit stepsize, if computed)
+      if (direction_point && quantities->stepsize() == 1.0) {
+        quantities->setTrialIterate(direction_point);
+      }
+      else {
+        quantities->setTrialIterate(quantities->currentIterate()->makeNewLinearCombination(1.0, quantities->stepsize(), *quantities->direction()));
+      }
+
+      // Evaluate trial objective
+      evaluation_success = quantities->trialIterate()->evaluateObjective(*quantities);
+
+      // Check for successful evaluation
+      if (evaluation_success) {
+
+        // Check for sufficient decrease with respect to reference value
+        bool sufficient_decrease = (quantities->trialIterate()->objective() <= reference_objective + stepsize_sufficient_decrease_threshold_ * quantities->stepsize() * directional_derivative);
+
+        // Check nonmonotone Armijo condition
+        if (sufficient_decrease) {
+
+          // Evalutate trial gradient
+          evaluation_success = quantities->trialIterate()->evaluateGradient(*quantities);
+
+          // Check for gradient evaluation success
+          if (evaluation_success) {
+            setStatus(LS_SUCCESS);
+            break;
+          }
+
+        } // end if
+
+      } // end if
+
+      // Check if stepsize below minimum
+      if (quantities->stepsize() <= stepsize_minimum_) {
+
+        // Check for failure on small stepsize
+        if (fail_on_small_stepsize_) {
+          setStatus(LS_STEPSIZE_TOO_SMALL);
+          break;
+        }
+
+        // Check for evaluation success
+        if (evaluation_success) {
+
+          // Check for decrease
+          if (quantities->trialIterate()->objective() < quantities->currentIterate()->objective()) {
+
+            // Evaluate gradient at trial iterate
+            evaluation_success = quantities->trialIterate()->evaluateGradient(*quantities);
+
+            // Check for successful evaluation
+            if (evaluation_success) {
+              setStatus(LS_SUCCESS);
+              break;
+            }
+
+          } // end if
+
+        } // end if
+
+        // Set null step
+        quantities->setStepsize(0.0);
+
+        // Set new point
+        quantities->setTrialIterateToCurrentIterate();
+
+        // Terminate
+        setStatus(LS_SUCCESS);
+        break;
+
+      } // end if
+
+      // Update stepsize
+      quantities->setStepsize(fmax(stepsize_minimum_, stepsize_decrease_factor_ * quantities->stepsize()));
+
+    } // end while
+
+  } // end else
+
+  // Print iteration information
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %+.2e", quantities->stepsize());
+
+  // Record event
+  FARSA_EVENT(reporter, E_STEPSIZE, quantities->stepsize());
+
+} // end runLineSearch
+
+// Add objective value to history
+void LineSearchNonmonotone::pushObjective(double objective)
+{
+
+  // Overwrite oldest value
+  objective_history_[history_index_] = objective;
+  history_index_ = (history_index_ + 1) % (int)objective_history_.size();
+  if (history_count_ < (int)objective_history_.size()) {
+    history_count_++;
+  }
+
+} // end pushObjective
+
+// Reference objective value
+double LineSearchNonmonotone::referenceObjective() const
+{
+
+  // Compute maximum over stored values
+  double reference = -FARSA_DOUBLE_INFINITY;
+  for (int i = 0; i < history_count_; i++) {
+    reference = fmax(reference, objective_history_[i]);
+  }
+
+  // Return
+  return reference;
+
+} // end referenceObjective
+
+// Read state
+bool LineSearchNonmonotone::readState(FILE* file)
+{
+
+  // Read objective history
+  if (!readBinary(file, objective_history_) ||
+      !readBinary(file, history_index_) ||
+      !readBinary(file, history_count_)) {
+    return false;
+  }
+
+  // Check consistency with memory length
+  return ((int)objective_history_.size() == memory_length_ &&
+          history_index_ >= 0 && history_index_ < memory_length_ &&
+          history_count_ >= 0 && history_count_ <= memory_length_);
+
+} // end readState
+
+// Write state
+bool LineSearchNonmonotone::writeState(FILE* file) const
+{
+
+  // Write objective history
+  return (writeBinary(file, objective_history_) &&
+          writeBinary(file, history_index_) &&
+          writeBinary(file, history_count_));
+
+} // end writeState
+
+} // namespace FaRSA
@@ -0,0 +1,180 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSALINESEARCHNONMONOTONE_HPP__
+#define __FARSALINESEARCHNONMONOTONE_HPP__
+
+#include <vector>
+
+#include "FaRSALineSearch.hpp"
+
+namespace FaRSA
+{
+
+/**
+ * LineSearchNonmonotone class
+ *
+ * Backtracking line search in which sufficient decrease is measured with respect
+ * to the maximum objective value over the most recent iterations (Grippo,
+ * Lampariello, and Lucidi, 1986), so that aggressive steps are accepted more often
+ */
+class LineSearchNonmonotone : public LineSearch
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+   * Constructor
+   */
+  LineSearchNonmonotone()
+    : history_index_(0),
+      history_count_(0){};
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+   * Destructor
+   */
+  ~LineSearchNonmonotone(){};
+
+  /** @name Options handling methods */
+  //@{
+  /**
+   * Add options
+   * \param[in,out] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void addOptions(Options* options,
+                  const Reporter* reporter);
+  /**
+   * Set options
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void getOptions(const Options* options,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Initialization method */
+  //@{
+  /**
+   * Initialize strategy
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   */
+  void initialize(const Options* options,
+                  Quantities* quantities,
+                  const Reporter* reporter);
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+   * Get iteration header values
+   * \return string of header values
+   */
+  std::string iterationHeader() { return " Stepsize"; };
+  /**
+   * Get iteration null values string
+   * \return string of null values
+   */
+  std::string iterationNullValues() { return "---------"; };
+  /**
+   * Get name of strategy
+   * \return string with name of strategy
+   */
+  std::string name() { return "Nonmonotone"; };
+  //@}
+
+  /** @name Line search method */
+  //@{
+  /**
+   * Run line search
+   * \param[in] options is pointer to Options object from FaRSA
+   * \param[in,out] quantities is pointer to Quantities object from FaRSA
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   * \param[in,out] strategies is pointer to Strategies object from FaRSA
+   */
+  void runLineSearch(const Options* options,
+                     Quantities* quantities,
+                     const Reporter* reporter,
+                     Strategies* strategies);
+  //@}
+
+  /** @name Checkpoint methods */
+  //@{
+  /**
+   * Read strategy state from open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool readState(FILE* file);
+  /**
+   * Write strategy state (objective history) to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeState(FILE* file) const;
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+   * (Hidden to avoid implicit creation/calling.)
+   */
+  //@{
+  /**
+   * Copy constructor
+   */
+  LineSearchNonmonotone(const LineSearchNonmonotone&);
+  /**
+   * Overloaded equals operator
+   */
+  void operator=(const LineSearchNonmonotone&);
+  //@}
+
+  /** @name Private members */
+  //@{
+  bool fail_on_small_stepsize_;
+  bool use_lipschitz_estimate_;
+  double stepsize_initial_;
+  double stepsize_increase_factor_;
+  double stepsize_maximum_;
+  double stepsize_minimum_;
+  double stepsize_sufficient_decrease_threshold_;
+  double stepsize_decrease_factor_;
+  int memory_length_;
+  std::string stepsize_initialization_;
+  //@}
+
+  /** @name Private members, objective history */
+  //@{
+  std::vector<double> objective_history_; /**< Ring buffer of recent objective values */
+  int history_index_;                     /**< Position of next value in ring buffer  */
+  int history_count_;                     /**< Number of values in ring buffer        */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Add objective value to history
+   * \param[in] objective is objective value to add
+   */
+  void pushObjective(double objective);
+  /**
+   * Reference objective value
+   * \return maximum objective value in history
+   */
+  double referenceObjective() const;
+  //@}
+
+}; // end LineSearchNonmonotone
+
+} // namespace FaRSA
+
+#endif /* __FARSALINESEARCHNONMONOTONE_HPP__ */
@@ -4,12 +4,26 @@
 //
 // Author(s) : Frank E. Curtis, Daniel P. Robinson
 
+#include <algorithm>
+#include <cmath>
+#include <ctype.h>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "FaRSABLASLAPACK.hpp"
 #include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSAFileCache.hpp"
 #include "FaRSAMatrix.hpp"
+#include "FaRSATextParser.hpp"
 
 namespace FaRSA
 {
@@ -18,11 +32,25 @@ namespace FaRSA
 Matrix::~Matrix()
 {
 
+  // Unmap binary file (arrays point into mapping)
+  if (mapped_data_ != nullptr) {
+    munmap(mapped_data_, mapped_length_);
+    mapped_data_ = nullptr;
+    column_indices_ = nullptr;
+    row_starts_ = nullptr;
+    values_ = nullptr;
+    values_float_ = nullptr;
+  } // end if
+
   // Delete arrays
   if (column_indices_ != nullptr) {
     delete[] column_indices_;
     column_indices_ = nullptr;
   } // end if
+  if (column_starts_ != nullptr) {
+    delete[] column_starts_;
+    column_starts_ = nullptr;
+  } // end if
   if (row_indices_ != nullptr) {
     delete[] row_indices_;
     row_indices_ = nullptr;
@@ -31,6 +59,14 @@ Matrix::~Matrix()
     delete[] values_;
     values_ = nullptr;
   } // end if
+  if (values_float_ != nullptr) {
+    delete[] values_float_;
+    values_float_ = nullptr;
+  } // end if
+  if (row_starts_ != nullptr) {
+    delete[] row_starts_;
+    row_starts_ = nullptr;
+  } // end if
 
 } // end destructor
 
@@ -46,23 +82,67 @@ void Matrix::matrixVectorProduct(const Vector& vector,
   // Zero-out product
   product.scale(0.0);
 
+  // Compute matrix-vector product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    matrixVectorProductKernel(PatternValues(), vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    matrixVectorProductKernel(values_float_, vector, product);
+  }
+  else {
+    matrixVectorProductKernel(values_, vector, product);
+  }
+
+} // end matrixVectorProduct
+
+// Matrix-vector product kernel
+template <typename V>
+void Matrix::matrixVectorProductKernel(V values,
+                                       const Vector& vector,
+                                       Vector& product)
+{
+
   // Compute matrix-vector product, routine depending on sparse format
   if (sparse_format_ == M_COORDINATE_LIST) {
-    for (int i = 0; i < number_of_nonzeros_; i++) {
-      product.valuesModifiable()[row_indices_[i]] += values_[i] * vector.values()[column_indices_[i]];
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      product.valuesModifiable()[row_indices_[i]] += (double)values[i] * vector.values()[column_indices_[i]];
     }
   }
   else if (sparse_format_ == M_COMPRESSED_SPARSE_ROW) {
-    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Compressed sparse row not implemented yet!");
+    for (int row_begin = 0, row_end; row_begin < number_of_rows_; row_begin = row_end) {
+      row_end = streamBlockEnd(row_begin);
+      adviseRows(row_end, streamBlockEnd(row_end), MADV_WILLNEED);
+      double* product_values = product.valuesModifiable();
+      forRange(row_begin, row_end, row_starts_[row_end] - row_starts_[row_begin], [&](long long r_begin, long long r_end) {
+        for (long long r = r_begin; r < r_end; r++) {
+          double inner_product = 0.0;
+          for (long long i = row_starts_[r]; i < row_starts_[r + 1]; i++) {
+            inner_product += (double)values[i] * vector.values()[column_indices_[i]];
+          }
+          product_values[r] = inner_product;
+        } // end for
+      });
+      adviseRows(row_begin, row_end, MADV_DONTNEED);
+    } // end for
   } // end if
   else if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
-    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Compressed sparse column not implemented yet!");
+    const int* permutation = isBlockedByGroups() ? column_permutation_.data() : nullptr;
+    scatterColumns(number_of_columns_, number_of_nonzeros_, true, product, [&](long long j_begin, long long j_end, double* product_values) {
+      for (long long j = j_begin; j < j_end; j++) {
+        double vector_value = vector.values()[(permutation == nullptr) ? j : permutation[j]];
+        if (vector_value != 0.0) {
+          for (long long i = column_starts_[j]; i < column_starts_[j + 1]; i++) {
+            product_values[row_indices_[i]] += (double)values[i] * vector_value;
+          }
+        } // end if
+      }   // end for
+    });
   }
   else {
     THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Sparse format type error.");
   }
 
-} // end matrixVectorProduct
+} // end matrixVectorProductKernel
 
 // Matrix-transpose-vector product
 void Matrix::matrixTransposeVectorProduct(const Vector& vector,
@@ -76,96 +156,1809 @@ void Matrix::matrixTransposeVectorProduct(const Vector& vector,
   // Zero-out product
   product.scale(0.0);
 
+  // Compute matrix-transpose-vector product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    matrixTransposeVectorProductKernel(PatternValues(), vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    matrixTransposeVectorProductKernel(values_float_, vector, product);
+  }
+  else {
+    matrixTransposeVectorProductKernel(values_, vector, product);
+  }
+
+} // end matrixTransposeVectorProduct
+
+// Matrix-transpose-vector product kernel
+template <typename V>
+void Matrix::matrixTransposeVectorProductKernel(V values,
+                                                const Vector& vector,
+                                                Vector& product)
+{
+
   // Compute matrix-vector product, routine depending on sparse format
   if (sparse_format_ == M_COORDINATE_LIST) {
-    for (int i = 0; i < number_of_nonzeros_; i++) {
-      product.valuesModifiable()[column_indices_[i]] += values_[i] * vector.values()[row_indices_[i]];
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      product.valuesModifiable()[column_indices_[i]] += (double)values[i] * vector.values()[row_indices_[i]];
     }
   }
   else if (sparse_format_ == M_COMPRESSED_SPARSE_ROW) {
-    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Compressed sparse row not implemented yet!");
+    for (int row_begin = 0, row_end; row_begin < number_of_rows_; row_begin = row_end) {
+      row_end = streamBlockEnd(row_begin);
+      adviseRows(row_end, streamBlockEnd(row_end), MADV_WILLNEED);
+      for (int r = row_begin; r < row_end; r++) {
+        double vector_value = vector.values()[r];
+        if (vector_value != 0.0) {
+          for (long long i = row_starts_[r]; i < row_starts_[r + 1]; i++) {
+            product.valuesModifiable()[column_indices_[i]] += (double)values[i] * vector_value;
+          }
+        } // end if
+      }   // end for
+      adviseRows(row_begin, row_end, MADV_DONTNEED);
+    } // end for
   } // end if
   else if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
-    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Compressed sparse column not implemented yet!");
+    const int* permutation = isBlockedByGroups() ? column_permutation_.data() : nullptr;
+    double* product_values = product.valuesModifiable();
+    forColumns([&](long long j_begin, long long j_end) {
+      for (long long j = j_begin; j < j_end; j++) {
+        double inner_product = 0.0;
+        for (long long i = column_starts_[j]; i < column_starts_[j + 1]; i++) {
+          inner_product += (double)values[i] * vector.values()[row_indices_[i]];
+        }
+        product_values[(permutation == nullptr) ? j : permutation[j]] = inner_product;
+      } // end for
+    });
   }
   else {
     THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Sparse format type error.");
   }
 
-} // end matrixVectorProduct
+} // end matrixTransposeVectorProductKernel
+
+// Column-view-vector product
+void Matrix::matrixVectorProductColumns(const std::vector<int>& columns,
+                                        const Vector& vector,
+                                        Vector& product)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(sparse_format_ == M_COMPRESSED_SPARSE_COLUMN, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Column views require compressed sparse column format.");
+  ASSERT_EXCEPTION((int)columns.size() == vector.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Vector has incorrect length.");
+  ASSERT_EXCEPTION(number_of_rows_ == product.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Product has incorrect length.");
+
+  // Zero-out product
+  product.scale(0.0);
+
+  // Set stored positions of columns (differ from columns if blocked by groups)
+  std::vector<int> positions;
+  if (isBlockedByGroups()) {
+    positions = columnPositions(columns);
+  }
+  const std::vector<int>& stored_columns = isBlockedByGroups() ? positions : columns;
+
+  // Compute product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    matrixVectorProductColumnsKernel(PatternValues(), stored_columns, vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    matrixVectorProductColumnsKernel(values_float_, stored_columns, vector, product);
+  }
+  else {
+    matrixVectorProductColumnsKernel(values_, stored_columns, vector, product);
+  }
+
+} // end matrixVectorProductColumns
+
+// Column-view-vector product kernel
+template <typename V>
+void Matrix::matrixVectorProductColumnsKernel(V values,
+                                              const std::vector<int>& columns,
+                                              const Vector& vector,
+                                              Vector& product)
+{
+
+  // Compute product, only touching given columns
+  scatterColumns((long long)columns.size(), columnsNonzeros(columns), false, product, [&](long long k_begin, long long k_end, double* product_values) {
+    for (long long k = k_begin; k < k_end; k++) {
+      double vector_value = vector.values()[k];
+      if (vector_value != 0.0) {
+        for (long long i = column_starts_[columns[k]]; i < column_starts_[columns[k] + 1]; i++) {
+          product_values[row_indices_[i]] += (double)values[i] * vector_value;
+        }
+      } // end if
+    }   // end for
+  });
+
+} // end matrixVectorProductColumnsKernel
+
+// Column-view-transpose-vector product
+void Matrix::matrixTransposeVectorProductColumns(const std::vector<int>& columns,
+                                                 const Vector& vector,
+                                                 Vector& product)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(sparse_format_ == M_COMPRESSED_SPARSE_COLUMN, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Column views require compressed sparse column format.");
+  ASSERT_EXCEPTION(number_of_rows_ == vector.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Vector has incorrect length.");
+  ASSERT_EXCEPTION((int)columns.size() == product.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Product has incorrect length.");
+
+  // Set stored positions of columns (differ from columns if blocked by groups)
+  std::vector<int> positions;
+  if (isBlockedByGroups()) {
+    positions = columnPositions(columns);
+  }
+  const std::vector<int>& stored_columns = isBlockedByGroups() ? positions : columns;
+
+  // Compute product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    matrixTransposeVectorProductColumnsKernel(PatternValues(), stored_columns, vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    matrixTransposeVectorProductColumnsKernel(values_float_, stored_columns, vector, product);
+  }
+  else {
+    matrixTransposeVectorProductColumnsKernel(values_, stored_columns, vector, product);
+  }
+
+} // end matrixTransposeVectorProductColumns
+
+// Column-view-transpose-vector product kernel
+template <typename V>
+void Matrix::matrixTransposeVectorProductColumnsKernel(V values,
+                                                       const std::vector<int>& columns,
+                                                       const Vector& vector,
+                                                       Vector& product)
+{
+
+  // Compute product, only touching given columns
+  double* product_values = product.valuesModifiable();
+  forRange(0, (long long)columns.size(), columnsNonzeros(columns), [&](long long k_begin, long long k_end) {
+    for (long long k = k_begin; k < k_end; k++) {
+      double inner_product = 0.0;
+      for (long long i = column_starts_[columns[k]]; i < column_starts_[columns[k] + 1]; i++) {
+        inner_product += (double)values[i] * vector.values()[row_indices_[i]];
+      }
+      product_values[k] = inner_product;
+    } // end for
+  });
+
+} // end matrixTransposeVectorProductColumnsKernel
+
+// Product of elementwise-squared column view transpose with vector
+void Matrix::squaredMatrixTransposeVectorProductColumns(const std::vector<int>& columns,
+                                                        const Vector& vector,
+                                                        Vector& product)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(sparse_format_ == M_COMPRESSED_SPARSE_COLUMN, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Column views require compressed sparse column format.");
+  ASSERT_EXCEPTION(number_of_rows_ == vector.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Vector has incorrect length.");
+  ASSERT_EXCEPTION((int)columns.size() == product.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Product has incorrect length.");
+
+  // Set stored positions of columns (differ from columns if blocked by groups)
+  std::vector<int> positions;
+  if (isBlockedByGroups()) {
+    positions = columnPositions(columns);
+  }
+  const std::vector<int>& stored_columns = isBlockedByGroups() ? positions : columns;
+
+  // Compute product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    squaredMatrixTransposeVectorProductColumnsKernel(PatternValues(), stored_columns, vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    squaredMatrixTransposeVectorProductColumnsKernel(values_float_, stored_columns, vector, product);
+  }
+  else {
+    squaredMatrixTransposeVectorProductColumnsKernel(values_, stored_columns, vector, product);
+  }
+
+} // end squaredMatrixTransposeVectorProductColumns
+
+// Product of elementwise-squared column view transpose with vector kernel
+template <typename V>
+void Matrix::squaredMatrixTransposeVectorProductColumnsKernel(V values,
+                                                              const std::vector<int>& columns,
+                                                              const Vector& vector,
+                                                              Vector& product)
+{
+
+  // Compute product, only touching given columns
+  double* product_values = product.valuesModifiable();
+  forRange(0, (long long)columns.size(), columnsNonzeros(columns), [&](long long k_begin, long long k_end) {
+    for (long long k = k_begin; k < k_end; k++) {
+      double inner_product = 0.0;
+      for (long long i = column_starts_[columns[k]]; i < column_starts_[columns[k] + 1]; i++) {
+        double value = (double)values[i];
+        inner_product += value * value * vector.values()[row_indices_[i]];
+      }
+      product_values[k] = inner_product;
+    } // end for
+  });
+
+} // end squaredMatrixTransposeVectorProductColumnsKernel
+
+// Group-view-vector product
+void Matrix::matrixVectorProductGroups(const std::vector<int>& groups,
+                                       const Vector& vector,
+                                       Vector& product)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(isBlockedByGroups(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Group views require blocking by groups.");
+
+  // Set stored positions of columns of groups
+  std::vector<int> positions = groupColumnPositions(groups);
+
+  // Asserts
+  ASSERT_EXCEPTION((int)positions.size() == vector.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Vector has incorrect length.");
+  ASSERT_EXCEPTION(number_of_rows_ == product.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Product has incorrect length.");
+
+  // Zero-out product
+  product.scale(0.0);
+
+  // Compute product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    matrixVectorProductColumnsKernel(PatternValues(), positions, vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    matrixVectorProductColumnsKernel(values_float_, positions, vector, product);
+  }
+  else {
+    matrixVectorProductColumnsKernel(values_, positions, vector, product);
+  }
+
+} // end matrixVectorProductGroups
+
+// Group-view-transpose-vector product
+void Matrix::matrixTransposeVectorProductGroups(const std::vector<int>& groups,
+                                                const Vector& vector,
+                                                Vector& product)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(isBlockedByGroups(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Group views require blocking by groups.");
+
+  // Set stored positions of columns of groups
+  std::vector<int> positions = groupColumnPositions(groups);
+
+  // Asserts
+  ASSERT_EXCEPTION(number_of_rows_ == vector.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Vector has incorrect length.");
+  ASSERT_EXCEPTION((int)positions.size() == product.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Product has incorrect length.");
+
+  // Compute product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    matrixTransposeVectorProductColumnsKernel(PatternValues(), positions, vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    matrixTransposeVectorProductColumnsKernel(values_float_, positions, vector, product);
+  }
+  else {
+    matrixTransposeVectorProductColumnsKernel(values_, positions, vector, product);
+  }
+
+} // end matrixTransposeVectorProductGroups
+
+// Product of elementwise-squared group view transpose with vector
+void Matrix::squaredMatrixTransposeVectorProductGroups(const std::vector<int>& groups,
+                                                       const Vector& vector,
+                                                       Vector& product)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(isBlockedByGroups(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Group views require blocking by groups.");
+
+  // Set stored positions of columns of groups
+  std::vector<int> positions = groupColumnPositions(groups);
+
+  // Asserts
+  ASSERT_EXCEPTION(number_of_rows_ == vector.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Vector has incorrect length.");
+  ASSERT_EXCEPTION((int)positions.size() == product.length(), FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Product has incorrect length.");
+
+  // Compute product, kernel depending on value type
+  if (value_type_ == M_VALUE_PATTERN) {
+    squaredMatrixTransposeVectorProductColumnsKernel(PatternValues(), positions, vector, product);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    squaredMatrixTransposeVectorProductColumnsKernel(values_float_, positions, vector, product);
+  }
+  else {
+    squaredMatrixTransposeVectorProductColumnsKernel(values_, positions, vector, product);
+  }
+
+} // end squaredMatrixTransposeVectorProductGroups
+
+// Get column norms
+const std::vector<double>& Matrix::columnNorms()
+{
+
+  // Compute norms (if out-of-core, on first request)
+  if (!norms_computed_) {
+    computeNorms();
+  }
+
+  // Return
+  return column_norms_;
+
+} // end columnNorms
+
+// Get row norms
+const std::vector<double>& Matrix::rowNorms()
+{
+
+  // Compute norms (if out-of-core, on first request)
+  if (!norms_computed_) {
+    computeNorms();
+  }
+
+  // Return
+  return row_norms_;
+
+} // end rowNorms
+
+// Get spectral norm bound
+double Matrix::spectralNormBound(const std::vector<int>& columns)
+{
+
+  // Sum squared column norms (squared Frobenius norm of submatrix)
+  const std::vector<double>& column_norms = columnNorms();
+  double sum = 0.0;
+  for (int k = 0; k < (int)columns.size(); k++) {
+    sum += column_norms.at(columns[k]) * column_norms.at(columns[k]);
+  }
+
+  // Return
+  return sqrt(sum);
+
+} // end spectralNormBound
+
+// Estimate squared spectral norm
+bool Matrix::estimateSquaredSpectralNorm(const std::vector<int>& columns,
+                                         int number_of_iterations,
+                                         double tolerance,
+                                         const std::function<bool(double*, int)>& sum,
+                                         double& estimate)
+{
+
+  // Set length of iterate (number of columns, or of given columns)
+  bool all_columns = (columns.size() == 0);
+  int length = all_columns ? number_of_columns_ : (int)columns.size();
+
+  // Initialize iterate (pseudorandom with fixed seed, so estimates are reproducible and
+  // equal in all processes of a sharded matrix)
+  Vector iterate(length);
+  Vector product(number_of_rows_);
+  Vector gram_product(length);
+  iterate.setThreadPool(thread_pool_);
+  product.setThreadPool(thread_pool_);
+  gram_product.setThreadPool(thread_pool_);
+  std::mt19937 generator(FARSA_POWER_ITERATION_SEED);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  for (int j = 0; j < length; j++) {
+    iterate.valuesModifiable()[j] = distribution(generator);
+  }
+  if (iterate.norm2() > 0.0) {
+    iterate.scale(1.0 / iterate.norm2());
+  }
+
+  // Run power iteration
+  estimate = 0.0;
+  for (int k = 0; k < number_of_iterations; k++) {
+
+    // Compute Gram product X'X times iterate (summed over shards)
+    if (all_columns) {
+      matrixVectorProduct(iterate, product);
+      matrixTransposeVectorProduct(product, gram_product);
+    }
+    else {
+      matrixVectorProductColumns(columns, iterate, product);
+      matrixTransposeVectorProductColumns(columns, product, gram_product);
+    }
+    if (sum != nullptr && !sum(gram_product.valuesModifiable(), length)) {
+      return false;
+    }
+
+    // Set estimate (norm of Gram product of unit iterate, at most squared spectral norm)
+    double previous_estimate = estimate;
+    estimate = gram_product.norm2();
+
+    // Check for iterate in null space or for convergence
+    if (estimate == 0.0 || fabs(estimate - previous_estimate) <= tolerance * estimate) {
+      break;
+    }
+
+    // Set next iterate
+    iterate.copy(gram_product);
+    iterate.scale(1.0 / estimate);
+
+  } // end for
+
+  // Return
+  return true;
+
+} // end estimateSquaredSpectralNorm
 
 // Set from file
 void Matrix::setFromFile(char* file_name,
-                         SparseFormatType sparse_format)
+                         SparseFormatType sparse_format,
+                         MatrixValueType value_type,
+                         bool detect_pattern,
+                         bool use_cache)
 {
 
+  // Read from sidecar, if sidecar matches file and arguments; otherwise, parse file and
+  // write sidecar (failure, e.g., in a read-only directory, is ignored)
+  if (use_cache) {
+    FileCache cache(file_name, C_MATRIX_DATA, sparse_format * 100 + value_type * 10 + (detect_pattern ? 1 : 0));
+    if (cache.map() && readFromCache(cache)) {
+      return;
+    }
+    setFromFile(file_name, sparse_format, value_type, detect_pattern, false);
+    writeToCache(cache);
+    return;
+  } // end if
+
+  // Read Matrix Market file
+  if (isMatrixMarketFile(file_name)) {
+    setFromMatrixMarketFile(file_name, sparse_format, value_type, detect_pattern);
+    return;
+  }
+
   // Set sparse format
   sparse_format_ = sparse_format;
 
   // Open file
-  FILE* f_in = fopen(file_name, "r");
-
-  // Check for failed opening
-  if (f_in == NULL) {
+  TextParser parser;
+  if (!parser.open(file_name)) {
     THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Failed to open input file.");
   }
 
-  // Read number of rows and columns (assumed first two entries in file)
-  int scan_value = fscanf(f_in, "%d %d %d", &number_of_rows_, &number_of_columns_, &number_of_nonzeros_);
-  if (scan_value == 0 || scan_value == EOF) {
+  // Read number of rows and columns (assumed first two entries in file) and nonzeros
+  long long number_of_rows, number_of_columns;
+  if (!parser.readInteger(number_of_rows) || !parser.readInteger(number_of_columns) || !parser.readInteger(number_of_nonzeros_) ||
+      number_of_rows < 0 || number_of_rows > FARSA_INT_INFINITY || number_of_columns < 0 || number_of_columns > FARSA_INT_INFINITY || number_of_nonzeros_ < 0) {
     THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Number of rows and columns not read.");
   }
+  number_of_rows_ = (int)number_of_rows;
+  number_of_columns_ = (int)number_of_columns;
 
   // Allocate memory
   column_indices_ = new int[number_of_nonzeros_];
   row_indices_ = new int[number_of_nonzeros_];
   values_ = new double[number_of_nonzeros_];
 
-  // Read file (assumes (row, column, value) format)
-  int counter = 0;
-  while (true) {
-    int scan_value = fscanf(f_in, "%d %d %lf", &row_indices_[counter], &column_indices_[counter], &values_[counter]);
-    if (scan_value == 0 || scan_value == EOF || counter >= number_of_nonzeros_-1) {
-      break;
-    }
-    if (row_indices_[counter] < 0 || row_indices_[counter] >= number_of_rows_) {
+  // Read file in parallel chunks (assumes (row, column, value) format; invalid indices
+  // are stored as -1)
+  long long number_of_nonzeros_read = parser.readRecords(number_of_nonzeros_, 3, [&](long long i, const double* fields) {
+    row_indices_[i] = (fields[0] >= 0.0 && fields[0] < number_of_rows_ && fields[0] == (int)fields[0]) ? (int)fields[0] : -1;
+    column_indices_[i] = (fields[1] >= 0.0 && fields[1] < number_of_columns_ && fields[1] == (int)fields[1]) ? (int)fields[1] : -1;
+    values_[i] = fields[2];
+  }, thread_pool_.get());
+
+  // Check indices
+  for (long long i = 0; i < number_of_nonzeros_read; i++) {
+    if (row_indices_[i] < 0) {
       THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Invalid row index read.");
     }
-    if (column_indices_[counter] < 0 || column_indices_[counter] >= number_of_columns_) {
+    if (column_indices_[i] < 0) {
       THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Invalid column index read.");
     }
-    counter++;
-  } // end while
+  } // end for
 
   // Check if all values have been read
-  if (counter < number_of_nonzeros_ - 1) {
+  if (number_of_nonzeros_read < number_of_nonzeros_) {
     THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Not all matrix elements have been read.");
   }
 
-  // Close file
-  fclose(f_in);
+  // Convert to requested format
+  if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    convertToCompressedSparseColumn();
+  }
+  else if (sparse_format_ == M_COMPRESSED_SPARSE_ROW) {
+    convertToCompressedSparseRow();
+  }
+
+  // Detect pattern (all values equal to one)
+  if (detect_pattern && valuesAreAllOne()) {
+    value_type = M_VALUE_PATTERN;
+  }
+
+  // Convert to requested value type
+  if (value_type != M_VALUE_DOUBLE) {
+    convertToValueType(value_type);
+  }
+
+  // Compute column and row norms (data is in cache from conversion)
+  computeNorms();
 
 } // end setFromFile
 
-// Print
-void Matrix::print(const Reporter* reporter,
-                   std::string name) const
+// Block columns by groups
+void Matrix::blockColumnsByGroups(const std::vector<std::vector<int> >& groups)
 {
 
-  // Print elements of matrix
-  reporter->printf(R_SOLVER, R_BASIC, "Matrix:\n");
-  reporter->printf(R_SUBSOLVER, R_BASIC, "Matrix:\n");
-  for (int i = 0; i < number_of_nonzeros_; i++) {
-    reporter->printf(R_SOLVER, R_BASIC, "%s row_index(%8d)=%8d\n", name.c_str(), i, row_indices_[i]);
-    reporter->printf(R_SUBSOLVER, R_BASIC, "%s row_index(%8d)=%8d\n", name.c_str(), i, row_indices_[i]);
+  // Asserts
+  ASSERT_EXCEPTION(sparse_format_ == M_COMPRESSED_SPARSE_COLUMN, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Blocking by groups requires compressed sparse column format.");
+
+  // Set new column order: columns of groups, then columns not in any group
+  std::vector<int> column_permutation;
+  std::vector<int> column_positions(number_of_columns_, -1);
+  std::vector<int> group_column_starts(groups.size() + 1);
+  column_permutation.reserve(number_of_columns_);
+  for (int g = 0; g < (int)groups.size(); g++) {
+    group_column_starts[g] = (int)column_permutation.size();
+    for (int k = 0; k < (int)groups[g].size(); k++) {
+      int column = groups[g][k];
+      if (column < 0 || column >= number_of_columns_) {
+        THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Invalid column index in group.");
+      }
+      if (column_positions[column] >= 0) {
+        THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Blocking by groups requires disjoint groups.");
+      }
+      column_positions[column] = (int)column_permutation.size();
+      column_permutation.push_back(column);
+    } // end for
+  }   // end for
+  group_column_starts[groups.size()] = (int)column_permutation.size();
+  for (int j = 0; j < number_of_columns_; j++) {
+    if (column_positions[j] < 0) {
+      column_positions[j] = (int)column_permutation.size();
+      column_permutation.push_back(j);
+    }
+  } // end for
+
+  // Set column starts in new order (current position of column accounts for previous blocking)
+  long long* column_starts = new long long[number_of_columns_ + 1];
+  column_starts[0] = 0;
+  for (int p = 0; p < number_of_columns_; p++) {
+    int current = isBlockedByGroups() ? column_positions_[column_permutation[p]] : column_permutation[p];
+    column_starts[p + 1] = column_starts[p] + (column_starts_[current + 1] - column_starts_[current]);
+  } // end for
+
+  // Move column data into new order
+  int* row_indices = new int[number_of_nonzeros_];
+  double* values = (values_ != nullptr) ? new double[number_of_nonzeros_] : nullptr;
+  float* values_float = (values_float_ != nullptr) ? new float[number_of_nonzeros_] : nullptr;
+  for (int p = 0; p < number_of_columns_; p++) {
+    int current = isBlockedByGroups() ? column_positions_[column_permutation[p]] : column_permutation[p];
+    for (long long i = column_starts_[current], destination = column_starts[p]; i < column_starts_[current + 1]; i++, destination++) {
+      row_indices[destination] = row_indices_[i];
+      if (values != nullptr) {
+        values[destination] = values_[i];
+      }
+      if (values_float != nullptr) {
+        values_float[destination] = values_float_[i];
+      }
+    } // end for
+  }   // end for
+
+  // Replace arrays
+  delete[] column_starts_;
+  delete[] row_indices_;
+  if (values_ != nullptr) {
+    delete[] values_;
+  }
+  if (values_float_ != nullptr) {
+    delete[] values_float_;
+  }
+  column_starts_ = column_starts;
+  row_indices_ = row_indices;
+  values_ = values;
+  values_float_ = values_float;
+
+  // Set blocking data
+  column_permutation_ = column_permutation;
+  column_positions_ = column_positions;
+  group_column_starts_ = group_column_starts;
+
+} // end blockColumnsByGroups
+
+// Set from Matrix Market file
+void Matrix::setFromMatrixMarketFile(char* file_name,
+                                     SparseFormatType sparse_format,
+                                     MatrixValueType value_type,
+                                     bool detect_pattern)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(sparse_format == M_COMPRESSED_SPARSE_COLUMN || sparse_format == M_COMPRESSED_SPARSE_ROW, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Matrix Market files are stored in compressed sparse column or row format.");
+
+  // Open file (twice: one parser counts nonzeros, the other stores them)
+  TextParser count_parser;
+  TextParser store_parser;
+  if (!count_parser.open(file_name) || !store_parser.open(file_name)) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Failed to open input file.");
+  }
+
+  // Read headers
+  bool pattern;
+  double mirror_sign;
+  long long number_of_rows, number_of_columns, number_of_entries;
+  readMatrixMarketHeader(count_parser, pattern, mirror_sign, number_of_rows, number_of_columns, number_of_entries);
+  readMatrixMarketHeader(store_parser, pattern, mirror_sign, number_of_rows, number_of_columns, number_of_entries);
+
+  // Set function to read entry (indices converted to 0-based; value skipped if not needed)
+  auto read_entry = [&](TextParser& parser, int& row, int& column, double& value, bool read_value) {
+    double row_value, column_value;
+    value = 1.0;
+    if (!parser.readNumber(row_value) || !parser.readNumber(column_value) ||
+        (!pattern && !(read_value ? parser.readNumber(value) : parser.skipNumber()))) {
+      THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Not all matrix elements have been read.");
+    }
+    if (!(row_value >= 1.0 && row_value <= number_of_rows && row_value == (int)row_value)) {
+      THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Invalid row index read.");
+    }
+    if (!(column_value >= 1.0 && column_value <= number_of_columns && column_value == (int)column_value)) {
+      THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Invalid column index read.");
+    }
+    row = (int)row_value - 1;
+    column = (int)column_value - 1;
+  };
+
+  // Count nonzeros per column (or row), including mirrored entries
+  bool by_columns = (sparse_format == M_COMPRESSED_SPARSE_COLUMN);
+  long long number_of_lines = by_columns ? number_of_columns : number_of_rows;
+  std::vector<long long> starts(number_of_lines + 1, 0);
+  int row, column;
+  double value;
+  for (long long k = 0; k < number_of_entries; k++) {
+    read_entry(count_parser, row, column, value, false);
+    starts[(by_columns ? column : row) + 1]++;
+    if (mirror_sign != 0.0 && row != column) {
+      starts[(by_columns ? row : column) + 1]++;
+    }
   } // end for
-  for (int i = 0; i < number_of_nonzeros_; i++) {
-    reporter->printf(R_SOLVER, R_BASIC, "%s column_index(%8d)=%8d\n", name.c_str(), i, column_indices_[i]);
-    reporter->printf(R_SUBSOLVER, R_BASIC, "%s column_index(%8d)=%8d\n", name.c_str(), i, column_indices_[i]);
+
+  // Accumulate counts into start positions
+  for (long long line = 0; line < number_of_lines; line++) {
+    starts[line + 1] += starts[line];
+  }
+  long long number_of_nonzeros = starts[number_of_lines];
+
+  // Allocate arrays (values are not stored for pattern files or pattern value type)
+  std::unique_ptr<int[]> indices(new int[number_of_nonzeros]);
+  std::unique_ptr<double[]> values((!pattern && value_type == M_VALUE_DOUBLE) ? new double[number_of_nonzeros] : nullptr);
+  std::unique_ptr<float[]> values_float((!pattern && value_type == M_VALUE_FLOAT) ? new float[number_of_nonzeros] : nullptr);
+
+  // Store nonzeros into columns (or rows), in file order
+  std::vector<long long> positions(starts.begin(), starts.end() - 1);
+  bool all_one = true;
+  auto store = [&](int line, int index, double value) {
+    long long i = positions[line]++;
+    indices[i] = index;
+    if (values) {
+      values[i] = value;
+    }
+    else if (values_float) {
+      values_float[i] = (float)value;
+    }
+    all_one = all_one && (value == 1.0);
+  };
+  for (long long k = 0; k < number_of_entries; k++) {
+    read_entry(store_parser, row, column, value, true);
+    store(by_columns ? column : row, by_columns ? row : column, value);
+    if (mirror_sign != 0.0 && row != column) {
+      store(by_columns ? row : column, by_columns ? column : row, mirror_sign * value);
+    }
   } // end for
-  for (int i = 0; i < number_of_nonzeros_; i++) {
-    reporter->printf(R_SOLVER, R_BASIC, "%s value(%8d)=%+23.16e\n", name.c_str(), i, values_[i]);
-    reporter->printf(R_SUBSOLVER, R_BASIC, "%s value(%8d)=%+23.16e\n", name.c_str(), i, values_[i]);
+
+  // Sort indices within columns (or rows) that are not sorted, e.g., after mirroring
+  std::vector<std::pair<int, double> > nonzeros;
+  for (long long line = 0; line < number_of_lines; line++) {
+    if (std::is_sorted(&indices[starts[line]], &indices[starts[line + 1]])) {
+      continue;
+    }
+    nonzeros.clear();
+    for (long long i = starts[line]; i < starts[line + 1]; i++) {
+      nonzeros.push_back(std::make_pair(indices[i], values ? values[i] : values_float ? (double)values_float[i] : 1.0));
+    }
+    std::stable_sort(nonzeros.begin(), nonzeros.end(), [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+    for (long long i = starts[line], k = 0; i < starts[line + 1]; i++, k++) {
+      indices[i] = nonzeros[k].first;
+      if (values) {
+        values[i] = nonzeros[k].second;
+      }
+      else if (values_float) {
+        values_float[i] = (float)nonzeros[k].second;
+      }
+    } // end for
+  }   // end for
+
+  // Set value type (pattern if file is pattern, if requested, or if detected)
+  if (value_type == M_VALUE_PATTERN && !all_one) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Pattern value type requires all values equal to one.");
+  }
+  if (pattern || value_type == M_VALUE_PATTERN || (detect_pattern && all_one)) {
+    value_type = M_VALUE_PATTERN;
+    values.reset();
+    values_float.reset();
+  } // end if
+
+  // Set sizes and arrays
+  number_of_rows_ = (int)number_of_rows;
+  number_of_columns_ = (int)number_of_columns;
+  number_of_nonzeros_ = number_of_nonzeros;
+  if (by_columns) {
+    column_starts_ = new long long[number_of_lines + 1];
+    for (long long line = 0; line <= number_of_lines; line++) {
+      column_starts_[line] = starts[line];
+    }
+    row_indices_ = indices.release();
+  }
+  else {
+    row_starts_ = new long long[number_of_lines + 1];
+    for (long long line = 0; line <= number_of_lines; line++) {
+      row_starts_[line] = starts[line];
+    }
+    column_indices_ = indices.release();
+  } // end else
+  values_ = values.release();
+  values_float_ = values_float.release();
+  value_type_ = value_type;
+  sparse_format_ = sparse_format;
+
+  // Compute column and row norms
+  computeNorms();
+
+} // end setFromMatrixMarketFile
+
+// Set from binary file
+void Matrix::setFromBinaryFile(char* file_name,
+                               long long stream_block_size)
+{
+
+  // Open file
+  int file_descriptor = open(file_name, O_RDONLY);
+
+  // Check for failed opening
+  if (file_descriptor < 0) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Failed to open input file.");
+  }
+
+  // Get file length
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size < FARSA_MATRIX_HEADER_SIZE) {
+    close(file_descriptor);
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Binary matrix file too short.");
+  }
+
+  // Map file (mapping persists after file is closed)
+  size_t mapped_length = (size_t)file_status.st_size;
+  void* mapped_data = mmap(nullptr, mapped_length, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  close(file_descriptor);
+  if (mapped_data == MAP_FAILED) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Failed to map binary matrix file.");
+  }
+
+  // Read header
+  char identifier[16];
+  int version, value_type, number_of_rows, number_of_columns;
+  long long number_of_nonzeros;
+  const char* header = (const char*)mapped_data;
+  memcpy(identifier, header, 16);
+  memcpy(&version, header + 16, sizeof(int));
+  memcpy(&value_type, header + 20, sizeof(int));
+  memcpy(&number_of_rows, header + 24, sizeof(int));
+  memcpy(&number_of_columns, header + 28, sizeof(int));
+  memcpy(&number_of_nonzeros, header + 32, sizeof(long long));
+
+  // Check header
+  long long value_size = (value_type == M_VALUE_DOUBLE) ? sizeof(double) : (value_type == M_VALUE_FLOAT) ? sizeof(float) : 0;
+  long long values_offset = FARSA_MATRIX_HEADER_SIZE + (number_of_rows + 1LL) * (long long)sizeof(long long) + number_of_nonzeros * (long long)sizeof(int);
+  values_offset = (values_offset + 7) / 8 * 8;
+  if (strncmp(identifier, FARSA_MATRIX_IDENTIFIER, 16) != 0 ||
+      version != FARSA_MATRIX_VERSION ||
+      value_type < M_VALUE_DOUBLE || value_type > M_VALUE_PATTERN ||
+      number_of_rows < 0 || number_of_columns < 0 || number_of_nonzeros < 0 ||
+      (long long)mapped_length != values_offset + number_of_nonzeros * value_size) {
+    munmap(mapped_data, mapped_length);
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Invalid binary matrix file.");
+  }
+
+  // Advise kernel of sequential access (enables aggressive read-ahead)
+  madvise(mapped_data, mapped_length, MADV_SEQUENTIAL);
+
+  // Set sizes
+  number_of_rows_ = number_of_rows;
+  number_of_columns_ = number_of_columns;
+  number_of_nonzeros_ = number_of_nonzeros;
+
+  // Set arrays, pointing into mapping
+  mapped_data_ = mapped_data;
+  mapped_length_ = mapped_length;
+  row_starts_ = (long long*)(header + FARSA_MATRIX_HEADER_SIZE);
+  column_indices_ = (int*)(header + FARSA_MATRIX_HEADER_SIZE + (number_of_rows + 1LL) * sizeof(long long));
+  value_type_ = (MatrixValueType)value_type;
+  if (value_type_ == M_VALUE_DOUBLE) {
+    values_ = (double*)(header + values_offset);
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    values_float_ = (float*)(header + values_offset);
+  }
+
+  // Set sparse format and block size
+  sparse_format_ = M_COMPRESSED_SPARSE_ROW;
+  stream_block_size_ = (stream_block_size > 0) ? stream_block_size : FARSA_MATRIX_STREAM_BLOCK_SIZE;
+
+  // Defer column and row norms to first request (one streamed pass over kept rows)
+  norms_computed_ = false;
+
+} // end setFromBinaryFile
+
+// Restrict to rows
+void Matrix::restrictToRows(int row_begin,
+                            int row_end)
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(0 <= row_begin && row_begin <= row_end && row_end <= number_of_rows_, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Invalid row range.");
+
+  // Check for memory-mapped compressed sparse row format (shift row starts; data is not moved)
+  if (sparse_format_ == M_COMPRESSED_SPARSE_ROW && isMapped()) {
+    row_starts_ += row_begin;
+    number_of_rows_ = row_end - row_begin;
+    number_of_nonzeros_ = row_starts_[number_of_rows_] - row_starts_[0];
+    norms_computed_ = false;
+    return;
+  } // end if
+
+  // Check for compressed sparse row format in memory (copy rows)
+  if (sparse_format_ == M_COMPRESSED_SPARSE_ROW) {
+    long long nonzero_begin = row_starts_[row_begin];
+    long long number_of_nonzeros = row_starts_[row_end] - nonzero_begin;
+    long long* row_starts = new long long[row_end - row_begin + 1];
+    for (int r = row_begin; r <= row_end; r++) {
+      row_starts[r - row_begin] = row_starts_[r] - nonzero_begin;
+    }
+    int* column_indices = new int[number_of_nonzeros];
+    double* values = (values_ != nullptr) ? new double[number_of_nonzeros] : nullptr;
+    float* values_float = (values_float_ != nullptr) ? new float[number_of_nonzeros] : nullptr;
+    for (long long i = 0; i < number_of_nonzeros; i++) {
+      column_indices[i] = column_indices_[nonzero_begin + i];
+      if (values != nullptr) {
+        values[i] = values_[nonzero_begin + i];
+      }
+      if (values_float != nullptr) {
+        values_float[i] = values_float_[nonzero_begin + i];
+      }
+    } // end for
+    delete[] row_starts_;
+    delete[] column_indices_;
+    if (values_ != nullptr) {
+      delete[] values_;
+    }
+    if (values_float_ != nullptr) {
+      delete[] values_float_;
+    }
+    row_starts_ = row_starts;
+    column_indices_ = column_indices;
+    values_ = values;
+    values_float_ = values_float;
+    number_of_rows_ = row_end - row_begin;
+    number_of_nonzeros_ = number_of_nonzeros;
+    computeNorms();
+    return;
+  } // end if
+
+  // Set column of each nonzero (compressed sparse column stores column starts)
+  std::vector<int> columns(number_of_nonzeros_);
+  if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    for (int p = 0; p < number_of_columns_; p++) {
+      for (long long i = column_starts_[p]; i < column_starts_[p + 1]; i++) {
+        columns[i] = p;
+      }
+    } // end for
+  }
+  else {
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      columns[i] = column_indices_[i];
+    }
+  } // end else
+
+  // Count nonzeros in rows
+  long long number_of_nonzeros = 0;
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    if (row_indices_[i] >= row_begin && row_indices_[i] < row_end) {
+      number_of_nonzeros++;
+    }
+  } // end for
+
+  // Copy nonzeros in rows (order is preserved, so columns remain sorted)
+  int* row_indices = new int[number_of_nonzeros];
+  int* column_indices = (column_indices_ != nullptr) ? new int[number_of_nonzeros] : nullptr;
+  double* values = (values_ != nullptr) ? new double[number_of_nonzeros] : nullptr;
+  float* values_float = (values_float_ != nullptr) ? new float[number_of_nonzeros] : nullptr;
+  std::vector<int> column_counts(number_of_columns_ + 1, 0);
+  for (long long i = 0, k = 0; i < number_of_nonzeros_; i++) {
+    if (row_indices_[i] >= row_begin && row_indices_[i] < row_end) {
+      row_indices[k] = row_indices_[i] - row_begin;
+      if (column_indices != nullptr) {
+        column_indices[k] = column_indices_[i];
+      }
+      if (values != nullptr) {
+        values[k] = values_[i];
+      }
+      if (values_float != nullptr) {
+        values_float[k] = values_float_[i];
+      }
+      column_counts[columns[i] + 1]++;
+      k++;
+    } // end if
+  }   // end for
+
+  // Replace arrays
+  delete[] row_indices_;
+  if (column_indices_ != nullptr) {
+    delete[] column_indices_;
+  }
+  if (values_ != nullptr) {
+    delete[] values_;
+  }
+  if (values_float_ != nullptr) {
+    delete[] values_float_;
+  }
+  row_indices_ = row_indices;
+  column_indices_ = column_indices;
+  values_ = values;
+  values_float_ = values_float;
+
+  // Set column starts
+  if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    for (int p = 0; p < number_of_columns_; p++) {
+      column_starts_[p + 1] = column_starts_[p] + column_counts[p + 1];
+    }
+  } // end if
+
+  // Set sizes
+  number_of_rows_ = row_end - row_begin;
+  number_of_nonzeros_ = number_of_nonzeros;
+
+  // Compute column and row norms of kept rows
+  computeNorms();
+
+} // end restrictToRows
+
+// Place
+void Matrix::place(Placement& placement,
+                   std::string name)
+{
+
+  // Check for compressed sparse column format in memory
+  if (sparse_format_ != M_COMPRESSED_SPARSE_COLUMN || isMapped()) {
+    return;
+  }
+
+  // Set column partition (nearly equal numbers of nonzeros per part)
+  int number_of_parts = placement.numberOfThreads();
+  column_partition_.assign(number_of_parts + 1, number_of_columns_);
+  column_partition_[0] = 0;
+  for (int t = 1, p = 0; t < number_of_parts; t++) {
+    long long target = number_of_nonzeros_ * t / number_of_parts;
+    while (p < number_of_columns_ && column_starts_[p] < target) {
+      p++;
+    }
+    column_partition_[t] = p;
+  } // end for
+
+  // Set part boundaries of columns and of nonzeros
+  std::vector<long long> column_part_starts(number_of_parts + 1);
+  std::vector<long long> nonzero_part_starts(number_of_parts + 1);
+  for (int t = 0; t <= number_of_parts; t++) {
+    column_part_starts[t] = column_partition_[t];
+    nonzero_part_starts[t] = column_starts_[column_partition_[t]];
+  }
+  column_part_starts[number_of_parts] = number_of_columns_ + 1;
+
+  // Copy arrays, each part by its thread
+  long long* column_starts = placement.placedCopy(column_starts_, column_part_starts);
+  int* row_indices = placement.placedCopy(row_indices_, nonzero_part_starts);
+  double* values = placement.placedCopy(values_, nonzero_part_starts);
+  float* values_float = placement.placedCopy(values_float_, nonzero_part_starts);
+
+  // Replace arrays
+  delete[] column_starts_;
+  delete[] row_indices_;
+  if (values_ != nullptr) {
+    delete[] values_;
+  }
+  if (values_float_ != nullptr) {
+    delete[] values_float_;
+  }
+  column_starts_ = column_starts;
+  row_indices_ = row_indices;
+  values_ = values;
+  values_float_ = values_float;
+
+  // Record placement
+  placement.record(name + " row indices", row_indices_, sizeof(int), nonzero_part_starts);
+  if (values_ != nullptr) {
+    placement.record(name + " values", values_, sizeof(double), nonzero_part_starts);
+  }
+  if (values_float_ != nullptr) {
+    placement.record(name + " values", values_float_, sizeof(float), nonzero_part_starts);
+  }
+
+} // end place
+
+// Check for binary file
+bool Matrix::isBinaryFile(char* file_name)
+{
+
+  // Open file
+  FILE* f_in = fopen(file_name, "rb");
+  if (f_in == NULL) {
+    return false;
+  }
+
+  // Read identifier
+  char identifier[16];
+  bool is_binary = (fread(identifier, 1, 16, f_in) == 16 && strncmp(identifier, FARSA_MATRIX_IDENTIFIER, 16) == 0);
+
+  // Close file
+  fclose(f_in);
+
+  // Return
+  return is_binary;
+
+} // end isBinaryFile
+
+// Check for Matrix Market file
+bool Matrix::isMatrixMarketFile(char* file_name)
+{
+
+  // Open file
+  FILE* f_in = fopen(file_name, "rb");
+  if (f_in == NULL) {
+    return false;
+  }
+
+  // Read banner
+  char banner[14];
+  bool is_matrix_market = (fread(banner, 1, 14, f_in) == 14 && strncmp(banner, "%%MatrixMarket", 14) == 0);
+
+  // Close file
+  fclose(f_in);
+
+  // Return
+  return is_matrix_market;
+
+} // end isMatrixMarketFile
+
+// Write to binary file
+void Matrix::writeToBinaryFile(char* file_name) const
+{
+
+  // Asserts
+  ASSERT_EXCEPTION(sparse_format_ != M_COMPRESSED_SPARSE_ROW, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Matrix already in compressed sparse row format.");
+
+  // Set row and (original) column of each nonzero
+  std::vector<int> rows(number_of_nonzeros_);
+  std::vector<int> columns(number_of_nonzeros_);
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    rows[i] = row_indices_[i];
+  }
+  if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    for (int p = 0; p < number_of_columns_; p++) {
+      int column = isBlockedByGroups() ? column_permutation_[p] : p;
+      for (long long i = column_starts_[p]; i < column_starts_[p + 1]; i++) {
+        columns[i] = column;
+      }
+    } // end for
+  }
+  else {
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      columns[i] = column_indices_[i];
+    }
+  } // end else
+
+  // Set row starts
+  std::vector<long long> row_starts(number_of_rows_ + 1, 0);
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    row_starts[rows[i] + 1]++;
+  }
+  for (int r = 0; r < number_of_rows_; r++) {
+    row_starts[r + 1] += row_starts[r];
+  }
+
+  // Scatter nonzeros into rows (ordered by column within row)
+  std::vector<long long> order(number_of_nonzeros_);
+  std::vector<long long> position(row_starts.begin(), row_starts.end() - 1);
+  std::vector<long long> by_column(number_of_nonzeros_);
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    by_column[i] = i;
+  }
+  std::stable_sort(by_column.begin(), by_column.end(), [&columns](long long a, long long b) { return columns[a] < columns[b]; });
+  for (long long k = 0; k < number_of_nonzeros_; k++) {
+    order[position[rows[by_column[k]]]++] = by_column[k];
+  }
+
+  // Open file
+  FILE* f_out = fopen(file_name, "wb");
+  if (f_out == NULL) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Failed to open output file.");
+  }
+
+  // Write header (padded to header size)
+  char header[FARSA_MATRIX_HEADER_SIZE];
+  memset(header, 0, FARSA_MATRIX_HEADER_SIZE);
+  int version = FARSA_MATRIX_VERSION;
+  int value_type = (int)value_type_;
+  strncpy(header, FARSA_MATRIX_IDENTIFIER, 16);
+  memcpy(header + 16, &version, sizeof(int));
+  memcpy(header + 20, &value_type, sizeof(int));
+  memcpy(header + 24, &number_of_rows_, sizeof(int));
+  memcpy(header + 28, &number_of_columns_, sizeof(int));
+  memcpy(header + 32, &number_of_nonzeros_, sizeof(long long));
+  bool written = (fwrite(header, 1, FARSA_MATRIX_HEADER_SIZE, f_out) == FARSA_MATRIX_HEADER_SIZE);
+
+  // Write row starts and column indices
+  written = written && (fwrite(row_starts.data(), sizeof(long long), row_starts.size(), f_out) == row_starts.size());
+  for (long long k = 0; k < number_of_nonzeros_ && written; k++) {
+    written = (fwrite(&columns[order[k]], sizeof(int), 1, f_out) == 1);
+  }
+
+  // Write padding (values aligned to 8 bytes) and values
+  long long offset = FARSA_MATRIX_HEADER_SIZE + (number_of_rows_ + 1LL) * (long long)sizeof(long long) + number_of_nonzeros_ * (long long)sizeof(int);
+  char padding[8] = {0};
+  if (written && offset % 8 != 0) {
+    written = (fwrite(padding, 1, (size_t)(8 - offset % 8), f_out) == (size_t)(8 - offset % 8));
+  }
+  for (long long k = 0; k < number_of_nonzeros_ && written; k++) {
+    if (value_type_ == M_VALUE_DOUBLE) {
+      written = (fwrite(&values_[order[k]], sizeof(double), 1, f_out) == 1);
+    }
+    else if (value_type_ == M_VALUE_FLOAT) {
+      written = (fwrite(&values_float_[order[k]], sizeof(float), 1, f_out) == 1);
+    }
+  } // end for
+
+  // Close file
+  if (fclose(f_out) != 0 || !written) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Failed to write binary matrix file.");
+  }
+
+} // end writeToBinaryFile
+
+// Read Matrix Market header
+void Matrix::readMatrixMarketHeader(TextParser& parser,
+                                    bool& pattern,
+                                    double& mirror_sign,
+                                    long long& number_of_rows,
+                                    long long& number_of_columns,
+                                    long long& number_of_entries)
+{
+
+  // Read banner (case insensitive)
+  std::string line;
+  char object[64], format[64], field[64], symmetry[64];
+  if (!parser.readLine(line) || sscanf(line.c_str(), "%%%%MatrixMarket %63s %63s %63s %63s", object, format, field, symmetry) != 4) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Matrix Market banner not read.");
+  }
+  for (char* word : {object, format, field, symmetry}) {
+    for (char* c = word; *c != '\0'; c++) {
+      *c = (char)tolower((unsigned char)*c);
+    }
+  } // end for
+
+  // Check banner
+  if (strcmp(object, "matrix") != 0 || strcmp(format, "coordinate") != 0) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Matrix Market format not supported (coordinate matrices only).");
+  }
+  if (strcmp(field, "real") != 0 && strcmp(field, "double") != 0 && strcmp(field, "integer") != 0 && strcmp(field, "pattern") != 0) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Matrix Market field not supported (real, integer, or pattern only).");
+  }
+  if (strcmp(symmetry, "general") != 0 && strcmp(symmetry, "symmetric") != 0 && strcmp(symmetry, "skew-symmetric") != 0) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Matrix Market symmetry not supported (general, symmetric, or skew-symmetric only).");
+  }
+  pattern = (strcmp(field, "pattern") == 0);
+  mirror_sign = (strcmp(symmetry, "symmetric") == 0) ? 1.0 : (strcmp(symmetry, "skew-symmetric") == 0) ? -1.0 : 0.0;
+
+  // Skip comment and empty lines, then read size line
+  bool size_read = false;
+  while (!size_read && parser.readLine(line)) {
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first != std::string::npos && line[first] != '%') {
+      size_read = (sscanf(line.c_str(), "%lld %lld %lld", &number_of_rows, &number_of_columns, &number_of_entries) == 3);
+      if (!size_read) {
+        break;
+      }
+    }
+  } // end while
+
+  // Check sizes
+  if (!size_read ||
+      number_of_rows < 0 || number_of_rows > FARSA_INT_INFINITY ||
+      number_of_columns < 0 || number_of_columns > FARSA_INT_INFINITY ||
+      number_of_entries < 0) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Number of rows and columns not read.");
+  }
+  if (mirror_sign != 0.0 && number_of_rows != number_of_columns) {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Symmetric Matrix Market matrix must be square.");
+  }
+
+} // end readMatrixMarketHeader
+
+// Read from cache
+bool Matrix::readFromCache(const FileCache& cache)
+{
+
+  // Read sizes
+  long long sizes[5];
+  if (cache.length() < sizeof(sizes)) {
+    return false;
+  }
+  memcpy(sizes, cache.data(), sizeof(sizes));
+  long long sparse_format = sizes[0];
+  long long value_type = sizes[1];
+  long long number_of_rows = sizes[2];
+  long long number_of_columns = sizes[3];
+  long long number_of_nonzeros = sizes[4];
+  if (sparse_format < M_COORDINATE_LIST || sparse_format > M_COMPRESSED_SPARSE_ROW ||
+      value_type < M_VALUE_DOUBLE || value_type > M_VALUE_PATTERN ||
+      number_of_rows < 0 || number_of_rows > FARSA_INT_INFINITY ||
+      number_of_columns < 0 || number_of_columns > FARSA_INT_INFINITY ||
+      number_of_nonzeros < 0) {
+    return false;
+  }
+
+  // Set lengths of index arrays and values
+  size_t starts_length = 0;
+  if (sparse_format == M_COMPRESSED_SPARSE_COLUMN) {
+    starts_length = (size_t)(number_of_columns + 1) * sizeof(long long);
+  }
+  else if (sparse_format == M_COMPRESSED_SPARSE_ROW) {
+    starts_length = (size_t)(number_of_rows + 1) * sizeof(long long);
+  }
+  size_t row_indices_length = (sparse_format != M_COMPRESSED_SPARSE_ROW) ? (size_t)number_of_nonzeros * sizeof(int) : 0;
+  size_t column_indices_length = (sparse_format != M_COMPRESSED_SPARSE_COLUMN) ? (size_t)number_of_nonzeros * sizeof(int) : 0;
+  size_t values_length = 0;
+  if (value_type == M_VALUE_DOUBLE) {
+    values_length = (size_t)number_of_nonzeros * sizeof(double);
+  }
+  else if (value_type == M_VALUE_FLOAT) {
+    values_length = (size_t)number_of_nonzeros * sizeof(float);
+  }
+
+  // Check length of data (each part padded to a multiple of 8 bytes)
+  auto padded = [](size_t length) { return (length + 7) / 8 * 8; };
+  if (cache.length() != sizeof(sizes) + padded(starts_length) + padded(row_indices_length) + padded(column_indices_length) + padded(values_length)) {
+    return false;
+  }
+
+  // Copy arrays
+  const char* position = cache.data() + sizeof(sizes);
+  auto copy = [&](void* destination, size_t length) {
+    memcpy(destination, position, length);
+    position += padded(length);
+  };
+  if (sparse_format == M_COMPRESSED_SPARSE_COLUMN) {
+    column_starts_ = new long long[number_of_columns + 1];
+    copy(column_starts_, starts_length);
+  }
+  else if (sparse_format == M_COMPRESSED_SPARSE_ROW) {
+    row_starts_ = new long long[number_of_rows + 1];
+    copy(row_starts_, starts_length);
+  }
+  if (sparse_format != M_COMPRESSED_SPARSE_ROW) {
+    row_indices_ = new int[number_of_nonzeros];
+    copy(row_indices_, row_indices_length);
+  }
+  if (sparse_format != M_COMPRESSED_SPARSE_COLUMN) {
+    column_indices_ = new int[number_of_nonzeros];
+    copy(column_indices_, column_indices_length);
+  }
+  if (value_type == M_VALUE_DOUBLE) {
+    values_ = new double[number_of_nonzeros];
+    copy(values_, values_length);
+  }
+  else if (value_type == M_VALUE_FLOAT) {
+    values_float_ = new float[number_of_nonzeros];
+    copy(values_float_, values_length);
+  }
+
+  // Set sizes and types
+  number_of_rows_ = (int)number_of_rows;
+  number_of_columns_ = (int)number_of_columns;
+  number_of_nonzeros_ = number_of_nonzeros;
+  sparse_format_ = (SparseFormatType)sparse_format;
+  value_type_ = (MatrixValueType)value_type;
+
+  // Compute column and row norms
+  computeNorms();
+
+  // Return
+  return true;
+
+} // end readFromCache
+
+// Write to cache
+void Matrix::writeToCache(const FileCache& cache) const
+{
+
+  // Set sizes
+  long long sizes[5] = {sparse_format_, value_type_, number_of_rows_, number_of_columns_, number_of_nonzeros_};
+  std::vector<std::pair<const void*, size_t> > parts;
+  parts.push_back(std::make_pair((const void*)sizes, sizeof(sizes)));
+
+  // Set index arrays of sparse format
+  if (sparse_format_ == M_COORDINATE_LIST) {
+    parts.push_back(std::make_pair((const void*)row_indices_, (size_t)number_of_nonzeros_ * sizeof(int)));
+    parts.push_back(std::make_pair((const void*)column_indices_, (size_t)number_of_nonzeros_ * sizeof(int)));
+  }
+  else if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    parts.push_back(std::make_pair((const void*)column_starts_, (size_t)(number_of_columns_ + 1) * sizeof(long long)));
+    parts.push_back(std::make_pair((const void*)row_indices_, (size_t)number_of_nonzeros_ * sizeof(int)));
+  }
+  else {
+    parts.push_back(std::make_pair((const void*)row_starts_, (size_t)(number_of_rows_ + 1) * sizeof(long long)));
+    parts.push_back(std::make_pair((const void*)column_indices_, (size_t)number_of_nonzeros_ * sizeof(int)));
+  }
+
+  // Set values in value type
+  if (value_type_ == M_VALUE_DOUBLE) {
+    parts.push_back(std::make_pair((const void*)values_, (size_t)number_of_nonzeros_ * sizeof(double)));
+  }
+  else if (value_type_ == M_VALUE_FLOAT) {
+    parts.push_back(std::make_pair((const void*)values_float_, (size_t)number_of_nonzeros_ * sizeof(float)));
+  }
+
+  // Write sidecar
+  cache.write(parts);
+
+} // end writeToCache
+
+// Convert to compressed sparse column
+void Matrix::convertToCompressedSparseColumn()
+{
+
+  // Allocate column starts
+  column_starts_ = new long long[number_of_columns_ + 1];
+  for (int j = 0; j <= number_of_columns_; j++) {
+    column_starts_[j] = 0;
+  }
+
+  // Count nonzeros per column
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    column_starts_[column_indices_[i] + 1]++;
+  }
+
+  // Accumulate counts into start positions
+  for (int j = 0; j < number_of_columns_; j++) {
+    column_starts_[j + 1] += column_starts_[j];
+  }
+
+  // Allocate sorted arrays
+  int* row_indices = new int[number_of_nonzeros_];
+  double* values = new double[number_of_nonzeros_];
+
+  // Scatter elements into columns (stable, so row order within a column is preserved)
+  long long* position = new long long[number_of_columns_];
+  for (int j = 0; j < number_of_columns_; j++) {
+    position[j] = column_starts_[j];
+  }
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    long long destination = position[column_indices_[i]]++;
+    row_indices[destination] = row_indices_[i];
+    values[destination] = values_[i];
+  } // end for
+  delete[] position;
+
+  // Replace coordinate arrays
+  delete[] column_indices_;
+  delete[] row_indices_;
+  delete[] values_;
+  column_indices_ = nullptr;
+  row_indices_ = row_indices;
+  values_ = values;
+
+  // Set sparse format
+  sparse_format_ = M_COMPRESSED_SPARSE_COLUMN;
+
+} // end convertToCompressedSparseColumn
+
+// Convert to compressed sparse row
+void Matrix::convertToCompressedSparseRow()
+{
+
+  // Allocate row starts
+  row_starts_ = new long long[number_of_rows_ + 1];
+  for (int r = 0; r <= number_of_rows_; r++) {
+    row_starts_[r] = 0;
+  }
+
+  // Count nonzeros per row
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    row_starts_[row_indices_[i] + 1]++;
+  }
+
+  // Accumulate counts into start positions
+  for (int r = 0; r < number_of_rows_; r++) {
+    row_starts_[r + 1] += row_starts_[r];
+  }
+
+  // Allocate sorted arrays
+  int* column_indices = new int[number_of_nonzeros_];
+  double* values = new double[number_of_nonzeros_];
+
+  // Scatter elements into rows (stable, so column order within a row is preserved)
+  long long* position = new long long[number_of_rows_];
+  for (int r = 0; r < number_of_rows_; r++) {
+    position[r] = row_starts_[r];
+  }
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    long long destination = position[row_indices_[i]]++;
+    column_indices[destination] = column_indices_[i];
+    values[destination] = values_[i];
+  } // end for
+  delete[] position;
+
+  // Replace coordinate arrays
+  delete[] column_indices_;
+  delete[] row_indices_;
+  delete[] values_;
+  column_indices_ = column_indices;
+  row_indices_ = nullptr;
+  values_ = values;
+
+  // Set sparse format
+  sparse_format_ = M_COMPRESSED_SPARSE_ROW;
+
+} // end convertToCompressedSparseRow
+
+// Convert to value type
+void Matrix::convertToValueType(MatrixValueType value_type)
+{
+
+  // Copy values into single precision storage, or check that pattern is exact
+  if (value_type == M_VALUE_FLOAT) {
+    values_float_ = new float[number_of_nonzeros_];
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      values_float_[i] = (float)values_[i];
+    }
+  }
+  else if (value_type == M_VALUE_PATTERN) {
+    if (!valuesAreAllOne()) {
+      THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Pattern value type requires all values equal to one.");
+    }
+  }
+  else {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Value type error.");
+  }
+
+  // Release double precision storage
+  delete[] values_;
+  values_ = nullptr;
+
+  // Set value type
+  value_type_ = value_type;
+
+} // end convertToValueType
+
+// Check whether all values equal one
+bool Matrix::valuesAreAllOne() const
+{
+
+  // Check values
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    if (values_[i] != 1.0) {
+      return false;
+    }
+  } // end for
+
+  // Return
+  return true;
+
+} // end valuesAreAllOne
+
+// Stored positions of columns
+std::vector<int> Matrix::columnPositions(const std::vector<int>& columns) const
+{
+
+  // Map columns to stored positions
+  std::vector<int> positions(columns.size());
+  for (int k = 0; k < (int)columns.size(); k++) {
+    positions[k] = column_positions_[columns[k]];
+  }
+
+  // Return
+  return positions;
+
+} // end columnPositions
+
+// Stored positions of columns of groups
+std::vector<int> Matrix::groupColumnPositions(const std::vector<int>& groups) const
+{
+
+  // Count columns
+  int number_of_positions = 0;
+  for (int k = 0; k < (int)groups.size(); k++) {
+    ASSERT_EXCEPTION(groups[k] >= 0 && groups[k] < (int)group_column_starts_.size() - 1, FARSA_MATRIX_ASSERT_EXCEPTION, "Matrix assert failed.  Invalid group index.");
+    number_of_positions += group_column_starts_[groups[k] + 1] - group_column_starts_[groups[k]];
+  } // end for
+
+  // Set positions, contiguous for each group
+  std::vector<int> positions;
+  positions.reserve(number_of_positions);
+  for (int k = 0; k < (int)groups.size(); k++) {
+    for (int p = group_column_starts_[groups[k]]; p < group_column_starts_[groups[k] + 1]; p++) {
+      positions.push_back(p);
+    }
+  } // end for
+
+  // Return
+  return positions;
+
+} // end groupColumnPositions
+
+// End of streamed block of rows
+int Matrix::streamBlockEnd(int row_begin) const
+{
+
+  // Set bytes per nonzero (column index and value)
+  long long nonzero_size = sizeof(int) + ((value_type_ == M_VALUE_DOUBLE) ? sizeof(double) : (value_type_ == M_VALUE_FLOAT) ? sizeof(float) : 0);
+
+  // Advance rows until block size is reached
+  int row_end = row_begin;
+  while (row_end < number_of_rows_ && (row_end == row_begin || (row_starts_[row_end] - row_starts_[row_begin]) * nonzero_size < stream_block_size_)) {
+    row_end++;
+  }
+
+  // Return
+  return row_end;
+
+} // end streamBlockEnd
+
+// Advise on block of rows
+void Matrix::adviseRows(int row_begin,
+                        int row_end,
+                        int advice) const
+{
+
+  // Check for mapping and nonempty block
+  if (mapped_data_ == nullptr || row_begin >= row_end) {
+    return;
+  }
+
+  // Set page size
+  static const long long page_size = sysconf(_SC_PAGESIZE);
+
+  // Set byte ranges of column indices and values of block
+  std::vector<std::pair<const char*, const char*> > ranges;
+  ranges.push_back(std::make_pair((const char*)(column_indices_ + row_starts_[row_begin]), (const char*)(column_indices_ + row_starts_[row_end])));
+  if (values_ != nullptr) {
+    ranges.push_back(std::make_pair((const char*)(values_ + row_starts_[row_begin]), (const char*)(values_ + row_starts_[row_end])));
+  }
+  if (values_float_ != nullptr) {
+    ranges.push_back(std::make_pair((const char*)(values_float_ + row_starts_[row_begin]), (const char*)(values_float_ + row_starts_[row_end])));
+  }
+
+  // Advise on pages (round outward to prefetch, inward to release, so pages shared with neighboring blocks are kept)
+  for (int k = 0; k < (int)ranges.size(); k++) {
+    long long begin = ranges[k].first - (const char*)mapped_data_;
+    long long end = ranges[k].second - (const char*)mapped_data_;
+    if (advice == MADV_DONTNEED) {
+      begin = (begin + page_size - 1) / page_size * page_size;
+      end = end / page_size * page_size;
+    }
+    else {
+      begin = begin / page_size * page_size;
+      end = std::min((long long)mapped_length_, (end + page_size - 1) / page_size * page_size);
+    }
+    if (begin < end) {
+      madvise((char*)mapped_data_ + begin, (size_t)(end - begin), advice);
+    }
+  } // end for
+
+} // end adviseRows
+
+// Compute column and row norms
+void Matrix::computeNorms()
+{
+
+  // Initialize squared norms
+  std::vector<double> column_norms(number_of_columns_, 0.0);
+  std::vector<double> row_norms(number_of_rows_, 0.0);
+
+  // Accumulate squared values, loop depending on sparse format
+  if (sparse_format_ == M_COORDINATE_LIST) {
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      double squared_value = value(i) * value(i);
+      column_norms[column_indices_[i]] += squared_value;
+      row_norms[row_indices_[i]] += squared_value;
+    } // end for
+  }
+  else if (sparse_format_ == M_COMPRESSED_SPARSE_ROW) {
+    for (int row_begin = 0, row_end; row_begin < number_of_rows_; row_begin = row_end) {
+      row_end = streamBlockEnd(row_begin);
+      adviseRows(row_end, streamBlockEnd(row_end), MADV_WILLNEED);
+      for (int r = row_begin; r < row_end; r++) {
+        for (long long i = row_starts_[r]; i < row_starts_[r + 1]; i++) {
+          double squared_value = value(i) * value(i);
+          column_norms[column_indices_[i]] += squared_value;
+          row_norms[r] += squared_value;
+        } // end for
+      }   // end for
+      adviseRows(row_begin, row_end, MADV_DONTNEED);
+    } // end for
+  }
+  else if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    for (int j = 0; j < number_of_columns_; j++) {
+      int column = isBlockedByGroups() ? column_permutation_[j] : j;
+      for (long long i = column_starts_[j]; i < column_starts_[j + 1]; i++) {
+        double squared_value = value(i) * value(i);
+        column_norms[column] += squared_value;
+        row_norms[row_indices_[i]] += squared_value;
+      } // end for
+    }   // end for
+  }
+  else {
+    THROW_EXCEPTION(FARSA_MATRIX_EXCEPTION, "Sparse format type error.");
+  }
+
+  // Take square roots
+  for (int j = 0; j < number_of_columns_; j++) {
+    column_norms[j] = sqrt(column_norms[j]);
+  }
+  for (int r = 0; r < number_of_rows_; r++) {
+    row_norms[r] = sqrt(row_norms[r]);
+  }
+
+  // Set norms
+  column_norms_.swap(column_norms);
+  row_norms_.swap(row_norms);
+  norms_computed_ = true;
+
+} // end computeNorms
+
+// Number of nonzeros in columns
+long long Matrix::columnsNonzeros(const std::vector<int>& columns) const
+{
+
+  // Sum lengths of columns
+  long long number_of_nonzeros = 0;
+  for (int k = 0; k < (int)columns.size(); k++) {
+    number_of_nonzeros += column_starts_[columns[k] + 1] - column_starts_[columns[k]];
+  }
+
+  // Return
+  return number_of_nonzeros;
+
+} // end columnsNonzeros
+
+// Run body over range
+void Matrix::forRange(long long begin,
+                      long long end,
+                      long long number_of_nonzeros,
+                      const std::function<void(long long, long long)>& body) const
+{
+
+  // Run in parallel (chunks of about equal numbers of nonzeros on average) or serially
+  if (thread_pool_ != nullptr && thread_pool_->numberOfThreads() > 1 && number_of_nonzeros > FARSA_THREAD_POOL_GRAIN_SIZE) {
+    long long grain_size = std::max((end - begin) * FARSA_THREAD_POOL_GRAIN_SIZE / number_of_nonzeros, 1LL);
+    thread_pool_->parallelFor(begin, end, grain_size, body);
+  }
+  else {
+    body(begin, end);
+  }
+
+} // end forRange
+
+// Run body over stored columns
+void Matrix::forColumns(const std::function<void(long long, long long)>& body) const
+{
+
+  // Run over placed parts (each queued to the thread that placed it) or over chunks
+  if (thread_pool_ != nullptr && thread_pool_->numberOfThreads() > 1 && number_of_nonzeros_ > FARSA_THREAD_POOL_GRAIN_SIZE && column_partition_.size() > 0) {
+    std::vector<long long> part_starts(column_partition_.begin(), column_partition_.end());
+    thread_pool_->parallelForParts(part_starts, [&](int part, long long part_begin, long long part_end) { body(part_begin, part_end); });
+  }
+  else {
+    forRange(0, number_of_columns_, number_of_nonzeros_, body);
+  }
+
+} // end forColumns
+
+// Scatter columns into product
+void Matrix::scatterColumns(long long number_of_columns,
+                            long long number_of_nonzeros,
+                            bool placed,
+                            Vector& product,
+                            const std::function<void(long long, long long, double*)>& body)
+{
+
+  // Set number of parts (fixed if reductions are deterministic, otherwise one per thread)
+  double* product_values = product.valuesModifiable();
+  bool deterministic = (thread_pool_ != nullptr && thread_pool_->deterministicReductions());
+  int number_of_parts = (thread_pool_ != nullptr) ? thread_pool_->numberOfThreads() : 1;
+  if (deterministic) {
+    number_of_parts = FARSA_DETERMINISTIC_SCATTER_PARTS;
+  }
+
+  // Check for serial run
+  if (number_of_parts == 1 || number_of_nonzeros <= FARSA_THREAD_POOL_GRAIN_SIZE || number_of_columns < 2) {
+    body(0, number_of_columns, product_values);
+    return;
+  }
+
+  // Set parts (placed parts, if requested and available, otherwise equal numbers of columns)
+  std::vector<long long> part_starts(number_of_parts + 1);
+  if (placed && !deterministic && (int)column_partition_.size() == number_of_parts + 1) {
+    part_starts.assign(column_partition_.begin(), column_partition_.end());
+  }
+  else {
+    for (int t = 0; t <= number_of_parts; t++) {
+      part_starts[t] = number_of_columns * t / number_of_parts;
+    }
+  } // end else
+
+  // Set buffers (those of Matrix, kept between products, unless a concurrent product
+  // uses them, then those of this call)
+  std::vector<std::vector<double> > call_buffers;
+  std::unique_lock<std::mutex> lock(scatter_mutex_, std::try_to_lock);
+  std::vector<std::vector<double> >& buffers = lock.owns_lock() ? scatter_buffers_ : call_buffers;
+  buffers.resize(number_of_parts - 1);
+
+  // Scatter parts, first into product and others into zeroed buffers
+  std::vector<double*> part_values(number_of_parts, product_values);
+  thread_pool_->parallelForParts(part_starts, [&](int part, long long part_begin, long long part_end) {
+    if (part > 0) {
+      buffers[part - 1].assign(number_of_rows_, 0.0);
+      part_values[part] = buffers[part - 1].data();
+    }
+    body(part_begin, part_end, part_values[part]);
+  });
+
+  // Add buffers to product by pairwise summation (shape depends only on number of parts)
+  forRange(0, number_of_rows_, (long long)number_of_rows_ * number_of_parts, [&](long long r_begin, long long r_end) {
+    for (int step = 1; step < number_of_parts; step *= 2) {
+      for (int t = 0; t + step < number_of_parts; t += 2 * step) {
+        double* values = part_values[t];
+        const double* other_values = part_values[t + step];
+        for (long long r = r_begin; r < r_end; r++) {
+          values[r] += other_values[r];
+        }
+      } // end for
+    }   // end for
+  });
+
+} // end scatterColumns
+
+// Print
+void Matrix::print(const Reporter* reporter,
+                   std::string name) const
+{
+
+  // Print elements of matrix
+  reporter->printf(R_SOLVER, R_BASIC, "Matrix:\n");
+  reporter->printf(R_SUBSOLVER, R_BASIC, "Matrix:\n");
+  if (sparse_format_ == M_COMPRESSED_SPARSE_ROW) {
+    for (int r = 0; r <= number_of_rows_; r++) {
+      reporter->printf(R_SOLVER, R_BASIC, "%s row_start(%8d)=%8lld\n", name.c_str(), r, row_starts_[r]);
+      reporter->printf(R_SUBSOLVER, R_BASIC, "%s row_start(%8d)=%8lld\n", name.c_str(), r, row_starts_[r]);
+    } // end for
+  }
+  else {
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      reporter->printf(R_SOLVER, R_BASIC, "%s row_index(%8lld)=%8d\n", name.c_str(), i, row_indices_[i]);
+      reporter->printf(R_SUBSOLVER, R_BASIC, "%s row_index(%8lld)=%8d\n", name.c_str(), i, row_indices_[i]);
+    } // end for
+  } // end else
+  if (sparse_format_ == M_COMPRESSED_SPARSE_COLUMN) {
+    for (int j = 0; j <= number_of_columns_; j++) {
+      reporter->printf(R_SOLVER, R_BASIC, "%s column_start(%8d)=%8lld\n", name.c_str(), j, column_starts_[j]);
+      reporter->printf(R_SUBSOLVER, R_BASIC, "%s column_start(%8d)=%8lld\n", name.c_str(), j, column_starts_[j]);
+    } // end for
+  }
+  else {
+    for (long long i = 0; i < number_of_nonzeros_; i++) {
+      reporter->printf(R_SOLVER, R_BASIC, "%s column_index(%8lld)=%8d\n", name.c_str(), i, column_indices_[i]);
+      reporter->printf(R_SUBSOLVER, R_BASIC, "%s column_index(%8lld)=%8d\n", name.c_str(), i, column_indices_[i]);
+    } // end for
+  } // end else
+  for (long long i = 0; i < number_of_nonzeros_; i++) {
+    reporter->printf(R_SOLVER, R_BASIC, "%s value(%8lld)=%+23.16e\n", name.c_str(), i, value(i));
+    reporter->printf(R_SUBSOLVER, R_BASIC, "%s value(%8lld)=%+23.16e\n", name.c_str(), i, value(i));
   } // end for
 
 } // end print
@@ -7,7 +7,16 @@
 #ifndef __FARSAMATRIX_HPP__
 #define __FARSAMATRIX_HPP__
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "FaRSADefinitions.hpp"
+#include "FaRSAEnumerations.hpp"
+#include "FaRSAPlacement.hpp"
 #include "FaRSAReporter.hpp"
+#include "FaRSAThreadPool.hpp"
 #include "FaRSAVector.hpp"
 
 namespace FaRSA
@@ -16,7 +25,11 @@ namespace FaRSA
 /**
  * Forward declarations
  */
+class Placement;
+class FileCache;
 class Reporter;
+class TextParser;
+class ThreadPool;
 class Vector;
 
 /**
@@ -36,8 +49,16 @@ public:
       number_of_nonzeros_(0),
       number_of_rows_(0),
       column_indices_(nullptr),
+      column_starts_(nullptr),
       row_indices_(nullptr),
-      values_(nullptr){};
+      row_starts_(nullptr),
+      values_(nullptr),
+      values_float_(nullptr),
+      value_type_(M_VALUE_DOUBLE),
+      mapped_data_(nullptr),
+      mapped_length_(0),
+      stream_block_size_(FARSA_MATRIX_STREAM_BLOCK_SIZE),
+      norms_computed_(false){};
   //@}
 
   /** @name Destructor */
@@ -75,6 +96,77 @@ public:
    */
   void matrixTransposeVectorProduct(const Vector& vector,
                                     Vector& product);
+  /**
+   * Get product of column view with vector, i.e., product = A(:,columns)*vector
+   * (requires compressed sparse column format; work is proportional to the
+   *  number of nonzeros in the given columns)
+   * \param[in] columns is vector of column indices defining the view
+   * \param[in] vector is reference to a Vector of length columns.size()
+   * \param[out] product is Vector to store product values
+   */
+  void matrixVectorProductColumns(const std::vector<int>& columns,
+                                  const Vector& vector,
+                                  Vector& product);
+  /**
+   * Get product of column view transpose with vector, i.e., product = A(:,columns)'*vector
+   * (requires compressed sparse column format; work is proportional to the
+   *  number of nonzeros in the given columns)
+   * \param[in] columns is vector of column indices defining the view
+   * \param[in] vector is reference to a Vector
+   * \param[out] product is Vector of length columns.size() to store product values
+   */
+  void matrixTransposeVectorProductColumns(const std::vector<int>& columns,
+                                           const Vector& vector,
+                                           Vector& product);
+  /**
+   * Get product of elementwise-squared column view transpose with vector, i.e.,
+   * product(k) = sum_i A(i,columns(k))^2 * vector(i), which for nonnegative
+   * vector gives the diagonal of A(:,columns)'*diag(vector)*A(:,columns)
+   * (requires compressed sparse column format)
+   * \param[in] columns is vector of column indices defining the view
+   * \param[in] vector is reference to a Vector
+   * \param[out] product is Vector of length columns.size() to store product values
+   */
+  void squaredMatrixTransposeVectorProductColumns(const std::vector<int>& columns,
+                                                  const Vector& vector,
+                                                  Vector& product);
+  /**
+   * Get product of group view with vector, i.e., product = A(:,columns)*vector, where
+   * columns is concatenation of given groups (requires blocking by groups; reads one
+   * contiguous block of columns per group)
+   * \param[in] groups is vector of group indices defining the view
+   * \param[in] vector is reference to a Vector of length equal to number of columns in groups
+   * \param[out] product is Vector to store product values
+   */
+  void matrixVectorProductGroups(const std::vector<int>& groups,
+                                 const Vector& vector,
+                                 Vector& product);
+  /**
+   * Get product of group view transpose with vector, i.e., product = A(:,columns)'*vector,
+   * where columns is concatenation of given groups (requires blocking by groups; reads one
+   * contiguous block of columns per group)
+   * \param[in] groups is vector of group indices defining the view
+   * \param[in] vector is reference to a Vector
+   * \param[out] product is Vector of length equal to number of columns in groups to store product values
+   */
+  void matrixTransposeVectorProductGroups(const std::vector<int>& groups,
+                                          const Vector& vector,
+                                          Vector& product);
+  /**
+   * Get product of elementwise-squared group view transpose with vector (see
+   * squaredMatrixTransposeVectorProductColumns; requires blocking by groups)
+   * \param[in] groups is vector of group indices defining the view
+   * \param[in] vector is reference to a Vector
+   * \param[out] product is Vector of length equal to number of columns in groups to store product values
+   */
+  void squaredMatrixTransposeVectorProductGroups(const std::vector<int>& groups,
+                                                 const Vector& vector,
+                                                 Vector& product);
+  /**
+    * Get indicator of blocking by groups
+    * \return true if columns are blocked by groups, false otherwise
+    */
+  inline bool const isBlockedByGroups() const { return group_column_starts_.size() > 0; };
   /**
     * Get number of columns
     * \return number of columns of the matrix
@@ -84,20 +176,188 @@ public:
     * Get number of nonzeros
     * \return number of nonzeros in the matrix
     */
-  inline int const numberOfNonzeros() const { return number_of_nonzeros_; };
+  inline long long const numberOfNonzeros() const { return number_of_nonzeros_; };
   /**
     * Get number of rows
     * \return number of rows of the matrix
     */
   inline int const numberOfRows() const { return number_of_rows_; };
+  /**
+    * Get column norms (Euclidean norm of each column, indexed by original column; computed
+    * in one pass when matrix is built, or, if out-of-core, in one streamed pass when first
+    * requested, so rows not kept by restrictToRows are never read)
+    * \return vector of column norms
+    */
+  const std::vector<double>& columnNorms();
+  /**
+    * Get row norms (Euclidean norm of each row; computed with column norms)
+    * \return vector of row norms
+    */
+  const std::vector<double>& rowNorms();
+  /**
+    * Get upper bound on spectral norm of submatrix of given columns (Frobenius norm of
+    * submatrix, from column norms)
+    * \param[in] columns is vector of original column indices
+    * \return upper bound on spectral norm
+    */
+  double spectralNormBound(const std::vector<int>& columns);
+  /**
+    * Estimate squared spectral norm of matrix, or of submatrix of given columns, by power
+    * iteration on its Gram matrix over the (parallel) product kernels, starting from a
+    * pseudorandom vector with fixed seed (estimate is a lower bound that converges to
+    * the squared spectral norm; it stops when its relative change is within tolerance)
+    * \param[in] columns is vector of original column indices (empty for all columns;
+    *            otherwise requires compressed sparse column format)
+    * \param[in] number_of_iterations is maximum number of iterations
+    * \param[in] tolerance is relative change of estimate at which to stop
+    * \param[in] sum is function called as sum(values, length) to sum Gram products over
+    *            row shards of a matrix, e.g., by Communicator::allReduceSum (nullptr if
+    *            matrix is not sharded)
+    * \param[out] estimate is estimate of squared spectral norm
+    * \return indicator of success (true) or failure, i.e., of sum (false)
+    */
+  bool estimateSquaredSpectralNorm(const std::vector<int>& columns,
+                                   int number_of_iterations,
+                                   double tolerance,
+                                   const std::function<bool(double*, int)>& sum,
+                                   double& estimate);
+  /**
+    * Get value type
+    * \return type used to store nonzero values of the matrix
+    */
+  inline MatrixValueType const valueType() const { return value_type_; };
+  /**
+    * Get sparse format
+    * \return sparse format in which the matrix is stored
+    */
+  inline SparseFormatType const sparseFormat() const { return sparse_format_; };
+  /**
+    * Get indicator of out-of-core storage
+    * \return true if matrix is memory-mapped from a binary file, false otherwise
+    */
+  inline bool const isMapped() const { return mapped_data_ != nullptr; };
+  /**
+   * Get column partition set by place
+   * \return vector of first column of each part, followed by number of columns (empty if not placed)
+   */
+  inline const std::vector<int>& columnPartition() const { return column_partition_; };
+  /**
+   * Check whether file is a binary matrix file (see writeToBinaryFile)
+   * \param[in] file_name is name of file to check
+   * \return true if file starts with binary matrix file identifier, false otherwise
+   */
+  static bool isBinaryFile(char* file_name);
+  /**
+   * Check whether file is a Matrix Market file (see setFromMatrixMarketFile)
+   * \param[in] file_name is name of file to check
+   * \return true if file starts with Matrix Market banner, false otherwise
+   */
+  static bool isMatrixMarketFile(char* file_name);
+  //@}
+
+  /** @name Thread pool methods */
+  //@{
+  /**
+   * Set thread pool used by products of this Matrix (nullptr for serial products)
+   * (products in compressed sparse column format that scatter into rows use one
+   *  buffer of length number of rows per thread, or per part if reductions are
+   *  deterministic)
+   * \param[in] thread_pool is pointer to ThreadPool, e.g., owned by the solver
+   */
+  inline void setThreadPool(const std::shared_ptr<ThreadPool>& thread_pool) { thread_pool_ = thread_pool; };
+  /**
+   * Get thread pool used by products of this Matrix
+   * \return pointer to ThreadPool (nullptr if products are serial)
+   */
+  inline const std::shared_ptr<ThreadPool>& threadPool() const { return thread_pool_; };
   //@}
 
   /** @name Set methods */
   //@{
   /**
    * Set matrix from file, compressed sparse column format
+   * (values are read in double precision and, if value_type is M_VALUE_FLOAT,
+   *  stored in single precision; products always accumulate in double precision;
+   *  if value_type is M_VALUE_PATTERN, all values must equal one and none are stored;
+   *  Matrix Market files are read by setFromMatrixMarketFile)
+   * \param[in] file_name is name of file to read
+   * \param[in] sparse_format is sparse format in which to store matrix
+   * \param[in] value_type is type in which to store nonzero values
+   * \param[in] detect_pattern indicates whether to store as pattern (M_VALUE_PATTERN)
+   *            if all values read equal one, regardless of value_type
+   * \param[in] use_cache indicates whether to copy stored arrays from binary sidecar (see
+   *            FileCache) if sidecar matches file and arguments, and otherwise write
+   *            sidecar after parsing
+   */
+  void setFromFile(char* file_name,
+                   SparseFormatType sparse_format,
+                   MatrixValueType value_type = M_VALUE_DOUBLE,
+                   bool detect_pattern = false,
+                   bool use_cache = false);
+  /**
+   * Block columns by groups, i.e., store columns of each group contiguously (in the
+   * order given in the group), followed by columns not in any group; column indices
+   * in all products continue to refer to the original column order
+   * (requires compressed sparse column format and disjoint groups)
+   * \param[in] groups is vector of groups, each a vector of column indices
+   */
+  void blockColumnsByGroups(const std::vector<std::vector<int> >& groups);
+  /**
+   * Set matrix from Matrix Market coordinate file (real, integer, or pattern; general,
+   * symmetric, or skew-symmetric; 1-based indices), compressed sparse column or row format
+   * (built directly by counting nonzeros per column (or row) in one pass over the file and
+   *  storing them in a second pass, so no coordinate list is stored; pattern files are
+   *  stored without values; entries of symmetric files are mirrored; indices within each
+   *  column (or row) are sorted)
+   * \param[in] file_name is name of file to read
+   * \param[in] sparse_format is sparse format in which to store matrix
+   * \param[in] value_type is type in which to store nonzero values
+   * \param[in] detect_pattern indicates whether to store as pattern (M_VALUE_PATTERN)
+   *            if all values read equal one, regardless of value_type
    */
-  void setFromFile(char* file_name, SparseFormatType sparse_format);
+  void setFromMatrixMarketFile(char* file_name,
+                               SparseFormatType sparse_format,
+                               MatrixValueType value_type = M_VALUE_DOUBLE,
+                               bool detect_pattern = false);
+  /**
+   * Set matrix from binary file, compressed sparse row format, out-of-core
+   * (file is memory-mapped and products stream over blocks of rows, prefetching
+   *  the next block and releasing the previous one, so resident memory is bounded
+   *  by the block size regardless of the size of the file)
+   * \param[in] file_name is name of binary file written by writeToBinaryFile
+   * \param[in] stream_block_size is number of bytes of nonzero data per block of rows
+   */
+  void setFromBinaryFile(char* file_name,
+                         long long stream_block_size = FARSA_MATRIX_STREAM_BLOCK_SIZE);
+  /**
+   * Restrict matrix to rows row_begin,...,row_end-1, which become rows 0,...,row_end-row_begin-1
+   * (e.g., to keep one shard of rows per process; data of other rows is released, or,
+   *  if out-of-core, never read)
+   * \param[in] row_begin is first row to keep
+   * \param[in] row_end is row after last row to keep
+   */
+  void restrictToRows(int row_begin,
+                      int row_end);
+  /**
+   * Place nonzero data for parallel kernels: columns are split into one contiguous
+   * part per thread with nearly equal numbers of nonzeros, and each part is copied
+   * by its thread so that its pages are first touched on that thread's NUMA node
+   * (compressed sparse column format in memory only; otherwise data is unchanged)
+   * \param[in] placement is reference to Placement object
+   * \param[in] name is name of Matrix in placement report
+   */
+  void place(Placement& placement,
+             std::string name);
+  //@}
+
+  /** @name Write methods */
+  //@{
+  /**
+   * Write matrix to binary file, compressed sparse row format (header, 64-bit row
+   * starts, column indices, then values in value type of matrix; none if pattern)
+   * \param[in] file_name is name of binary file to write
+   */
+  void writeToBinaryFile(char* file_name) const;
   //@}
 
 private:
@@ -118,12 +378,195 @@ private:
   /** @name Private members */
   //@{
   int number_of_columns_;          /**< Number of rows of matrix */
-  int number_of_nonzeros_;         /**< Number of nonzeros in matrix */
+  long long number_of_nonzeros_;   /**< Number of nonzeros in matrix */
   int number_of_rows_;             /**< Number of nonzeros in matrix */
   int* column_indices_;            /**< Column indices */
+  long long* column_starts_;       /**< Column start positions (compressed sparse column) */
   int* row_indices_;               /**< Row indices */
-  double* values_;                 /**< Nonzero values in matrix */
+  long long* row_starts_;          /**< Row start positions (compressed sparse row) */
+  double* values_;                 /**< Nonzero values in matrix (double precision storage) */
+  float* values_float_;            /**< Nonzero values in matrix (single precision storage) */
+  MatrixValueType value_type_;     /**< Value type */
   SparseFormatType sparse_format_; /**< Sparse format type */
+  std::vector<int> column_permutation_;  /**< Original column of each stored column (if blocked) */
+  std::vector<int> column_positions_;    /**< Stored position of each original column (if blocked) */
+  std::vector<int> group_column_starts_; /**< First stored column of each group (if blocked) */
+  void* mapped_data_;                    /**< Memory-mapped binary file (if out-of-core) */
+  size_t mapped_length_;                 /**< Length of memory-mapped binary file */
+  long long stream_block_size_;          /**< Number of bytes of nonzero data per streamed block of rows */
+  std::vector<int> column_partition_;    /**< First column of each placed part (if placed) */
+  std::vector<double> column_norms_;     /**< Column norms (indexed by original column) */
+  std::vector<double> row_norms_;        /**< Row norms */
+  bool norms_computed_;                  /**< Indicator of column and row norms computed */
+  std::vector<std::vector<double> > scatter_buffers_; /**< Buffers for parallel scatter products */
+  std::mutex scatter_mutex_;             /**< Guard of scatter buffers (concurrent products) */
+  std::shared_ptr<ThreadPool> thread_pool_; /**< Thread pool for products */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Get number of nonzeros in stored columns
+   * \param[in] columns is vector of stored column positions
+   * \return number of nonzeros
+   */
+  long long columnsNonzeros(const std::vector<int>& columns) const;
+  /**
+   * Run body over range, in parallel if thread pool is set and work is large
+   * \param[in] begin is first index
+   * \param[in] end is index after last index
+   * \param[in] number_of_nonzeros is number of nonzeros in range (measure of work)
+   * \param[in] body is function called as body(begin, end) for subranges
+   */
+  void forRange(long long begin,
+                long long end,
+                long long number_of_nonzeros,
+                const std::function<void(long long, long long)>& body) const;
+  /**
+   * Run body over stored columns, by placed parts if placed
+   * \param[in] body is function called as body(begin, end) for ranges of stored columns
+   */
+  void forColumns(const std::function<void(long long, long long)>& body) const;
+  /**
+   * Run body that scatters columns into rows of product, in parallel if thread pool is
+   * set and work is large (each part scatters into its own buffer; buffers are then
+   * added to product by pairwise summation; the number of parts is the number of
+   * threads or, if reductions are deterministic, fixed); buffers are kept between
+   * products, and products running concurrently on this Matrix use their own buffers
+   * \param[in] number_of_columns is number of columns to scatter
+   * \param[in] number_of_nonzeros is number of nonzeros in columns (measure of work)
+   * \param[in] placed indicates whether columns are all stored columns (placed parts used)
+   * \param[in,out] product is product (zero on input)
+   * \param[in] body is function called as body(begin, end, values) to add columns begin,...,end-1
+   *            into values
+   */
+  void scatterColumns(long long number_of_columns,
+                      long long number_of_nonzeros,
+                      bool placed,
+                      Vector& product,
+                      const std::function<void(long long, long long, double*)>& body);
+  /**
+   * Read Matrix Market banner, comments, and size line
+   * \param[in,out] parser is parser of open file
+   * \param[out] pattern indicates whether entries have no values
+   * \param[out] mirror_sign is sign of mirrored entries (1 if symmetric, -1 if
+   *             skew-symmetric, 0 if general)
+   * \param[out] number_of_rows is number of rows
+   * \param[out] number_of_columns is number of columns
+   * \param[out] number_of_entries is number of entries in file
+   */
+  static void readMatrixMarketHeader(TextParser& parser,
+                                     bool& pattern,
+                                     double& mirror_sign,
+                                     long long& number_of_rows,
+                                     long long& number_of_columns,
+                                     long long& number_of_entries);
+  /**
+   * Compute column and row norms in one pass over nonzeros (streamed by blocks of rows
+   * if out-of-core)
+   */
+  void computeNorms();
+  /**
+   * Read stored arrays from mapped sidecar (copied, since blocking, placement, and
+   * restriction replace arrays)
+   * \param[in] cache is reference to FileCache with mapped sidecar
+   * \return true if sidecar data is consistent, false otherwise (matrix unchanged)
+   */
+  bool readFromCache(const FileCache& cache);
+  /**
+   * Write stored arrays to sidecar (sizes, index arrays of sparse format, then values)
+   * \param[in] cache is reference to FileCache of file read
+   */
+  void writeToCache(const FileCache& cache) const;
+  /**
+   * Convert coordinate list data to compressed sparse column format
+   */
+  void convertToCompressedSparseColumn();
+  /**
+   * Convert coordinate list data to compressed sparse row format
+   */
+  void convertToCompressedSparseRow();
+  /**
+   * Convert double precision values to value type
+   * \param[in] value_type is type in which to store nonzero values
+   */
+  void convertToValueType(MatrixValueType value_type);
+  /**
+   * Check whether all nonzero values equal one
+   * \return true if all double precision values equal one, false otherwise
+   */
+  bool valuesAreAllOne() const;
+  /**
+   * Get stored positions of columns
+   * \param[in] columns is vector of original column indices
+   * \return vector of stored column positions
+   */
+  std::vector<int> columnPositions(const std::vector<int>& columns) const;
+  /**
+   * Get stored positions of columns of groups (contiguous per group)
+   * \param[in] groups is vector of group indices
+   * \return vector of stored column positions
+   */
+  std::vector<int> groupColumnPositions(const std::vector<int>& groups) const;
+  /**
+   * Get end of streamed block of rows
+   * \param[in] row_begin is first row of block
+   * \return row after last row of block (at least row_begin + 1, at most number of rows)
+   */
+  int streamBlockEnd(int row_begin) const;
+  /**
+   * Advise kernel on expected use of nonzero data of block of rows (if memory-mapped)
+   * \param[in] row_begin is first row of block
+   * \param[in] row_end is row after last row of block
+   * \param[in] advice is madvise advice, e.g., MADV_WILLNEED or MADV_DONTNEED
+   */
+  void adviseRows(int row_begin,
+                  int row_end,
+                  int advice) const;
+  /**
+   * Get nonzero value (as double)
+   * \param[in] i is index of nonzero
+   * \return i-th nonzero value
+   */
+  inline double value(long long i) const
+  {
+    return (value_type_ == M_VALUE_PATTERN) ? 1.0 : (value_type_ == M_VALUE_FLOAT) ? (double)values_float_[i] : values_[i];
+  };
+  /**
+   * Implicit values of pattern matrix (indexing returns one, so kernels skip the value stream)
+   */
+  struct PatternValues
+  {
+    inline double operator[](long long i) const { return 1.0; };
+  };
+  /**
+   * Product kernels, templated on accessor of stored values, i.e., pointer to
+   * double or float values, or PatternValues (accumulate in double precision);
+   * columns given to column kernels are stored positions
+   */
+  template <typename V>
+  void matrixVectorProductKernel(V values,
+                                 const Vector& vector,
+                                 Vector& product);
+  template <typename V>
+  void matrixTransposeVectorProductKernel(V values,
+                                          const Vector& vector,
+                                          Vector& product);
+  template <typename V>
+  void matrixVectorProductColumnsKernel(V values,
+                                        const std::vector<int>& columns,
+                                        const Vector& vector,
+                                        Vector& product);
+  template <typename V>
+  void matrixTransposeVectorProductColumnsKernel(V values,
+                                                 const std::vector<int>& columns,
+                                                 const Vector& vector,
+                                                 Vector& product);
+  template <typename V>
+  void squaredMatrixTransposeVectorProductColumnsKernel(V values,
+                                                        const std::vector<int>& columns,
+                                                        const Vector& vector,
+                                                        Vector& product);
   //@}
 
 }; // end Matrix
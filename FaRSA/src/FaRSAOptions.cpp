@@ -22,15 +22,15 @@ void Options::print(const Reporter* reporter) const
 {
 
   // Print message if list is empty
-  if (option_list_.size() == 0) {
+  if (numberOfOptions() == 0) {
     reporter->printf(R_SOLVER, R_BASIC, "Option list is empty.\n");
     return;
   }
 
   // Print all options in list
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    option_list_[i]->print(reporter);
-    if (i < (int)option_list_.size() - 1) {
+  for (int i = 0; i < numberOfOptions(); i++) {
+    option(i).print(reporter);
+    if (i < numberOfOptions() - 1) {
       reporter->printf(R_SOLVER, R_BASIC, "\n");
     }
   }
@@ -44,22 +44,8 @@ bool Options::addBoolOption(const Reporter* reporter,
                             std::string description)
 {
 
-  // Check that option with given name doesn't already exist
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      reporter->printf(R_SOLVER, R_BASIC, "Option with name \'%s\' already exists.  Ignoring addition request.\n", name.c_str());
-      return false;
-    } // end if
-  }   // end for
-
-  // Declare new pointer
-  std::shared_ptr<Option> option(new Option(name, "bool", value, description));
-
-  // Add to list
-  option_list_.push_back(option);
-
-  // Return true
-  return true;
+  // Add option
+  return addOption(reporter, std::make_shared<Option>(name, "bool", value, description));
 
 } // end addBoolOption
 
@@ -72,14 +58,6 @@ bool Options::addDoubleOption(const Reporter* reporter,
                               std::string description)
 {
 
-  // Check that option with given name doesn't already exist
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      reporter->printf(R_SOLVER, R_BASIC, "Option with name \'%s\' already exists.  Ignoring addition request.\n", name.c_str());
-      return false;
-    } // end if
-  }   // end for
-
   // Check that lower bound is lower than upper bound
   if (lower_bound > upper_bound) {
     reporter->printf(R_SOLVER, R_BASIC, "Attempted to add double option \'%s\', but lower bound \'%+e\' greater than upper bound \'%+e\'.  Ignoring addition request.\n", name.c_str(), lower_bound, upper_bound);
@@ -92,14 +70,8 @@ bool Options::addDoubleOption(const Reporter* reporter,
     return false;
   } // end if
 
-  // Declare new pointer
-  std::shared_ptr<Option> option(new Option(name, "double", value, lower_bound, upper_bound, description));
-
-  // Add to list
-  option_list_.push_back(option);
-
-  // Return true
-  return true;
+  // Add option
+  return addOption(reporter, std::make_shared<Option>(name, "double", value, lower_bound, upper_bound, description));
 
 } // end addDoubleOption
 
@@ -112,14 +84,6 @@ bool Options::addIntegerOption(const Reporter* reporter,
                                std::string description)
 {
 
-  // Check that option with given name doesn't already exist
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      reporter->printf(R_SOLVER, R_BASIC, "Option with name \'%s\' already exists.  Ignoring addition request.\n", name.c_str());
-      return false;
-    } // end if
-  }   // end for
-
   // Check that lower bound is lower than upper bound
   if (lower_bound > upper_bound) {
     reporter->printf(R_SOLVER, R_BASIC, "Attempted to add integer option \'%s\', but lower bound \'%d\' greater than upper bound \'%d\'.  Ignoring addition request.\n", name.c_str(), lower_bound, upper_bound);
@@ -132,14 +96,8 @@ bool Options::addIntegerOption(const Reporter* reporter,
     return false;
   } // end if
 
-  // Declare new pointer
-  std::shared_ptr<Option> option(new Option(name, "integer", value, lower_bound, upper_bound, description));
-
-  // Add to list
-  option_list_.push_back(option);
-
-  // Return true
-  return true;
+  // Add option
+  return addOption(reporter, std::make_shared<Option>(name, "integer", value, lower_bound, upper_bound, description));
 
 } // end addIntegerOption
 
@@ -150,24 +108,32 @@ bool Options::addStringOption(const Reporter* reporter,
                               std::string description)
 {
 
-  // Check that option with given name doesn't already exist
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      reporter->printf(R_SOLVER, R_BASIC, "Option with name \'%s\' already exists.  Ignoring addition request.\n", name.c_str());
-      return false;
-    } // end if
-  }   // end for
+  // Add option
+  return addOption(reporter, std::make_shared<Option>(name, "string", value, description));
+
+} // end addStringOption
 
-  // Declare new pointer
-  std::shared_ptr<Option> option(new Option(name, "string", value, description));
+// Options: Share schema
+void Options::shareSchema(const Options& other_options)
+{
 
-  // Add to list
-  option_list_.push_back(option);
+  // Share schema, reset modified values
+  schema_ = other_options.schema_;
+  modified_.clear();
 
-  // Return true
-  return true;
+} // end shareSchema
 
-} // end addStringOption
+// Options: Get handle
+int Options::handle(std::string name) const
+{
+
+  // Look up name
+  std::unordered_map<std::string, int>::const_iterator it = schema_->handles.find(name);
+
+  // Return handle (-1 if option not found)
+  return (it == schema_->handles.end()) ? -1 : it->second;
+
+} // end handle
 
 // Options: Get lower bound as a double
 bool Options::lowerBoundAsDouble(const Reporter* reporter,
@@ -175,22 +141,21 @@ bool Options::lowerBoundAsDouble(const Reporter* reporter,
                                  double& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("double") == 0) {
-        value = option_list_[i]->lowerBoundAsDouble();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access lower bound for option \'%s\' as double, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("double") == 0) {
+    value = option(h).lowerBoundAsDouble();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access lower bound for option \'%s\' as double, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end lowerBoundAsDouble
 
@@ -200,22 +165,21 @@ bool Options::lowerBoundAsInteger(const Reporter* reporter,
                                   int& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("integer") == 0) {
-        value = option_list_[i]->lowerBoundAsInteger();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access lower bound for option \'%s\' as integer, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("integer") == 0) {
+    value = option(h).lowerBoundAsInteger();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access lower bound for option \'%s\' as integer, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end lowerBoundAsInteger
 
@@ -225,22 +189,21 @@ bool Options::upperBoundAsDouble(const Reporter* reporter,
                                  double& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("double") == 0) {
-        value = option_list_[i]->upperBoundAsDouble();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access upper bound for option \'%s\' as double, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("double") == 0) {
+    value = option(h).upperBoundAsDouble();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access upper bound for option \'%s\' as double, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end upperBoundAsDouble
 
@@ -250,22 +213,21 @@ bool Options::upperBoundAsInteger(const Reporter* reporter,
                                   int& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("integer") == 0) {
-        value = option_list_[i]->upperBoundAsInteger();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access upper bound for option \'%s\' as integer, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("integer") == 0) {
+    value = option(h).upperBoundAsInteger();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access upper bound for option \'%s\' as integer, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end upperBoundAsInteger
 
@@ -275,22 +237,21 @@ bool Options::valueAsBool(const Reporter* reporter,
                           bool& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("bool") == 0) {
-        value = option_list_[i]->valueAsBool();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as string, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("bool") == 0) {
+    value = option(h).valueAsBool();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as bool, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end valueAsBool
 
@@ -300,22 +261,21 @@ bool Options::valueAsDouble(const Reporter* reporter,
                             double& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("double") == 0) {
-        value = option_list_[i]->valueAsDouble();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as double, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("double") == 0) {
+    value = option(h).valueAsDouble();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as double, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end valueAsDouble
 
@@ -325,22 +285,21 @@ bool Options::valueAsInteger(const Reporter* reporter,
                              int& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("integer") == 0) {
-        value = option_list_[i]->valueAsInteger();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as integer, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("integer") == 0) {
+    value = option(h).valueAsInteger();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as integer, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end valueAsInteger
 
@@ -350,22 +309,21 @@ bool Options::valueAsString(const Reporter* reporter,
                             std::string& value) const
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("string") == 0) {
-        value = option_list_[i]->valueAsString();
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as string, but type is %s.  Returning false.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
   // Return false if option not found
-  return false;
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Get value
+  if (option(h).type().compare("string") == 0) {
+    value = option(h).valueAsString();
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to access value for option \'%s\' as string, but type is %s.  Returning false.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end valueAsString
 
@@ -392,43 +350,39 @@ void Options::modifyOptionsFromFile(const Reporter* reporter,
     // Grab first and second words in line
     iss >> s1 >> s2;
 
-    // Declare bool for name found
-    bool name_found = false;
-
-    // Loop through to find value
-    for (int i = 0; i < (int)option_list_.size(); i++) {
-      if (option_list_[i]->name().compare(s1) == 0) {
-        name_found = true;
-        if (option_list_[i]->type().compare("bool") == 0) {
-          try {
-            modifyBoolValue(reporter, s1, (s2.compare("true") == 0 || s2.compare("1") == 0));
-          } catch (...) {
-            reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but cannot convert \'%s\' to bool.  Ignoring request.\n", s1.c_str(), s2.c_str());
-          }
-        }
-        else if (option_list_[i]->type().compare("double") == 0) {
-          try {
-            modifyDoubleValue(reporter, s1, std::stod(s2));
-          } catch (...) {
-            reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but cannot convert \'%s\' to double.  Ignoring request.\n", s1.c_str(), s2.c_str());
-          }
-        } // end if
-        else if (option_list_[i]->type().compare("integer") == 0) {
-          try {
-            modifyIntegerValue(reporter, s1, (int)std::stod(s2));
-          } catch (...) {
-            reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but cannot convert \'%s\' to int.  Ignoring request.\n", s1.c_str(), s2.c_str());
-          }
-        } // end else if
-        else {
-          modifyStringValue(reporter, s1, s2);
-        }
-      } // end if
-    }   // end for
+    // Find option
+    int h = handle(s1);
 
     // Print message if name not found
-    if (!name_found) {
+    if (h < 0) {
       reporter->printf(R_SOLVER, R_BASIC, "Option with name \'%s\' does not exist.  Ignoring request.\n", s1.c_str());
+      continue;
+    }
+
+    // Modify value
+    if (option(h).type().compare("bool") == 0) {
+      try {
+        modifyBoolValue(reporter, s1, (s2.compare("true") == 0 || s2.compare("1") == 0));
+      } catch (...) {
+        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but cannot convert \'%s\' to bool.  Ignoring request.\n", s1.c_str(), s2.c_str());
+      }
+    }
+    else if (option(h).type().compare("double") == 0) {
+      try {
+        modifyDoubleValue(reporter, s1, std::stod(s2));
+      } catch (...) {
+        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but cannot convert \'%s\' to double.  Ignoring request.\n", s1.c_str(), s2.c_str());
+      }
+    } // end if
+    else if (option(h).type().compare("integer") == 0) {
+      try {
+        modifyIntegerValue(reporter, s1, (int)std::stod(s2));
+      } catch (...) {
+        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but cannot convert \'%s\' to int.  Ignoring request.\n", s1.c_str(), s2.c_str());
+      }
+    } // end else if
+    else {
+      modifyStringValue(reporter, s1, s2);
     }
 
   } // end while
@@ -441,23 +395,22 @@ bool Options::modifyBoolValue(const Reporter* reporter,
                               bool value)
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("bool") == 0) {
-        option_list_[i]->modifyBoolValue(value);
-        reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %s.\n", name.c_str(), (value) ? "true" : "false");
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as bool, but type is %s.  Ignoring request.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
-  // Return false (not found)
-  return false;
+  // Return false if option not found
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Modify value
+  if (option(h).type().compare("bool") == 0) {
+    modifiableOption(h).modifyBoolValue(value);
+    reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %s.\n", name.c_str(), (value) ? "true" : "false");
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as bool, but type is %s.  Ignoring request.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end modifyBoolValue
 
@@ -467,30 +420,29 @@ bool Options::modifyDoubleValue(const Reporter* reporter,
                                 double value)
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("double") == 0) {
-        if (value >= option_list_[i]->lowerBoundAsDouble() &&
-            value <= option_list_[i]->upperBoundAsDouble()) {
-          option_list_[i]->modifyDoubleValue(value);
-          reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %+e.\n", name.c_str(), value);
-          return true;
-        } // end if
-        else {
-          reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but value %+e outside of bound interval \'[%+e,%+e]\'.  Ignoring request.\n", name.c_str(), value, option_list_[i]->lowerBoundAsDouble(), option_list_[i]->upperBoundAsDouble());
-          return false;
-        } // end else
-      }   // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as double, but type is %s.  Ignoring request.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
-  // Return false (not found)
-  return false;
+  // Return false if option not found
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Modify value
+  if (option(h).type().compare("double") == 0) {
+    if (value >= option(h).lowerBoundAsDouble() &&
+        value <= option(h).upperBoundAsDouble()) {
+      modifiableOption(h).modifyDoubleValue(value);
+      reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %+e.\n", name.c_str(), value);
+      return true;
+    } // end if
+    else {
+      reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but value %+e outside of bound interval \'[%+e,%+e]\'.  Ignoring request.\n", name.c_str(), value, option(h).lowerBoundAsDouble(), option(h).upperBoundAsDouble());
+      return false;
+    } // end else
+  }   // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as double, but type is %s.  Ignoring request.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end modifyDoubleValue
 
@@ -500,30 +452,29 @@ bool Options::modifyIntegerValue(const Reporter* reporter,
                                  int value)
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("integer") == 0) {
-        if (value >= option_list_[i]->lowerBoundAsInteger() &&
-            value <= option_list_[i]->upperBoundAsInteger()) {
-          option_list_[i]->modifyIntegerValue(value);
-          reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %d.\n", name.c_str(), value);
-          return true;
-        } // end if
-        else {
-          reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but value %d outside of bound interval \'[%d,%d]\'.  Ignoring request.\n", name.c_str(), value, option_list_[i]->lowerBoundAsInteger(), option_list_[i]->upperBoundAsInteger());
-          return false;
-        } // end else
-      }   // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as integer, but type is %s.  Ignoring request.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
-  // Return false (not found)
-  return false;
+  // Return false if option not found
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Modify value
+  if (option(h).type().compare("integer") == 0) {
+    if (value >= option(h).lowerBoundAsInteger() &&
+        value <= option(h).upperBoundAsInteger()) {
+      modifiableOption(h).modifyIntegerValue(value);
+      reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %d.\n", name.c_str(), value);
+      return true;
+    } // end if
+    else {
+      reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\', but value %d outside of bound interval \'[%d,%d]\'.  Ignoring request.\n", name.c_str(), value, option(h).lowerBoundAsInteger(), option(h).upperBoundAsInteger());
+      return false;
+    } // end else
+  }   // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as integer, but type is %s.  Ignoring request.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end modifyIntegerValue
 
@@ -533,26 +484,67 @@ bool Options::modifyStringValue(const Reporter* reporter,
                                 std::string value)
 {
 
-  // Loop through to find value
-  for (int i = 0; i < (int)option_list_.size(); i++) {
-    if (option_list_[i]->name().compare(name) == 0) {
-      if (option_list_[i]->type().compare("string") == 0) {
-        option_list_[i]->modifyStringValue(value);
-        reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %s.\n", name.c_str(), value.c_str());
-        return true;
-      } // end if
-      else {
-        reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as string, but type is %s.  Ignoring request.\n", name.c_str(), option_list_[i]->type().c_str());
-        return false;
-      } // end else
-    }   // end if
-  }     // end for
-
-  // Return false (not found)
-  return false;
+  // Return false if option not found
+  int h = handle(name);
+  if (h < 0) {
+    return false;
+  }
+
+  // Modify value
+  if (option(h).type().compare("string") == 0) {
+    modifiableOption(h).modifyStringValue(value);
+    reporter->printf(R_SOLVER, R_BASIC, "Set value for option \'%s\' as %s.\n", name.c_str(), value.c_str());
+    return true;
+  } // end if
+  else {
+    reporter->printf(R_SOLVER, R_BASIC, "Attempted to set value for option \'%s\' as string, but type is %s.  Ignoring request.\n", name.c_str(), option(h).type().c_str());
+    return false;
+  } // end else
 
 } // end modifyStringValue
 
+// Options: Get option to modify
+Option& Options::modifiableOption(int handle)
+{
+
+  // Copy option from schema (on first modification)
+  if (handle >= (int)modified_.size()) {
+    modified_.resize(numberOfOptions());
+  }
+  if (!modified_[handle]) {
+    modified_[handle] = schema_->option_list[handle]->makeNewCopy();
+  }
+
+  // Return option
+  return *modified_[handle];
+
+} // end modifiableOption
+
+// Options: Add option
+bool Options::addOption(const Reporter* reporter,
+                        const std::shared_ptr<Option> option)
+{
+
+  // Check that option with given name doesn't already exist
+  if (handle(option->name()) >= 0) {
+    reporter->printf(R_SOLVER, R_BASIC, "Option with name \'%s\' already exists.  Ignoring addition request.\n", option->name().c_str());
+    return false;
+  }
+
+  // Copy schema if shared (so other Options are not affected)
+  if (schema_.use_count() > 1) {
+    schema_ = std::make_shared<Schema>(*schema_);
+  }
+
+  // Add to list
+  schema_->handles[option->name()] = (int)schema_->option_list.size();
+  schema_->option_list.push_back(option);
+
+  // Return true
+  return true;
+
+} // end addOption
+
 ////////////
 // Option //
 ////////////
@@ -584,4 +576,28 @@ void Option::print(const Reporter* reporter) const
 
 } // end print
 
+// Make new copy
+std::shared_ptr<Option> Option::makeNewCopy() const
+{
+
+  // Construct by type, then copy values
+  std::shared_ptr<Option> option;
+  if (type_.compare("double") == 0) {
+    option = std::make_shared<Option>(name_, type_, value_double_, lower_bound_double_, upper_bound_double_, description_);
+  }
+  else if (type_.compare("integer") == 0) {
+    option = std::make_shared<Option>(name_, type_, value_int_, lower_bound_int_, upper_bound_int_, description_);
+  }
+  else if (type_.compare("bool") == 0) {
+    option = std::make_shared<Option>(name_, type_, value_bool_, description_);
+  }
+  else {
+    option = std::make_shared<Option>(name_, type_, value_string_, description_);
+  }
+
+  // Return
+  return option;
+
+} // end makeNewCopy
+
 } // namespace FaRSA
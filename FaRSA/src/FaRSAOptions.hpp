@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "FaRSAReporter.hpp"
@@ -23,6 +24,10 @@ class Option;
 
 /**
  * Options class
+ * (options are defined in a schema (names, types, bounds, default values, and
+ *  descriptions) that may be shared by many Options objects, e.g., built once per
+ *  process for all solvers; modified values are kept per Options object; names are
+ *  looked up in a hash table)
  */
 class Options
 {
@@ -31,9 +36,10 @@ public:
   /** @name Constructors */
   //@{
   /**
-   * Constructor
+   * Constructor (empty schema)
    */
-  Options(){};
+  Options()
+    : schema_(std::make_shared<Schema>()){};
   //@}
 
   /** @name Destructor */
@@ -109,6 +115,21 @@ public:
                        std::string description);
   //@}
 
+  /** @name Schema methods */
+  //@{
+  /**
+   * Share schema of other Options (definitions and default values, not modified values;
+   * modified values are reset to defaults; options added later are not shared)
+   * \param[in] other_options is reference to Options whose schema to share
+   */
+  void shareSchema(const Options& other_options);
+  /**
+   * Get number of options
+   * \return number of options in schema
+   */
+  inline int numberOfOptions() const { return (int)schema_->option_list.size(); };
+  //@}
+
   /** @name Get methods */
   //@{
   /**
@@ -247,9 +268,52 @@ private:
   void operator=(const Options&);
   //@}
 
+  /**
+   * Schema (option definitions with default values; not modified once shared)
+   */
+  struct Schema
+  {
+    std::vector<std::shared_ptr<Option>> option_list; /**< Vector of (pointers to) options */
+    std::unordered_map<std::string, int> handles;     /**< Handles of options by name */
+  };
+
   /** @name Private members */
   //@{
-  std::vector<std::shared_ptr<Option>> option_list_; /**< Vector of (pointers to) options */
+  std::shared_ptr<Schema> schema_;                /**< Schema (possibly shared) */
+  std::vector<std::shared_ptr<Option>> modified_; /**< Modified options by handle (nullptr if default) */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Get handle of option (index in schema, looked up in hash table)
+   * \param[in] name is name of option
+   * \return handle of option, or -1 if option does not exist
+   */
+  int handle(std::string name) const;
+  /**
+   * Get option (modified, if modified; else, from schema)
+   * \param[in] handle is handle of option
+   * \return reference to option
+   */
+  inline const Option& option(int handle) const
+  {
+    return (handle < (int)modified_.size() && modified_[handle]) ? *modified_[handle] : *schema_->option_list[handle];
+  };
+  /**
+   * Get option to modify (copied from schema on first modification)
+   * \param[in] handle is handle of option
+   * \return reference to option
+   */
+  Option& modifiableOption(int handle);
+  /**
+   * Add option to schema (copied first if shared)
+   * \param[in] reporter is pointer to Reporter object from FaRSA
+   * \param[in] option is pointer to option to add
+   * \return indicator of success (true) or failure, i.e., if name exists (false)
+   */
+  bool addOption(const Reporter* reporter,
+                 const std::shared_ptr<Option> option);
   //@}
 
 }; // end Options
@@ -354,6 +418,15 @@ public:
   void print(const Reporter* reporter) const;
   //@}
 
+  /** @name Make methods */
+  //@{
+  /**
+   * Make new Option as a copy
+   * \return is pointer to new Option
+   */
+  std::shared_ptr<Option> makeNewCopy() const;
+  //@}
+
   /** @name Get methods */
   //@{
   /**
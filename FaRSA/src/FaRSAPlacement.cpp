@@ -0,0 +1,103 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <algorithm>
+#include <map>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "FaRSAPlacement.hpp"
+
+namespace FaRSA
+{
+
+// Partition
+void Placement::partition(long long length,
+                          int part,
+                          long long& begin,
+                          long long& end) const
+{
+
+  // Set contiguous part
+  begin = length * part / numberOfThreads();
+  end = length * (part + 1) / numberOfThreads();
+
+} // end partition
+
+// NUMA node of address
+int Placement::numaNode(const void* address)
+{
+
+  // Query node of page (move_pages without target nodes only reports status)
+  long page_size = sysconf(_SC_PAGESIZE);
+  void* page = (void*)((unsigned long)address / page_size * page_size);
+  int status = -1;
+#ifdef SYS_move_pages
+  if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0) {
+    status = -1;
+  }
+#endif
+
+  // Return
+  return (status >= 0) ? status : -1;
+
+} // end numaNode
+
+// Record
+void Placement::record(std::string name,
+                       const void* array,
+                       size_t element_size,
+                       const std::vector<long long>& part_starts)
+{
+
+  // Determine most common node of sampled pages of each part
+  std::vector<int> nodes(numberOfThreads(), -1);
+  for (int t = 0; t < numberOfThreads() && t + 1 < (int)part_starts.size(); t++) {
+    long long length = part_starts[t + 1] - part_starts[t];
+    if (array == nullptr || length <= 0) {
+      continue;
+    }
+    std::map<int, int> counts;
+    int number_of_samples = (int)std::min(length, 16LL);
+    for (int k = 0; k < number_of_samples; k++) {
+      long long index = part_starts[t] + length * k / number_of_samples;
+      counts[numaNode((const char*)array + index * element_size)]++;
+    }
+    int count = 0;
+    for (std::map<int, int>::iterator it = counts.begin(); it != counts.end(); it++) {
+      if (it->second > count) {
+        nodes[t] = it->first;
+        count = it->second;
+      }
+    } // end for
+  }   // end for
+
+  // Store record
+  record_names_.push_back(name);
+  record_nodes_.push_back(nodes);
+
+} // end record
+
+// Print
+void Placement::print(const Reporter* reporter) const
+{
+
+  // Print threads
+  reporter->printf(R_SOLVER, R_BASIC, "Placement (threads: %d, pinned: %s, NUMA node of each thread's part; -1 if unknown):\n", numberOfThreads(), thread_pool_->pinThreads() ? "yes" : "no");
+
+  // Print records
+  for (int i = 0; i < (int)record_names_.size(); i++) {
+    reporter->printf(R_SOLVER, R_BASIC, "  %-30s :", record_names_[i].c_str());
+    for (int t = 0; t < (int)record_nodes_[i].size(); t++) {
+      reporter->printf(R_SOLVER, R_BASIC, " %d", record_nodes_[i][t]);
+    }
+    reporter->printf(R_SOLVER, R_BASIC, "\n");
+  } // end for
+  reporter->printf(R_SOLVER, R_BASIC, "\n");
+
+} // end print
+
+} // namespace FaRSA
@@ -0,0 +1,154 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSAPLACEMENT_HPP__
+#define __FARSAPLACEMENT_HPP__
+
+#include <string>
+#include <vector>
+
+#include "FaRSAReporter.hpp"
+#include "FaRSAThreadPool.hpp"
+
+namespace FaRSA
+{
+
+/**
+ * Forward declarations
+ */
+class Reporter;
+class ThreadPool;
+
+/**
+  * Placement class
+  * (places data in memory for parallel kernels: each array is split into one
+  *  contiguous part per thread and each part is first written by the thread that
+  *  processes it, so that its pages are allocated on the NUMA node of that thread)
+  */
+class Placement
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Constructor
+    * \param[in] thread_pool is pointer to ThreadPool whose threads process the parts
+    */
+  Placement(ThreadPool* thread_pool)
+    : thread_pool_(thread_pool){};
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Destructor
+    */
+  ~Placement(){};
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+    * Get number of threads
+    * \return number of threads (parts per array)
+    */
+  inline int numberOfThreads() const { return thread_pool_->numberOfThreads(); };
+  /**
+    * Get part of range [0,length) (contiguous, nearly equal parts)
+    * \param[in] length is length of range
+    * \param[in] part is part in {0,...,numberOfThreads()-1}
+    * \param[out] begin is first index of part
+    * \param[out] end is index after last index of part
+    */
+  void partition(long long length,
+                 int part,
+                 long long& begin,
+                 long long& end) const;
+  /**
+    * Get NUMA node of page containing address
+    * \param[in] address is address to check
+    * \return node, or -1 if unknown (page not present or query unavailable)
+    */
+  static int numaNode(const void* address);
+  //@}
+
+  /** @name Copy methods */
+  //@{
+  /**
+    * Copy array into new array whose parts are first written by their threads
+    * \param[in] source is array to copy
+    * \param[in] part_starts is vector of numberOfThreads()+1 part boundaries
+    * \return new array (allocated with new[]), or nullptr if source is nullptr
+    */
+  template <typename T>
+  T* placedCopy(const T* source,
+                const std::vector<long long>& part_starts) const
+  {
+    if (source == nullptr) {
+      return nullptr;
+    }
+    T* destination = new T[part_starts.back()];
+    thread_pool_->runOnEachThread([&](int t) {
+      for (long long i = part_starts[t]; i < part_starts[t + 1]; i++) {
+        destination[i] = source[i];
+      }
+    });
+    return destination;
+  };
+  //@}
+
+  /** @name Record methods */
+  //@{
+  /**
+    * Record placement of array (NUMA node of sampled pages of each part)
+    * \param[in] name is name of array
+    * \param[in] array is pointer to array
+    * \param[in] element_size is number of bytes per element
+    * \param[in] part_starts is vector of numberOfThreads()+1 part boundaries (in elements)
+    */
+  void record(std::string name,
+              const void* array,
+              size_t element_size,
+              const std::vector<long long>& part_starts);
+  //@}
+
+  /** @name Print methods */
+  //@{
+  /**
+    * Print recorded placements
+    * \param[in] reporter is pointer to Reporter object from FaRSA
+    */
+  void print(const Reporter* reporter) const;
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Copy constructor
+    */
+  Placement(const Placement&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const Placement&);
+  //@}
+
+  /** @name Private members */
+  //@{
+  ThreadPool* thread_pool_;                        /**< Thread pool */
+  std::vector<std::string> record_names_;          /**< Names of recorded arrays */
+  std::vector<std::vector<int> > record_nodes_;    /**< Nodes of parts of recorded arrays */
+  //@}
+
+}; // end Placement
+
+} // namespace FaRSA
+
+#endif /* __FARSAPLACEMENT_HPP__ */
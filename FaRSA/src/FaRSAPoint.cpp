@@ -6,6 +6,7 @@
 
 #include <cmath>
 
+#include "FaRSABinaryIO.hpp"
 #include "FaRSAPoint.hpp"
 
 namespace FaRSA
@@ -21,8 +22,9 @@ Point::Point(std::shared_ptr<Problem> problem,
     problem_(problem)
 {
 
-  // Declare new vector
+  // Declare new vector (sharing thread pool of input vector)
   std::shared_ptr<Vector> new_vector(new Vector(vector->length()));
+  new_vector->setThreadPool(vector->threadPool());
 
   // Set point's vector
   vector_ = new_vector;
@@ -42,6 +44,69 @@ void Point::print(const Reporter* reporter,
   vector_->print(reporter, name);
 }
 
+// Make new Point as a copy (without evaluated values)
+std::shared_ptr<Point> Point::makeNewCopy() const
+{
+
+  // Create new Point
+  std::shared_ptr<Point> new_point(new Point(problem_, vector_, scale_));
+
+  // Return
+  return new_point;
+
+} // end makeNewCopy
+
+// Read from binary file
+bool Point::readFromBinaryFile(FILE* file)
+{
+
+  // Read vector and scale
+  if (!vector_->readFromBinaryFile(file) || !readBinary(file, scale_)) {
+    return false;
+  }
+
+  // Read objective
+  if (!readBinary(file, objective_evaluated_) || !readBinary(file, objective_)) {
+    return false;
+  }
+
+  // Read gradient
+  if (!readBinary(file, gradient_evaluated_)) {
+    return false;
+  }
+  if (gradient_evaluated_) {
+    gradient_ = std::make_shared<Vector>(vector_->length());
+    gradient_->setThreadPool(vector_->threadPool());
+    return gradient_->readFromBinaryFile(file);
+  }
+  gradient_.reset();
+
+  // Return
+  return true;
+
+} // end readFromBinaryFile
+
+// Write to binary file
+bool Point::writeToBinaryFile(FILE* file) const
+{
+
+  // Write vector, scale, and objective
+  bool success = (vector_->writeToBinaryFile(file) &&
+                  writeBinary(file, scale_) &&
+                  writeBinary(file, objective_evaluated_) &&
+                  writeBinary(file, objective_) &&
+                  writeBinary(file, gradient_evaluated_));
+
+  // Write gradient
+  if (success && gradient_evaluated_) {
+    success = gradient_->writeToBinaryFile(file);
+  }
+
+  // Return
+  return success;
+
+} // end writeToBinaryFile
+
 // Make new Point by adding "scalar1" times this Point's vector to "scalar2" times other Vector
 std::shared_ptr<Point> Point::makeNewLinearCombination(double scalar1,
                                                        double scalar2,
@@ -119,36 +184,26 @@ bool Point::evaluateGradient(Quantities& quantities)
   // Check if gradient has been evaluated already
   if (!gradient_evaluated_) {
 
-    // Declare gradient vector
+    // Declare gradient vector (sharing thread pool of point's vector)
     std::shared_ptr<Vector> gradient(new Vector(vector_->length()));
+    gradient->setThreadPool(vector_->threadPool());
 
     // Set gradient vector
     gradient_ = gradient;
 
-    // Declare temporary array
-    double* g = new double[vector_->length()];
-
     // Set evaluation start time as current time
     clock_t start_time = clock();
 
-    // Evaluate gradient value
-    gradient_evaluated_ = problem_->evaluateGradient(vector_->values(), g);
+    // Evaluate gradient value (into zero gradient vector, so elements not set by problem,
+    // e.g., outside of working groups, are zero)
+    gradient_evaluated_ = problem_->evaluateGradient(vector_->values(), gradient_->valuesModifiable());
 
     // Increment evaluation time
     quantities.incrementEvaluationTime(clock() - start_time);
 
-    // Evaluate gradient value
-    gradient_->copyArray(g);
-
     // Scale
     gradient_->scale(scale_);
 
-    // Delete temporary array
-    if (g != nullptr) {
-      delete[] g;
-      g = nullptr;
-    } // end if
-
     // Check for nan
     for (int i = 0; i < gradient_->length(); i++) {
       if (isnan(gradient_->values()[i])) {
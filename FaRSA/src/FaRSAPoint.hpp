@@ -7,6 +7,7 @@
 #ifndef __FARSAPOINT_HPP__
 #define __FARSAPOINT_HPP__
 
+#include <cstdio>
 #include <memory>
 #include <string>
 
@@ -68,6 +69,24 @@ public:
 
   /** @name Make-new methods */
   //@{
+  /**
+   * Make new Point as a copy (without evaluated values)
+   * \return pointer to new Point
+   */
+  std::shared_ptr<Point> makeNewCopy() const;
+  /**
+   * Read vector, scale, and evaluated values from open binary file
+   * (written by writeToBinaryFile)
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool readFromBinaryFile(FILE* file);
+  /**
+   * Write vector, scale, and evaluated values to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeToBinaryFile(FILE* file) const;
   /**
    * Make new Point by adding "scalar1" times this Point's Vector to "scalar2" times other_vector
    * \param[in] scalar1 is scalar value for linear combination
@@ -7,11 +7,21 @@
 #ifndef __FARSAPROBLEM_HPP__
 #define __FARSAPROBLEM_HPP__
 
+#include <memory>
 #include <vector>
 
+#include "FaRSAPlacement.hpp"
+#include "FaRSAThreadPool.hpp"
+
 namespace FaRSA
 {
 
+/**
+ * Forward declarations
+ */
+class Placement;
+class ThreadPool;
+
 /**
  * Problem class
  */
@@ -48,11 +58,39 @@ public:
    * \return indicator of success (true) or failure (false)
    */
   inline bool numberOfVariables(int& n) { n = number_of_variables_; return true; };
+  /**
+   * Group data
+   * \return reference to vector of groups, each a vector of variable indices
+   */
+  inline const std::vector< std::vector<int> >& groups() const { return groups_; };
   /**
    * Returns initial point
    * \param[out] x is the initial point/iterate, a double array (return value)
    */
   virtual bool initialPoint(double* x) = 0;
+  /**
+   * Returns upper bounds on curvature of objective, independent of point, e.g., from
+   * norms of data computed when data is loaded, for use in initial stepsizes, group-wise
+   * step scaling, and preconditioners (default: not available)
+   * \param[out] variable_bounds is, for each variable, an upper bound on the second
+   *             derivative with respect to the variable, a double array (return value)
+   * \param[out] group_bounds is, for each group, an upper bound on the Lipschitz constant
+   *             of the gradient with respect to the variables of the group, a double
+   *             array (return value)
+   * \return indicator of success (true) or failure/unavailability (false)
+   */
+  virtual bool curvatureBounds(double* variable_bounds,
+                               double* group_bounds) { return false; };
+  /**
+   * Estimates Lipschitz constant of gradient, e.g., by power iteration over products
+   * with data, for use in initial stepsizes (default: not available)
+   * \param[in] groups is a vector of group indices; empty vector indicates all groups,
+   *            otherwise constant of gradient with respect to variables of groups
+   * \param[out] lipschitz_constant is the estimate, a double (return value)
+   * \return indicator of success (true) or failure/unavailability (false)
+   */
+  virtual bool estimateLipschitzConstant(const std::vector<int>& groups,
+                                         double& lipschitz_constant) { return false; };
   //@}
 
   /** @name Evaluate methods */
@@ -67,12 +105,14 @@ public:
   /**
    * Evaluates gradient
    * \param[in] x is a given point/iterate, a constant double array
-   * \param[out] g is the gradient value at "x", a double array (return value)
+   * \param[out] g is the gradient value at "x", a double array (return value); zero on
+   *             entry, so with working groups set, only their elements need to be set
    */
   virtual bool evaluateGradient(const double* x,
                                 double* g) = 0;
   /**
-   * Evaluates Hessian-vector product
+   * Evaluates Hessian-vector product for submatrix of Hessian corresponding to
+   * given groups; "v" and "Hv" are ordered by concatenation of the groups
    * \param[in] x is a given point/iterate, a constant double array
    * \param[in] groups is a vector of group indices
    * \param[in] v is a given vector, a constant double array
@@ -82,6 +122,57 @@ public:
                                             const std::vector<int> groups,
                                             const double* v,
                                             double* Hv) = 0;
+  /**
+   * Evaluates Hessian diagonal (or a positive approximation of it, e.g., for use
+   * as a preconditioner) for given groups; "d" is ordered by concatenation of the
+   * groups (default: not available)
+   * \param[in] x is a given point/iterate, a constant double array
+   * \param[in] groups is a vector of group indices
+   * \param[out] d is the Hessian diagonal at "x", a double array (return value)
+   * \return indicator of success (true) or failure/unavailability (false)
+   */
+  virtual bool evaluateHessianDiagonal(const double* x,
+                                       const std::vector<int> groups,
+                                       double* d) { return false; };
+  //@}
+
+  /** @name Working set methods */
+  //@{
+  /**
+   * Sets working groups; until called again, the solver only requires objective
+   * values for points that are zero outside of the working groups and only
+   * requires gradient elements corresponding to the working groups, so a problem
+   * may restrict its evaluations accordingly (default: ignore, evaluate fully)
+   * \param[in] groups is a vector of group indices; empty vector indicates all groups
+   * \return indicator of success (true) or failure (false)
+   */
+  virtual bool setWorkingGroups(const std::vector<int>& groups) { return true; };
+  //@}
+
+  /** @name Thread pool methods */
+  //@{
+  /**
+   * Sets thread pool owned by the solver; a problem that parallelizes its evaluations
+   * should submit its work to this pool (e.g., by parallelFor or parallelSum) rather
+   * than start threads of its own, so that the machine is not oversubscribed; Vector
+   * and Matrix objects of the problem use it once it is passed to them (see
+   * Vector::setThreadPool and Matrix::setThreadPool) (default: ignore)
+   * \param[in] thread_pool is pointer to ThreadPool
+   * \return indicator of success (true) or failure (false)
+   */
+  virtual bool setThreadPool(std::shared_ptr<ThreadPool> thread_pool) { return true; };
+  //@}
+
+  /** @name Placement methods */
+  //@{
+  /**
+   * Places problem data for parallel kernels, e.g., by Matrix::place and Vector::place,
+   * so that each thread's part is first touched on its NUMA node; placements are
+   * recorded in the given object and reported by the solver (default: no placement)
+   * \param[in] placement is reference to Placement object
+   * \return indicator of success (true) or failure (false)
+   */
+  virtual bool setPlacement(Placement& placement) { return true; };
   //@}
 
   /** @name Finalize methods */
@@ -4,8 +4,10 @@
 //
 // Author(s) : Frank E. Curtis, Daniel P. Robinson
 
+#include <algorithm>
 #include <cmath>
 
+#include "FaRSABinaryIO.hpp"
 #include "FaRSADefinitions.hpp"
 #include "FaRSAQuantities.hpp"
 
@@ -17,10 +19,14 @@ Quantities::Quantities()
   : evaluation_time_(0),
     cpu_time_limit_(FARSA_DOUBLE_INFINITY),
     stepsize_(0.0),
+    lipschitz_estimate_(0.0),
+    lipschitz_estimate_requested_(false),
     function_counter_(0),
     gradient_counter_(0),
     iteration_counter_(0),
     number_of_variables_(0),
+    working_set_active_(false),
+    working_set_expansions_(0),
     scaling_threshold_(1.0),
     function_evaluation_limit_(1),
     gradient_evaluation_limit_(1)
@@ -28,6 +34,7 @@ Quantities::Quantities()
   start_time_ = clock();
   end_time_ = start_time_;
   current_iterate_.reset();
+  previous_iterate_.reset();
   trial_iterate_.reset();
   direction_.reset();
 }
@@ -128,8 +135,27 @@ bool Quantities::initialize(const std::shared_ptr<Problem> problem)
   // Set number of variables
   number_of_variables_ = n;
 
-  // Declare vector
+  // Set groups (each variable in its own group if problem does not define groups)
+  groups_ = problem->groups();
+  if (groups_.size() == 0) {
+    for (int i = 0; i < number_of_variables_; i++) {
+      groups_.push_back(std::vector<int>(1, i));
+    }
+  } // end if
+
+  // Initialize group partition
+  groups_free_.clear();
+  groups_zero_.clear();
+
+  // Initialize working set (inactive until initialized)
+  groups_working_.clear();
+  group_in_working_set_.assign(groups_.size(), false);
+  working_set_active_ = false;
+  working_set_expansions_ = 0;
+
+  // Declare vector (iterates made from it share thread pool)
   std::shared_ptr<Vector> v(new Vector(number_of_variables_));
+  v->setThreadPool(thread_pool_);
 
   // Get initial point
   success = problem->initialPoint(v->valuesModifiable());
@@ -144,18 +170,334 @@ bool Quantities::initialize(const std::shared_ptr<Problem> problem)
 
   // Set initial point
   current_iterate_ = initial_iterate;
+  previous_iterate_.reset();
 
   // Initialize direction
   direction_ = std::make_shared<Vector>(number_of_variables_);
+  direction_->setThreadPool(thread_pool_);
+  direction_point_.reset();
 
   // Initialize stepsize
   stepsize_ = 0.0;
 
+  // Initialize Lipschitz constant estimate (estimated on first request)
+  lipschitz_estimate_ = 0.0;
+  lipschitz_estimate_requested_ = false;
+
   // Return
   return success;
 
 } // end initialize
 
+// Lipschitz constant estimate
+double Quantities::lipschitzEstimate()
+{
+
+  // Estimate Lipschitz constant (once; time counted as evaluation time)
+  if (!lipschitz_estimate_requested_ && current_iterate_ != nullptr) {
+    clock_t start_time = clock();
+    double lipschitz_constant;
+    if (current_iterate_->problem()->estimateLipschitzConstant(std::vector<int>(), lipschitz_constant) && lipschitz_constant > 0.0) {
+      lipschitz_estimate_ = current_iterate_->scale() * lipschitz_constant;
+    }
+    lipschitz_estimate_requested_ = true;
+    evaluation_time_ += clock() - start_time;
+  } // end if
+
+  // Return
+  return lipschitz_estimate_;
+
+} // end lipschitzEstimate
+
+// Read checkpoint
+bool Quantities::readCheckpoint(FILE* file)
+{
+
+  // Read and check problem size
+  int number_of_variables;
+  int number_of_groups;
+  if (!readBinary(file, number_of_variables) || number_of_variables != number_of_variables_ ||
+      !readBinary(file, number_of_groups) || number_of_groups != (int)groups_.size()) {
+    return false;
+  }
+
+  // Read counters
+  if (!readBinary(file, function_counter_) ||
+      !readBinary(file, gradient_counter_) ||
+      !readBinary(file, iteration_counter_)) {
+    return false;
+  }
+
+  // Read times (shift start time so elapsed time includes time before checkpoint)
+  long long elapsed_time;
+  long long evaluation_time;
+  if (!readBinary(file, elapsed_time) || !readBinary(file, evaluation_time)) {
+    return false;
+  }
+  start_time_ = clock() - (clock_t)elapsed_time;
+  evaluation_time_ = (clock_t)evaluation_time;
+
+  // Read stepsize
+  if (!readBinary(file, stepsize_)) {
+    return false;
+  }
+
+  // Read working set
+  int working_set_active;
+  if (!readBinary(file, working_set_active) ||
+      !readBinary(file, working_set_expansions_) ||
+      !readBinary(file, groups_working_)) {
+    return false;
+  }
+  working_set_active_ = (working_set_active != 0);
+  group_in_working_set_.assign(groups_.size(), false);
+  for (int k = 0; k < (int)groups_working_.size(); k++) {
+    if (groups_working_[k] < 0 || groups_working_[k] >= (int)groups_.size()) {
+      return false;
+    }
+    group_in_working_set_[groups_working_[k]] = true;
+  } // end for
+
+  // Read current iterate
+  std::shared_ptr<Point> current_iterate = current_iterate_->makeNewCopy();
+  if (!current_iterate->readFromBinaryFile(file)) {
+    return false;
+  }
+  current_iterate_ = current_iterate;
+
+  // Read previous iterate (if any)
+  int previous_iterate_exists;
+  if (!readBinary(file, previous_iterate_exists)) {
+    return false;
+  }
+  previous_iterate_.reset();
+  if (previous_iterate_exists != 0) {
+    std::shared_ptr<Point> previous_iterate = current_iterate_->makeNewCopy();
+    if (!previous_iterate->readFromBinaryFile(file)) {
+      return false;
+    }
+    previous_iterate_ = previous_iterate;
+  } // end if
+
+  // Set trial iterate
+  trial_iterate_ = current_iterate_;
+
+  // Return
+  return true;
+
+} // end readCheckpoint
+
+// Write checkpoint
+bool Quantities::writeCheckpoint(FILE* file) const
+{
+
+  // Write problem size, counters, times, stepsize, and working set
+  bool success = (writeBinary(file, number_of_variables_) &&
+                  writeBinary(file, (int)groups_.size()) &&
+                  writeBinary(file, function_counter_) &&
+                  writeBinary(file, gradient_counter_) &&
+                  writeBinary(file, iteration_counter_) &&
+                  writeBinary(file, (long long)(clock() - start_time_)) &&
+                  writeBinary(file, (long long)evaluation_time_) &&
+                  writeBinary(file, stepsize_) &&
+                  writeBinary(file, (int)(working_set_active_ ? 1 : 0)) &&
+                  writeBinary(file, working_set_expansions_) &&
+                  writeBinary(file, groups_working_));
+
+  // Write current and previous iterates
+  success = (success && current_iterate_->writeToBinaryFile(file));
+  success = (success && writeBinary(file, (int)(previous_iterate_ ? 1 : 0)));
+  if (success && previous_iterate_) {
+    success = previous_iterate_->writeToBinaryFile(file);
+  }
+
+  // Return
+  return success;
+
+} // end writeCheckpoint
+
+// Partition groups
+void Quantities::partitionGroups()
+{
+
+  // Clear partition
+  groups_free_.clear();
+  groups_zero_.clear();
+
+  // Determine groups that are nonzero
+  const double* x = current_iterate_->vector()->values();
+  std::vector<char> group_free(groups_.size(), 0);
+  forGroups([&](long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+      for (int j = 0; j < (int)groups_[i].size(); j++) {
+        if (x[groups_[i][j]] != 0.0) {
+          group_free[i] = 1;
+          break;
+        }
+      } // end for
+    }   // end for
+  });
+
+  // Add each group to free or zero set
+  for (int i = 0; i < (int)groups_.size(); i++) {
+    if (group_free[i]) {
+      groups_free_.push_back(i);
+    }
+    else {
+      groups_zero_.push_back(i);
+    }
+  } // end for
+
+} // end partitionGroups
+
+// Initialize working set
+void Quantities::initializeWorkingSet(int size,
+                                      double tolerance)
+{
+
+  // Clear working set
+  groups_working_.clear();
+  group_in_working_set_.assign(groups_.size(), false);
+
+  // Add groups that are nonzero at current iterate
+  const double* x = current_iterate_->vector()->values();
+  for (int i = 0; i < (int)groups_.size(); i++) {
+    for (int j = 0; j < (int)groups_[i].size(); j++) {
+      if (x[groups_[i][j]] != 0.0) {
+        groups_working_.push_back(i);
+        group_in_working_set_[i] = true;
+        break;
+      } // end if
+    }   // end for
+  }     // end for
+
+  // Add groups with largest violation
+  addMostViolatingGroups(size, tolerance);
+
+  // Set working set as active
+  working_set_active_ = true;
+
+} // end initializeWorkingSet
+
+// Expand working set
+int Quantities::expandWorkingSet(int size,
+                                 double tolerance)
+{
+
+  // Add groups with largest violation
+  int number_added = addMostViolatingGroups(size, tolerance);
+
+  // Increment expansion counter
+  if (number_added > 0) {
+    working_set_expansions_++;
+  }
+
+  // Return
+  return number_added;
+
+} // end expandWorkingSet
+
+// Mask vector to working set
+bool Quantities::maskToWorkingSet(Vector& vector) const
+{
+
+  // Zero elements outside of working groups
+  bool changed = false;
+  double* values = vector.valuesModifiable();
+  for (int i = 0; i < (int)groups_.size(); i++) {
+    if (!group_in_working_set_[i]) {
+      for (int j = 0; j < (int)groups_[i].size(); j++) {
+        changed = changed || (values[groups_[i][j]] != 0.0);
+        values[groups_[i][j]] = 0.0;
+      }
+    } // end if
+  }   // end for
+
+  // Return
+  return changed;
+
+} // end maskToWorkingSet
+
+// Stationarity measure over working set
+double Quantities::workingSetStationarity() const
+{
+
+  // Compute inf-norm of gradient over working groups
+  const double* g = current_iterate_->gradient()->values();
+  double stationarity = 0.0;
+  for (int k = 0; k < (int)groups_working_.size(); k++) {
+    const std::vector<int>& group = groups_[groups_working_[k]];
+    for (int j = 0; j < (int)group.size(); j++) {
+      stationarity = fmax(stationarity, fabs(g[group[j]]));
+    }
+  } // end for
+
+  // Return
+  return stationarity;
+
+} // end workingSetStationarity
+
+// Add most violating groups
+int Quantities::addMostViolatingGroups(int size,
+                                       double tolerance)
+{
+
+  // Compute violations for groups outside of working set
+  const double* g = current_iterate_->gradient()->values();
+  std::vector<double> violations(groups_.size(), 0.0);
+  forGroups([&](long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+      if (!group_in_working_set_[i]) {
+        for (int j = 0; j < (int)groups_[i].size(); j++) {
+          violations[i] = fmax(violations[i], fabs(g[groups_[i][j]]));
+        }
+      } // end if
+    }   // end for
+  });
+
+  // Set candidates
+  std::vector<std::pair<double, int>> candidates;
+  for (int i = 0; i < (int)groups_.size(); i++) {
+    if (!group_in_working_set_[i] && violations[i] > tolerance) {
+      candidates.push_back(std::make_pair(violations[i], i));
+    }
+  } // end for
+
+  // Determine groups with largest violation
+  int number_to_add = std::min(size, (int)candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + number_to_add, candidates.end(),
+                    [](const std::pair<double, int>& a, const std::pair<double, int>& b) { return a.first > b.first; });
+
+  // Add groups
+  for (int k = 0; k < number_to_add; k++) {
+    groups_working_.push_back(candidates[k].second);
+    group_in_working_set_[candidates[k].second] = true;
+  }
+
+  // Keep working groups sorted (so column views are traversed in order)
+  std::sort(groups_working_.begin(), groups_working_.end());
+
+  // Return
+  return number_to_add;
+
+} // end addMostViolatingGroups
+
+// Run body over groups
+void Quantities::forGroups(const std::function<void(long long, long long)>& body) const
+{
+
+  // Run in parallel (chunks of about equal numbers of variables on average) or serially
+  long long number_of_groups = (long long)groups_.size();
+  if (thread_pool_ && thread_pool_->numberOfThreads() > 1 && number_of_variables_ > FARSA_THREAD_POOL_GRAIN_SIZE) {
+    long long grain_size = std::max(number_of_groups * FARSA_THREAD_POOL_GRAIN_SIZE / number_of_variables_, 1LL);
+    thread_pool_->parallelFor(0, number_of_groups, grain_size, body);
+  }
+  else {
+    body(0, number_of_groups);
+  }
+
+} // end forGroups
+
 // Iteration header string
 std::string Quantities::iterationHeader()
 {
@@ -182,7 +524,10 @@ void Quantities::printIterationValues(const Reporter* reporter)
 {
 
   // Print iteration values
-  reporter->printf(R_SOLVER, R_PER_ITERATION, " %6d %+.4e", iteration_counter_, current_iterate_->objective());
+  FARSA_PRINTF(reporter, R_SOLVER, R_PER_ITERATION, " %6d %+.4e", iteration_counter_, current_iterate_->objective());
+
+  // Record event
+  FARSA_EVENT(reporter, E_ITERATION, iteration_counter_, current_iterate_->objective());
 
 } // end printIterationValues
 
@@ -211,6 +556,15 @@ void Quantities::printFooter(const Reporter* reporter)
                    (end_time_ - start_time_ - evaluation_time_) / (double)CLOCKS_PER_SEC,
                    evaluation_time_ / (double)CLOCKS_PER_SEC);
 
+  // Print working set footer
+  if (working_set_active_) {
+    reporter->printf(R_SOLVER, R_BASIC, "\n"
+                                    "Number of working set groups....... : %d\n"
+                                    "Number of working set expansions... : %d\n",
+                     (int)groups_working_.size(),
+                     working_set_expansions_);
+  } // end if
+
 } // end printFooter
 
 // Finalization
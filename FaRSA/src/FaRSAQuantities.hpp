@@ -7,7 +7,9 @@
 #ifndef __FARSAITERATIONQUANTITIES_HPP__
 #define __FARSAITERATIONQUANTITIES_HPP__
 
+#include <cstdio>
 #include <ctime>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,6 +19,7 @@
 #include "FaRSAPoint.hpp"
 #include "FaRSAProblem.hpp"
 #include "FaRSAReporter.hpp"
+#include "FaRSAThreadPool.hpp"
 #include "FaRSAVector.hpp"
 
 namespace FaRSA
@@ -29,6 +32,7 @@ class Options;
 class Point;
 class Problem;
 class Reporter;
+class ThreadPool;
 class Vector;
 
 /**
@@ -57,12 +61,12 @@ public:
   /** @name Options handling methods */
   //@{
   /**
-   * Add options
+   * Add options (static, so that the option schema is built without an object)
    * \param[in,out] options is pointer to Options object from FaRSA
    * \param[in] reporter is pointer to Reporter object from FaRSA
    */
-  void addOptions(Options* options,
-                  const Reporter* reporter);
+  static void addOptions(Options* options,
+                         const Reporter* reporter);
   /**
    * Set options
    * \param[in] options is pointer to Options object from FaRSA
@@ -112,6 +116,12 @@ public:
    * \return current stepsize
    */
   inline double const stepsize() const { return stepsize_; };
+  /**
+   * Get estimate of Lipschitz constant of gradient of (scaled) objective, estimated by
+   * problem on first request (see Problem::estimateLipschitzConstant)
+   * \return estimate (zero if not available)
+   */
+  double lipschitzEstimate();
   /**
    * Function evaluation counter
    * \return function evaluations performed so far
@@ -142,11 +152,46 @@ public:
    * \return number of variables
    */
   inline int const numberOfVariables() const { return number_of_variables_; };
+  /**
+   * Get number of groups
+   * \return number of groups
+   */
+  inline int const numberOfGroups() const { return (int)groups_.size(); };
+  /**
+   * Get groups
+   * \return reference to vector of groups, each a vector of variable indices
+   */
+  inline const std::vector<std::vector<int>>& groups() const { return groups_; };
+  /**
+   * Get working groups
+   * \return reference to vector of indices of groups in working set
+   */
+  inline const std::vector<int>& groupsWorking() const { return groups_working_; };
+  /**
+   * Get free groups (set by partitionGroups)
+   * \return const reference to indices of groups that are nonzero at current iterate
+   */
+  inline const std::vector<int>& groupsFree() const { return groups_free_; };
+  /**
+   * Get zero groups (set by partitionGroups)
+   * \return const reference to indices of groups that are zero at current iterate
+   */
+  inline const std::vector<int>& groupsZero() const { return groups_zero_; };
+  /**
+   * Get working set indicator
+   * \return indicator of whether working set has been initialized
+   */
+  inline bool const workingSetActive() const { return working_set_active_; };
   /**
    * Get pointer to current iterate
    * \return pointer to Point representing current iterate
    */
   inline std::shared_ptr<Point> currentIterate() { return current_iterate_; };
+  /**
+   * Get pointer to previous iterate
+   * \return pointer to Point representing previous iterate (null in first iteration)
+   */
+  inline std::shared_ptr<Point> previousIterate() { return previous_iterate_; };
   /**
    * Get pointer to trial iterate
    * \return pointer to Point representing trial iterate
@@ -157,6 +202,17 @@ public:
    * \return pointer to Vector representing search direction
    */
   inline std::shared_ptr<Vector> direction() { return direction_; };
+  /**
+   * Get pointer to direction point
+   * \return pointer to Point at a unit step along the direction, with values evaluated by
+   *         the direction computation (null if not computed)
+   */
+  inline std::shared_ptr<Point> directionPoint() { return direction_point_; };
+  /**
+   * Get thread pool
+   * \return pointer to ThreadPool owned by the solver, for parallel work of strategies
+   */
+  inline std::shared_ptr<ThreadPool> threadPool() { return thread_pool_; };
   //@}
 
   /** @name Set methods */
@@ -166,6 +222,10 @@ public:
    * \param[in] iterate is pointer to Point to represent current iterate
    */
   inline void setCurrentIterate(const std::shared_ptr<Point> iterate) { current_iterate_ = iterate; };
+  /**
+   * Set previous iterate pointer to current iterate pointer
+   */
+  inline void setPreviousIterateToCurrentIterate() { previous_iterate_ = current_iterate_; };
   /**
    * Set trial iterate pointer
    * \param[in] trial_iterate is pointer to Point to represent trial iterate
@@ -175,11 +235,23 @@ public:
    * Set trial iterate pointer to current iterate pointer
    */
   inline void setTrialIterateToCurrentIterate() { trial_iterate_ = current_iterate_; };
+  /**
+   * Set direction point pointer (reused by line searches for a unit stepsize)
+   * \param[in] direction_point is pointer to Point at a unit step along the direction
+   *            (null if not computed)
+   */
+  inline void setDirectionPoint(const std::shared_ptr<Point> direction_point) { direction_point_ = direction_point; };
   /**
    * Set stepsize
    * \param[in] stepsize is new value to represent stepsize
    */
   inline void setStepsize(double stepsize) { stepsize_ = stepsize; };
+  /**
+   * Set thread pool
+   * \param[in] thread_pool is pointer to ThreadPool owned by the solver (shared by vectors
+   *            of iterates and direction made by initialize)
+   */
+  inline void setThreadPool(const std::shared_ptr<ThreadPool> thread_pool) { thread_pool_ = thread_pool; };
   //@}
 
   /** @name Increment methods */
@@ -203,6 +275,64 @@ public:
   inline void incrementIterationCounter() { iteration_counter_++; };
   //@}
 
+  /** @name Checkpoint methods */
+  //@{
+  /**
+   * Read quantities (counters, times, stepsize, working set, and current and
+   * previous iterates) from open binary file (written by writeCheckpoint)
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure, e.g., due to inconsistent problem (false)
+   */
+  bool readCheckpoint(FILE* file);
+  /**
+   * Write quantities to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeCheckpoint(FILE* file) const;
+  //@}
+
+  /** @name Group partition methods */
+  //@{
+  /**
+   * Partition groups into free groups (nonzero at the current iterate) and
+   * zero groups (zero at the current iterate)
+   */
+  void partitionGroups();
+  //@}
+
+  /** @name Working set methods */
+  //@{
+  /**
+   * Initialize working set with groups that are nonzero at the current iterate
+   * and (at most) the given number of groups with largest optimality violation
+   * \param[in] size is number of groups to add based on optimality violation
+   * \param[in] tolerance is violation threshold below which groups are not added
+   */
+  void initializeWorkingSet(int size,
+                            double tolerance);
+  /**
+   * Expand working set by (at most) the given number of groups outside of the
+   * working set with largest optimality violation at the current iterate
+   * \param[in] size is maximum number of groups to add
+   * \param[in] tolerance is violation threshold below which groups are not added
+   * \return number of groups added
+   */
+  int expandWorkingSet(int size,
+                       double tolerance);
+  /**
+   * Mask vector to working set, i.e., zero elements outside of working groups
+   * \param[in,out] vector is reference to Vector to mask
+   * \return indicator of whether any element was changed
+   */
+  bool maskToWorkingSet(Vector& vector) const;
+  /**
+   * Stationarity measure restricted to working set
+   * \return inf-norm of gradient at current iterate over working groups
+   */
+  double workingSetStationarity() const;
+  //@}
+
   /** @name Print methods */
   //@{
   /**
@@ -266,15 +396,43 @@ private:
   clock_t start_time_;
   double cpu_time_limit_;
   double stepsize_;
+  double lipschitz_estimate_;
+  bool lipschitz_estimate_requested_;
   int function_counter_;
   int gradient_counter_;
   int iteration_counter_;
   int number_of_variables_;
   std::shared_ptr<Point> current_iterate_;
+  std::shared_ptr<Point> previous_iterate_;
   std::shared_ptr<Point> trial_iterate_;
   std::shared_ptr<Vector> direction_;
+  std::shared_ptr<Point> direction_point_;
+  std::vector<std::vector<int>> groups_;
   std::vector<int> groups_free_;
   std::vector<int> groups_zero_;
+  std::vector<int> groups_working_;
+  std::vector<bool> group_in_working_set_;
+  bool working_set_active_;
+  int working_set_expansions_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Add (at most) the given number of groups outside of the working set with
+   * largest optimality violation at the current iterate
+   * \param[in] size is maximum number of groups to add
+   * \param[in] tolerance is violation threshold below which groups are not added
+   * \return number of groups added
+   */
+  int addMostViolatingGroups(int size,
+                             double tolerance);
+  /**
+   * Run body over groups, in parallel if thread pool is set and there are many variables
+   * \param[in] body is function called as body(begin, end) for ranges of group indices
+   */
+  void forGroups(const std::function<void(long long, long long)>& body) const;
   //@}
 
   /** @name Private members (options) */
@@ -4,6 +4,8 @@
 //
 // Author(s) : Frank E. Curtis, Daniel P. Robinson
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 
@@ -43,6 +45,23 @@ void Reporter::printf(ReportType type,
 
 } // end printf
 
+// Check accepted
+bool Reporter::accepts(ReportType type,
+                       ReportLevel level) const
+{
+
+  // Check every report
+  for (int i = 0; i < (int)reports_.size(); i++) {
+    if (reports_[i]->isAccepted(type, level)) {
+      return true;
+    }
+  } // end for
+
+  // Return
+  return false;
+
+} // end accepts
+
 // Print list
 void Reporter::printList(ReportType type,
                          ReportLevel level,
@@ -94,6 +113,36 @@ bool Reporter::addFileReport(std::string report_name,
 
 } // end addFileReport
 
+// Make reports asynchronous
+void Reporter::makeReportsAsync(int capacity,
+                                ReportFullPolicy policy)
+{
+
+  // Replace reports (that are not asynchronous already)
+  for (int i = 0; i < (int)reports_.size(); i++) {
+    if (!std::dynamic_pointer_cast<AsyncReport>(reports_[i])) {
+      reports_[i] = std::make_shared<AsyncReport>(reports_[i], capacity, policy);
+    }
+  } // end for
+
+} // end makeReportsAsync
+
+// Make reports synchronous
+void Reporter::makeReportsSynchronous()
+{
+
+  // Replace asynchronous reports (after remaining records are written)
+  for (int i = 0; i < (int)reports_.size(); i++) {
+    std::shared_ptr<AsyncReport> temp = std::dynamic_pointer_cast<AsyncReport>(reports_[i]);
+    if (temp) {
+      temp->stop();
+      reports_[i] = temp->report();
+      reports_[i]->setTypeAndLevel(temp->type(), temp->level());
+    } // end if
+  }   // end for
+
+} // end makeReportsSynchronous
+
 // Get report
 std::shared_ptr<Report> Reporter::report(std::string name)
 {
@@ -126,6 +175,17 @@ void Reporter::flushBuffer() const
 
 } // end flushBuffer
 
+// Synchronize
+void Reporter::synchronize() const
+{
+
+  // Synchronize all reports
+  for (int i = 0; i < (int)reports_.size(); i++) {
+    reports_[i]->synchronize();
+  }
+
+} // end synchronize
+
 // Delete reports
 void Reporter::deleteReports()
 {
@@ -289,4 +349,235 @@ void StreamReport::flushBuffer()
 
 } // end flushBuffer
 
+/////////////////
+// AsyncReport //
+/////////////////
+
+// Constructor
+AsyncReport::AsyncReport(const std::shared_ptr<Report> report,
+                         int capacity,
+                         ReportFullPolicy policy)
+  : Report(report->name(), report->type(), report->level()),
+    report_(report),
+    capacity_(std::max(capacity, 1)),
+    policy_(policy),
+    slots_(capacity_),
+    head_(0),
+    tail_(0),
+    flush_requests_(0),
+    flushes_completed_(0),
+    number_of_dropped_records_(0),
+    sleeping_(false),
+    stop_(false)
+{
+
+  // Start writer thread
+  writer_ = std::thread(&AsyncReport::loop, this);
+
+} // end constructor
+
+// Destructor
+AsyncReport::~AsyncReport()
+{
+
+  // Stop writer thread
+  stop();
+
+} // end destructor
+
+// Print list
+void AsyncReport::printList(ReportType type,
+                            ReportLevel level,
+                            const char* format,
+                            va_list lst)
+{
+
+  // Check for stopped writer thread
+  if (!writer_.joinable()) {
+    report_->printList(type, level, format, lst);
+    return;
+  }
+
+  // Format record (truncated to buffer)
+  int length = vsnprintf(buffer_, sizeof(buffer_), format, lst);
+  if (length <= 0) {
+    return;
+  }
+  length = std::min(length, (int)sizeof(buffer_) - 1);
+
+  // Set number of slots for record (at most all slots)
+  unsigned long long number_of_slots = (length + FARSA_ASYNC_REPORT_SLOT_SIZE - 1) / FARSA_ASYNC_REPORT_SLOT_SIZE;
+  if (number_of_slots > (unsigned long long)capacity_) {
+    number_of_slots = capacity_;
+    length = capacity_ * FARSA_ASYNC_REPORT_SLOT_SIZE;
+  }
+
+  // Wait for free slots (or drop record)
+  unsigned long long head = head_.load(std::memory_order_relaxed);
+  while (head + number_of_slots - tail_.load(std::memory_order_acquire) > (unsigned long long)capacity_) {
+    if (policy_ == R_DROP_WHEN_FULL) {
+      number_of_dropped_records_++;
+      return;
+    }
+    wakeWriter();
+    std::this_thread::yield();
+  } // end while
+
+  // Copy record to slots
+  for (unsigned long long k = 0; k < number_of_slots; k++) {
+    Slot& slot = slots_[(head + k) % capacity_];
+    slot.type = type;
+    slot.level = level;
+    slot.length = std::min(length - (int)k * FARSA_ASYNC_REPORT_SLOT_SIZE, FARSA_ASYNC_REPORT_SLOT_SIZE);
+    memcpy(slot.text, buffer_ + k * FARSA_ASYNC_REPORT_SLOT_SIZE, slot.length);
+  } // end for
+
+  // Publish slots
+  head_.store(head + number_of_slots);
+  wakeWriter();
+
+} // end printList
+
+// Flush buffer
+void AsyncReport::flushBuffer()
+{
+
+  // Check for stopped writer thread
+  if (!writer_.joinable()) {
+    report_->flushBuffer();
+    return;
+  }
+
+  // Request flush
+  flush_requests_++;
+  wakeWriter();
+
+} // end flushBuffer
+
+// Synchronize
+void AsyncReport::synchronize()
+{
+
+  // Check for stopped writer thread
+  if (!writer_.joinable()) {
+    report_->synchronize();
+    return;
+  }
+
+  // Request flush and wait until it is served
+  unsigned long long request = ++flush_requests_;
+  wakeWriter();
+  std::unique_lock<std::mutex> lock(mutex_);
+  written_.wait(lock, [&]() { return flushes_completed_.load() >= request; });
+
+} // end synchronize
+
+// Stop
+void AsyncReport::stop()
+{
+
+  // Check for stopped writer thread
+  if (!writer_.joinable()) {
+    return;
+  }
+
+  // Stop writer thread (after remaining records are written)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  writer_.join();
+
+} // end stop
+
+// Close
+void AsyncReport::close()
+{
+
+  // Stop writer thread, then close report
+  stop();
+  report_->close();
+
+} // end close
+
+// Wake writer thread
+void AsyncReport::wakeWriter()
+{
+
+  // Notify while holding mutex (so writer thread does not miss published slots)
+  if (sleeping_.load()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+  }
+
+} // end wakeWriter
+
+// Loop of writer thread
+void AsyncReport::loop()
+{
+
+  // Write records until stopped
+  long long number_of_reported_drops = 0;
+  while (true) {
+
+    // Write published slots (flush requests made before publication are covered)
+    unsigned long long request = flush_requests_.load();
+    unsigned long long head = head_.load();
+    unsigned long long tail = tail_.load(std::memory_order_relaxed);
+    for (; tail < head; tail++) {
+      const Slot& slot = slots_[tail % capacity_];
+      write(slot.type, slot.level, "%.*s", slot.length, slot.text);
+      tail_.store(tail + 1, std::memory_order_release);
+    } // end for
+
+    // Report dropped records
+    long long number_of_drops = number_of_dropped_records_.load();
+    if (number_of_drops > number_of_reported_drops) {
+      write(type(), level(), "\n[%lld records dropped; asynchronous report buffer full]\n", number_of_drops - number_of_reported_drops);
+      number_of_reported_drops = number_of_drops;
+    }
+
+    // Serve flush requests
+    if (request > flushes_completed_.load()) {
+      report_->flushBuffer();
+      std::lock_guard<std::mutex> lock(mutex_);
+      flushes_completed_.store(request);
+      written_.notify_all();
+    } // end if
+
+    // Wait for slots or requests (or stop when all slots are written)
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.store(true);
+    if (stop_ && tail_.load() == head_.load()) {
+      sleeping_.store(false);
+      break;
+    }
+    wake_.wait_for(lock, std::chrono::milliseconds(FARSA_ASYNC_REPORT_WAIT_MILLISECONDS), [&]() {
+      return stop_ || head_.load() != tail_.load() || flush_requests_.load() != flushes_completed_.load();
+    });
+    sleeping_.store(false);
+
+  } // end while
+
+  // Flush report
+  report_->flushBuffer();
+
+} // end loop
+
+// Write text to report
+void AsyncReport::write(ReportType type,
+                        ReportLevel level,
+                        const char* format,
+                        ...)
+{
+
+  // Wrap arguments and pass to report
+  va_list lst;
+  va_start(lst, format);
+  report_->printList(type, level, format, lst);
+  va_end(lst);
+
+} // end write
+
 } // namespace FaRSA
@@ -7,13 +7,42 @@
 #ifndef __FARSAREPORTER_HPP__
 #define __FARSAREPORTER_HPP__
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "FaRSADefinitions.hpp"
 #include "FaRSAEnumerations.hpp"
+#include "FaRSAEventLog.hpp"
+
+/**
+ * Print to reporter only if (type,level) is accepted by a report, so that arguments, e.g.,
+ * norms computed only to be printed, are evaluated only when needed; levels above
+ * FARSA_REPORT_LEVEL_LIMIT are removed at compile time
+ */
+#define FARSA_PRINTF(reporter, type, level, ...)                                        \
+  do {                                                                                  \
+    if ((level) <= FARSA_REPORT_LEVEL_LIMIT && (reporter)->accepts((type), (level))) { \
+      (reporter)->printf((type), (level), __VA_ARGS__);                                 \
+    }                                                                                   \
+  } while (0)
+
+/**
+ * Record event in event log of reporter only if one is set, so that arguments are
+ * evaluated only when needed; removed at compile time unless FARSA_EVENT_LOG_ENABLED
+ */
+#define FARSA_EVENT(reporter, event, ...)                    \
+  do {                                                       \
+    if (FARSA_EVENT_LOG_ENABLED && (reporter)->eventLog()) { \
+      (reporter)->eventLog()->record((event), __VA_ARGS__);  \
+    }                                                        \
+  } while (0)
 
 namespace FaRSA
 {
@@ -22,6 +51,7 @@ namespace FaRSA
  * Forward declarations
  */
 class Report;
+class AsyncReport;
 class FileReport;
 class StreamReport;
 
@@ -60,6 +90,14 @@ public:
               ReportLevel level,
               const char* format,
               ...) const;
+  /**
+    * Check whether (type,level) pair is accepted by any report (see FARSA_PRINTF)
+    * \param[in] type is ReportType of query
+    * \param[in] level is ReportLevel of query
+    * \return true if some report accepts (type,level), false otherwise
+    */
+  bool accepts(ReportType type,
+               ReportLevel level) const;
   //@}
 
   /** @name Add methods */
@@ -84,6 +122,22 @@ public:
                      ReportLevel level);
   //@}
 
+  /** @name Asynchronous methods */
+  //@{
+  /**
+    * Make Reports asynchronous (replace each Report by an AsyncReport writing to it)
+    * \param[in] capacity is number of slots in ring buffer of each AsyncReport
+    * \param[in] policy is ReportFullPolicy of each AsyncReport
+    */
+  void makeReportsAsync(int capacity,
+                        ReportFullPolicy policy);
+  /**
+    * Make Reports synchronous (replace each AsyncReport by the Report to which it
+    * writes, after all of its records have been written)
+    */
+  void makeReportsSynchronous();
+  //@}
+
   /** @name Get methods */
   //@{
   /**
@@ -92,14 +146,32 @@ public:
     * \return pointer to Report with report_name, if it exists; else, it is null
     */
   std::shared_ptr<Report> report(std::string name);
+  /**
+    * Get event log
+    * \return pointer to EventLog (nullptr if none is set)
+    */
+  inline EventLog* eventLog() const { return event_log_.get(); };
+  //@}
+
+  /** @name Set methods */
+  //@{
+  /**
+    * Set event log (see FARSA_EVENT)
+    * \param[in] event_log is pointer to EventLog (nullptr for none)
+    */
+  inline void setEventLog(const std::shared_ptr<EventLog> event_log) { event_log_ = event_log; };
   //@}
 
   /** @name Flush buffer method */
   //@{
   /**
-    * Flush buffer
+    * Flush buffer (does not wait for asynchronous reports)
     */
   void flushBuffer() const;
+  /**
+    * Synchronize (flush buffer and wait until asynchronous reports have written all records)
+    */
+  void synchronize() const;
   //@}
 
   /** @name Delete method */
@@ -128,6 +200,7 @@ private:
   /** @name Private members */
   //@{
   std::vector<std::shared_ptr<Report>> reports_; /**< vector of (pointers to) Reports */
+  std::shared_ptr<EventLog> event_log_;          /**< EventLog (nullptr if none) */
   //@}
 
   /** @name Private methods */
@@ -185,6 +258,16 @@ public:
     * \return is name of Report as string
     */
   inline std::string name() { return name_; };
+  /**
+    * Get type
+    * \return is ReportType of Report
+    */
+  inline ReportType type() const { return type_; };
+  /**
+    * Get level
+    * \return is ReportLevel of Report
+    */
+  inline ReportLevel level() const { return level_; };
   //@}
 
   /** @name Set methods */
@@ -235,6 +318,10 @@ public:
     * Flush buffer
     */
   virtual void flushBuffer() = 0;
+  /**
+    * Synchronize (flush buffer and wait until all printed records are written)
+    */
+  virtual void synchronize() { flushBuffer(); };
   //@}
 
   /** @name Close report method */
@@ -473,6 +560,183 @@ private:
 
 }; // end StreamReport
 
+/**
+  * AsyncReport class
+  * (writes records to another Report on a background writer thread: printList formats
+  *  a record into slots of a lock-free single-producer, single-consumer ring buffer, and
+  *  the writer thread drains the ring, so slow output, e.g., to a network file system,
+  *  does not stall the caller; the ring has a fixed number of slots, so memory is
+  *  bounded, and when it is full the caller blocks or the record is dropped; records
+  *  longer than the format buffer are truncated; printList and flushBuffer should be
+  *  called from one thread at a time)
+  */
+class AsyncReport : public Report
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Construct AsyncReport (starts writer thread); name, type, and level are those of report
+    * \param[in] report is pointer to Report to which records are written
+    * \param[in] capacity is number of slots in ring buffer (each holds up to
+    *            FARSA_ASYNC_REPORT_SLOT_SIZE characters)
+    * \param[in] policy is ReportFullPolicy for when ring buffer is full
+    */
+  AsyncReport(const std::shared_ptr<Report> report,
+              int capacity,
+              ReportFullPolicy policy);
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Delete AsyncReport (writes remaining records, then stops writer thread)
+    */
+  ~AsyncReport();
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+    * Get report
+    * \return pointer to Report to which records are written
+    */
+  inline std::shared_ptr<Report> report() const { return report_; };
+  /**
+    * Get capacity
+    * \return number of slots in ring buffer
+    */
+  inline int capacity() const { return capacity_; };
+  /**
+    * Get policy
+    * \return ReportFullPolicy for when ring buffer is full
+    */
+  inline ReportFullPolicy policy() const { return policy_; };
+  /**
+    * Get number of dropped records
+    * \return number of records dropped since ring buffer was full
+    */
+  inline long long numberOfDroppedRecords() const { return number_of_dropped_records_; };
+  //@}
+
+  /** @name Print method */
+  //@{
+  /**
+    * Print list (format record and push it to ring buffer)
+    * \param[in] type is ReportType at which to print
+    * \param[in] level is ReportLevel at which to print
+    * \param[in] format is formatting string
+    * \param[in] lst is list of strings to print
+    */
+  void printList(ReportType type,
+                 ReportLevel level,
+                 const char* format,
+                 va_list lst);
+  //@}
+
+  /** @name Flush buffer methods */
+  //@{
+  /**
+    * Flush buffer (request writer thread to flush report after writing pushed records;
+    * does not wait)
+    */
+  void flushBuffer();
+  /**
+    * Synchronize (flush buffer and wait until writer thread has written pushed records)
+    */
+  void synchronize();
+  //@}
+
+  /** @name Close report methods */
+  //@{
+  /**
+    * Stop writer thread (after writing remaining records); afterward, records are
+    * written to report directly
+    */
+  void stop();
+  /**
+    * Close report (stop writer thread, then close report)
+    */
+  void close();
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Constructor with no arguments
+    */
+  AsyncReport();
+  /**
+    * Copy constructor
+    */
+  AsyncReport(const AsyncReport&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const AsyncReport&);
+  //@}
+
+  /**
+    * Slot (part of record in ring buffer)
+    */
+  struct Slot
+  {
+    ReportType type;                          /**< ReportType of record */
+    ReportLevel level;                        /**< ReportLevel of record */
+    int length;                               /**< Number of characters in slot */
+    char text[FARSA_ASYNC_REPORT_SLOT_SIZE]; /**< Characters (not null-terminated) */
+  };
+
+  /**
+   * Private members
+   */
+  //@{
+  std::shared_ptr<Report> report_;                    /**< Report to which records are written */
+  int capacity_;                                      /**< Number of slots */
+  ReportFullPolicy policy_;                           /**< Policy for when ring buffer is full */
+  std::vector<Slot> slots_;                           /**< Ring buffer */
+  std::atomic<unsigned long long> head_;              /**< Number of slots pushed (caller) */
+  std::atomic<unsigned long long> tail_;              /**< Number of slots written (writer) */
+  std::atomic<unsigned long long> flush_requests_;    /**< Number of flush requests (caller) */
+  std::atomic<unsigned long long> flushes_completed_; /**< Number of flush requests served (writer) */
+  std::atomic<long long> number_of_dropped_records_;  /**< Number of dropped records */
+  std::atomic<bool> sleeping_;                        /**< Indicator that writer thread waits */
+  bool stop_;                                         /**< Indicator for writer thread to stop */
+  std::mutex mutex_;                                  /**< Mutex for waiting */
+  std::condition_variable wake_;                      /**< Condition for waking writer thread */
+  std::condition_variable written_;                   /**< Condition for served flush requests */
+  std::thread writer_;                                /**< Writer thread */
+  char buffer_[32768];                                /**< Format buffer (caller) */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+    * Wake writer thread (if waiting)
+    */
+  void wakeWriter();
+  /**
+    * Loop of writer thread (write records until stopped)
+    */
+  void loop();
+  /**
+    * Write text to report
+    * \param[in] type is ReportType of text
+    * \param[in] level is ReportLevel of text
+    * \param[in] format is formatting string
+    */
+  void write(ReportType type,
+             ReportLevel level,
+             const char* format,
+             ...);
+  //@}
+
+}; // end AsyncReport
+
 } // namespace FaRSA
 
 #endif /* __FARSAREPORTER_HPP__ */
@@ -4,12 +4,17 @@
 //
 // Author(s) : Frank E. Curtis, Daniel P. Robinson
 
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <iostream>
 
+#include "FaRSABinaryIO.hpp"
 #include "FaRSADeclarations.hpp"
 #include "FaRSADefinitions.hpp"
 #include "FaRSAException.hpp"
+#include "FaRSAMatrix.hpp"
+#include "FaRSAPlacement.hpp"
 #include "FaRSASolver.hpp"
 #include "FaRSAVersion.hpp"
 
@@ -29,8 +34,8 @@ FaRSASolver::FaRSASolver()
   // Add stream report to reporter
   reporter_.addReport(s);
 
-  // Add options
-  addOptions();
+  // Share option schema (built once)
+  options_.shareSchema(optionSchema());
 
 } // end constructor
 
@@ -43,14 +48,108 @@ FaRSASolver::~FaRSASolver()
 
 } // end destructor
 
+// Option schema
+const Options& FaRSASolver::optionSchema()
+{
+
+  // Build schema on first call (thread-safe initialization of static object)
+  static const std::shared_ptr<Options> schema = []() {
+    std::shared_ptr<Options> options = std::make_shared<Options>();
+    Reporter reporter;
+    addOptions(options.get(), &reporter);
+    return options;
+  }();
+
+  // Return schema
+  return *schema;
+
+} // end optionSchema
+
 // Add options
-void FaRSASolver::addOptions()
+void FaRSASolver::addOptions(Options* options,
+                             const Reporter* reporter)
 {
 
   // Add bool options
+  options->addBoolOption(reporter,
+                         "async_output",
+                         false,
+                         "Indicator for whether output is written asynchronously.  If true,\n"
+                         "              then during optimize each report formats its records into a\n"
+                         "              bounded ring buffer (see async_output_capacity) that a\n"
+                         "              background thread writes to the report, so that slow output,\n"
+                         "              e.g., to a network file system, does not stall the algorithm.\n"
+                         "              All records are written by the time optimize returns.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "async_output_drop",
+                         false,
+                         "Indicator for whether records are dropped when the ring buffer of\n"
+                         "              asynchronous output is full.  If true, then such records are\n"
+                         "              dropped (and the number dropped is reported).  If false, then\n"
+                         "              the algorithm waits until the buffer has room.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "checkpoint_resume",
+                         false,
+                         "Indicator for whether to resume from the checkpoint file.  If true\n"
+                         "              and the file given by checkpoint_file exists, then the iterate,\n"
+                         "              counters, stepsize, working set, and strategy states are read\n"
+                         "              from the file and the algorithm continues from that point.  If\n"
+                         "              the file does not exist, then the algorithm starts as usual.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "deterministic_reductions",
+                         false,
+                         "Indicator for whether parallel reductions are deterministic.  If\n"
+                         "              true, then sums (e.g., inner products, norms, and objective\n"
+                         "              terms) are formed from blocks of fixed size combined by pairwise\n"
+                         "              summation, and products that scatter into rows use a fixed number\n"
+                         "              of parts, so that results, and thus iterates, are bitwise\n"
+                         "              identical for any number_of_threads.  If false, then work is\n"
+                         "              split into one part per thread, so that results may differ in\n"
+                         "              rounding for different numbers of threads.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "numa_first_touch",
+                         false,
+                         "Indicator for whether to place problem data for parallel kernels.\n"
+                         "              If true, then the problem's arrays are split into one part per\n"
+                         "              thread (see number_of_threads) and each part is copied by its\n"
+                         "              thread, so that its memory is allocated on the NUMA node of that\n"
+                         "              thread.  The node of each part is printed before the iterations.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "pin_threads",
+                         false,
+                         "Indicator for whether to pin threads to CPUs.  If true, then the\n"
+                         "              t-th thread of the thread pool (the calling thread being the\n"
+                         "              first) is pinned to the t-th CPU allowed for the process, so\n"
+                         "              that it stays on the NUMA node of the data it placed.\n"
+                         "Default     : false.");
+  options->addBoolOption(reporter,
+                         "working_set",
+                         false,
+                         "Indicator for whether to use working set mode.  If true, then\n"
+                         "              the problem is solved restricted to a working set of groups\n"
+                         "              chosen by optimality violation.  Once the restricted problem is\n"
+                         "              solved, the optimality conditions are checked for all other\n"
+                         "              groups, the working set is grown, and the process repeats.\n"
+                         "Default     : false.");
 
   // Add double options
-  options_.addDoubleOption(&reporter_,
+  options->addDoubleOption(reporter,
+                           "checkpoint_time_frequency",
+                           0.0,
+                           0.0,
+                           FARSA_DOUBLE_INFINITY,
+                           "Wall clock time (in seconds) between checkpoints.  If positive,\n"
+                           "              then a checkpoint file is written at the end of the first\n"
+                           "              iteration after this much time has passed since the previous\n"
+                           "              checkpoint (or the start of the run).  If zero, then no\n"
+                           "              checkpoints are written based on time.\n"
+                           "Default     : 0.0.");
+  options->addDoubleOption(reporter,
                            "iterate_norm_tolerance",
                            1e+20,
                            0.0,
@@ -60,7 +159,7 @@ void FaRSASolver::addOptions()
                            "              the maximum of 1.0 and the norm of the initial iterate, then\n"
                            "              the algorithm terminates with a message of divergence.\n"
                            "Default     : 1e+20.");
-  options_.addDoubleOption(&reporter_,
+  options->addDoubleOption(reporter,
                            "stationarity_tolerance",
                            1e-04,
                            0.0,
@@ -71,7 +170,26 @@ void FaRSASolver::addOptions()
                            "Default     : 1e-04.");
 
   // Add integer options
-  options_.addIntegerOption(&reporter_,
+  options->addIntegerOption(reporter,
+                            "async_output_capacity",
+                            4096,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Number of slots in the ring buffer of each report when output is\n"
+                            "              asynchronous.  Each slot holds up to 256 characters (a record\n"
+                            "              may take several slots), so this bounds memory for output.\n"
+                            "Default     : 4096.");
+  options->addIntegerOption(reporter,
+                            "checkpoint_iteration_frequency",
+                            0,
+                            0,
+                            FARSA_INT_INFINITY,
+                            "Number of iterations between checkpoints.  If positive, then a\n"
+                            "              checkpoint file is written at the end of every iteration whose\n"
+                            "              count is a multiple of this number.  If zero, then no\n"
+                            "              checkpoints are written based on iteration count.\n"
+                            "Default     : 0.");
+  options->addIntegerOption(reporter,
                             "iteration_limit",
                             1e+04,
                             0,
@@ -79,12 +197,69 @@ void FaRSASolver::addOptions()
                             "Limit on the number of iterations that will be performed.\n"
                             "              Note that each iteration might involve inner iterations.\n"
                             "Default     : 1e+04.");
+  options->addIntegerOption(reporter,
+                            "number_of_threads",
+                            1,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Number of threads of the thread pool owned by the solver,\n"
+                            "              including the calling thread.  Vector and Matrix operations,\n"
+                            "              group computations, and problems (see Problem::setThreadPool)\n"
+                            "              all run their parallel work on this pool, so the machine is not\n"
+                            "              oversubscribed.  If one, then all operations are serial.\n"
+                            "Default     : 1.");
+  options->addIntegerOption(reporter,
+                            "working_set_initial_size",
+                            1e+02,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Number of groups with largest optimality violation added to the\n"
+                            "              initial working set (in addition to groups that are nonzero\n"
+                            "              at the initial point).  Only used in working set mode.\n"
+                            "Default     : 1e+02.");
+  options->addIntegerOption(reporter,
+                            "working_set_growth_size",
+                            1e+02,
+                            1,
+                            FARSA_INT_INFINITY,
+                            "Maximum number of groups added to the working set each time the\n"
+                            "              restricted problem is solved.  Only used in working set mode.\n"
+                            "Default     : 1e+02.");
+
+  // Add string options
+  options->addStringOption(reporter,
+                           "checkpoint_file",
+                           "farsa.checkpoint",
+                           "Name of binary checkpoint file that is written periodically (see\n"
+                           "              checkpoint_iteration_frequency and checkpoint_time_frequency)\n"
+                           "              and read when resuming (see checkpoint_resume).  The file is\n"
+                           "              first written under a temporary name and then renamed, so an\n"
+                           "              interrupted write does not destroy the previous checkpoint.\n"
+                           "Default     : farsa.checkpoint.");
+  options->addStringOption(reporter,
+                           "event_log_file",
+                           "",
+                           "Name of binary event log file.  If nonempty, then typed records\n"
+                           "              (e.g., iteration number, objective, direction norm, and\n"
+                           "              stepsize of each iteration) are written to the file during\n"
+                           "              optimize, which can be decoded offline, e.g., with\n"
+                           "              decodeEventLog.  If empty, then no event log is written.\n"
+                           "Default     : (empty).");
+  options->addStringOption(reporter,
+                           "solution_file",
+                           "",
+                           "Name of binary vector file.  If nonempty, then the final iterate\n"
+                           "              is written to the file at the end of optimize, which can be\n"
+                           "              reloaded cheaply (memory-mapped) as an initial point for a\n"
+                           "              later run, e.g., through Vector::setFromFile.  If empty, then\n"
+                           "              no solution file is written.\n"
+                           "Default     : (empty).");
 
   // Add options for quantities
-  quantities_.addOptions(&options_, &reporter_);
+  Quantities::addOptions(options, reporter);
 
   // Add options for strategies
-  strategies_.addOptions(&options_, &reporter_);
+  Strategies::addOptions(options, reporter);
 
 } // end addOptions
 
@@ -93,13 +268,31 @@ void FaRSASolver::getOptions()
 {
 
   // Set bool options
+  options_.valueAsBool(&reporter_, "async_output", async_output_);
+  options_.valueAsBool(&reporter_, "async_output_drop", async_output_drop_);
+  options_.valueAsBool(&reporter_, "checkpoint_resume", checkpoint_resume_);
+  options_.valueAsBool(&reporter_, "deterministic_reductions", deterministic_reductions_);
+  options_.valueAsBool(&reporter_, "numa_first_touch", numa_first_touch_);
+  options_.valueAsBool(&reporter_, "pin_threads", pin_threads_);
+  options_.valueAsBool(&reporter_, "working_set", working_set_);
 
   // Set double options
+  options_.valueAsDouble(&reporter_, "checkpoint_time_frequency", checkpoint_time_frequency_);
   options_.valueAsDouble(&reporter_, "iterate_norm_tolerance", iterate_norm_tolerance_);
   options_.valueAsDouble(&reporter_, "stationarity_tolerance", stationarity_tolerance_);
 
   // Set integer options
+  options_.valueAsInteger(&reporter_, "async_output_capacity", async_output_capacity_);
+  options_.valueAsInteger(&reporter_, "checkpoint_iteration_frequency", checkpoint_iteration_frequency_);
   options_.valueAsInteger(&reporter_, "iteration_limit", iteration_limit_);
+  options_.valueAsInteger(&reporter_, "number_of_threads", number_of_threads_);
+  options_.valueAsInteger(&reporter_, "working_set_initial_size", working_set_initial_size_);
+  options_.valueAsInteger(&reporter_, "working_set_growth_size", working_set_growth_size_);
+
+  // Set string options
+  options_.valueAsString(&reporter_, "checkpoint_file", checkpoint_file_);
+  options_.valueAsString(&reporter_, "event_log_file", event_log_file_);
+  options_.valueAsString(&reporter_, "solution_file", solution_file_);
 
   // Set quantities options
   quantities_.getOptions(&options_, &reporter_);
@@ -130,9 +323,42 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
   // (Re)set options
   getOptions();
 
-  // try to run algorithm, terminate on any exception
+  // Make output asynchronous (for this run)
+  if (async_output_) {
+    reporter_.makeReportsAsync(async_output_capacity_, (async_output_drop_ ? R_DROP_WHEN_FULL : R_BLOCK_WHEN_FULL));
+  }
+
+  // Open event log (for this run)
+  if (!event_log_file_.empty()) {
+    std::shared_ptr<EventLog> event_log = std::make_shared<EventLog>();
+    if (event_log->open(event_log_file_)) {
+      reporter_.setEventLog(event_log);
+    }
+    else {
+      reporter_.printf(R_SOLVER, R_BASIC, "Warning: Failed to open event log file '%s'.\n", event_log_file_.c_str());
+    }
+  } // end if
+
+  // try to run algorithm, terminate on any error
   try {
 
+    // Set thread pool (owned by this solver and passed to quantities, whose vectors share
+    // it, and to problem; restarted if settings changed)
+    if (!thread_pool_ || thread_pool_->numberOfThreads() != number_of_threads_ || thread_pool_->pinThreads() != pin_threads_) {
+      thread_pool_.reset();
+      thread_pool_ = std::make_shared<ThreadPool>(number_of_threads_, pin_threads_);
+    }
+    thread_pool_->setDeterministicReductions(deterministic_reductions_);
+    quantities_.setThreadPool(thread_pool_);
+    if (!problem->setThreadPool(thread_pool_)) {
+      THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Setting thread pool failed.");
+    }
+
+    // Evaluate over all groups (clears restriction of a previous run with working set)
+    if (!problem->setWorkingGroups(std::vector<int>())) {
+      THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Setting working groups failed.");
+    }
+
     // (Re)initialize quantities
     bool initialization_success = quantities_.initialize(problem);
 
@@ -141,6 +367,15 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
       THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Initialization failed.");
     }
 
+    // Place problem data (first touch by the thread that processes each part)
+    std::shared_ptr<Placement> placement;
+    if (numa_first_touch_) {
+      placement = std::make_shared<Placement>(thread_pool_.get());
+      if (!problem->setPlacement(*placement)) {
+        THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Placing problem data failed.");
+      }
+    } // end if
+
     // Evaluate all functions at current iterate
     evaluateFunctionsAtCurrentIterate();
 
@@ -156,17 +391,38 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
     // Store norm of initial point (for termination check)
     double initial_iterate_norm = quantities_.currentIterate()->vector()->norm2();
 
+    // Initialize working set
+    if (working_set_) {
+      quantities_.initializeWorkingSet(working_set_initial_size_, stationarity_tolerance_);
+      if (!problem->setWorkingGroups(quantities_.groupsWorking())) {
+        THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Setting working groups failed.");
+      }
+    } // end if
+
     // Initialize strategies
     strategies_.initialize(&options_, &quantities_, &reporter_);
 
     // Print header
     printHeader();
 
+    // Print placement
+    if (placement) {
+      placement->print(&reporter_);
+    }
+
+    // Resume from checkpoint (if requested and checkpoint file exists)
+    if (checkpoint_resume_ && readCheckpoint(problem)) {
+      reporter_.printf(R_SOLVER, R_BASIC, "Resumed from checkpoint file '%s' at iteration %d.\n\n", checkpoint_file_.c_str(), quantities_.iterationCounter());
+    }
+
+    // Initialize time of latest checkpoint
+    std::chrono::steady_clock::time_point checkpoint_time = std::chrono::steady_clock::now();
+
     // Set iteration header
     strategies_.setIterationHeader();
 
-    // (Outer) Loop
-    while (true) {
+    // (Outer) Loop (until status is set)
+    while (status() == FARSA_UNSET) {
 
       // Print iteration header
       printIterationHeader();
@@ -178,17 +434,28 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
       reporter_.flushBuffer();
 
       // Check termination conditions
-      if (quantities_.currentIterate()->vector()->normInf() <= stationarity_tolerance_) {
-        THROW_EXCEPTION(FARSA_SUCCESS_EXCEPTION, "Stationary point found.");
+      if (working_set_) {
+        if (quantities_.workingSetStationarity() <= stationarity_tolerance_ &&
+            !expandWorkingSet(problem)) {
+          setStatus(FARSA_SUCCESS);
+          break;
+        }
+      }
+      else if (quantities_.currentIterate()->gradient()->normInf() <= stationarity_tolerance_) {
+        setStatus(FARSA_SUCCESS);
+        break;
       }
       if (quantities_.iterationCounter() >= iteration_limit_) {
-        THROW_EXCEPTION(FARSA_ITERATION_LIMIT_EXCEPTION, "Iteration limit has been reached.");
+        setStatus(FARSA_ITERATION_LIMIT);
+        break;
       }
       if ((clock() - quantities_.startTime()) / (double)CLOCKS_PER_SEC >= quantities_.cpuTimeLimit()) {
-        THROW_EXCEPTION(FARSA_CPU_TIME_LIMIT_EXCEPTION, "CPU time limit has been reached.");
+        setStatus(FARSA_CPU_TIME_LIMIT);
+        break;
       }
       if (quantities_.currentIterate()->vector()->norm2() >= iterate_norm_tolerance_ * fmax(1.0, initial_iterate_norm)) {
-        THROW_EXCEPTION(FARSA_ITERATE_NORM_LIMIT_EXCEPTION, "Iterates appear to be diverging.");
+        setStatus(FARSA_ITERATE_NORM_LIMIT);
+        break;
       }
 
       // Compute direction
@@ -196,7 +463,13 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
 
       // Check status
       if (strategies_.directionComputation()->status() != DC_SUCCESS) {
-        THROW_EXCEPTION(FARSA_DIRECTION_COMPUTATION_FAILURE_EXCEPTION, "Direction computation failed.");
+        setStatus(FARSA_DIRECTION_COMPUTATION_FAILURE);
+        break;
+      }
+
+      // Restrict direction to working set (direction point is invalid if direction changed)
+      if (working_set_ && quantities_.maskToWorkingSet(*quantities_.direction())) {
+        quantities_.setDirectionPoint(nullptr);
       }
 
       // Run line search
@@ -204,10 +477,12 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
 
       // Check status
       if (strategies_.lineSearch()->status() != LS_SUCCESS) {
-        THROW_EXCEPTION(FARSA_LINE_SEARCH_FAILURE_EXCEPTION, "Line search failed.");
+        setStatus(FARSA_LINE_SEARCH_FAILURE);
+        break;
       }
 
       // Update iterate
+      quantities_.setPreviousIterateToCurrentIterate();
       quantities_.setCurrentIterate(quantities_.trialIterate());
 
       // Increment iteration counter
@@ -216,23 +491,24 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
       // Evaluate all functions at current iterate
       evaluateFunctionsAtCurrentIterate();
 
+      // Write checkpoint (if due by iteration count or time)
+      if ((checkpoint_iteration_frequency_ > 0 && quantities_.iterationCounter() % checkpoint_iteration_frequency_ == 0) ||
+          (checkpoint_time_frequency_ > 0.0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - checkpoint_time).count() >= checkpoint_time_frequency_)) {
+        if (!writeCheckpoint()) {
+          reporter_.printf(R_SOLVER, R_BASIC, "\nWarning: Failed to write checkpoint file '%s'.", checkpoint_file_.c_str());
+        }
+        checkpoint_time = std::chrono::steady_clock::now();
+      } // end if
+
       // Print end of line
-      reporter_.printf(R_SOLVER, R_PER_ITERATION, "\n");
+      FARSA_PRINTF(&reporter_, R_SOLVER, R_PER_ITERATION, "\n");
 
     } // end while
 
   } // end try
 
-  // catch exceptions
-  catch (FARSA_SUCCESS_EXCEPTION& exec) {
-    setStatus(FARSA_SUCCESS);
-  } catch (FARSA_CPU_TIME_LIMIT_EXCEPTION& exec) {
-    setStatus(FARSA_CPU_TIME_LIMIT);
-  } catch (FARSA_ITERATE_NORM_LIMIT_EXCEPTION& exec) {
-    setStatus(FARSA_ITERATE_NORM_LIMIT);
-  } catch (FARSA_ITERATION_LIMIT_EXCEPTION& exec) {
-    setStatus(FARSA_ITERATION_LIMIT);
-  } catch (FARSA_FUNCTION_EVALUATION_LIMIT_EXCEPTION& exec) {
+  // catch exceptions (errors and evaluation limits; normal termination sets status in loop)
+  catch (FARSA_FUNCTION_EVALUATION_LIMIT_EXCEPTION& exec) {
     setStatus(FARSA_FUNCTION_EVALUATION_LIMIT);
   } catch (FARSA_GRADIENT_EVALUATION_LIMIT_EXCEPTION& exec) {
     setStatus(FARSA_GRADIENT_EVALUATION_LIMIT);
@@ -254,10 +530,6 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
     setStatus(FARSA_VECTOR);
   } catch (FARSA_VECTOR_ASSERT_EXCEPTION& exec) {
     setStatus(FARSA_VECTOR_ASSERT);
-  } catch (FARSA_DIRECTION_COMPUTATION_FAILURE_EXCEPTION& exec) {
-    setStatus(FARSA_DIRECTION_COMPUTATION_FAILURE);
-  } catch (FARSA_LINE_SEARCH_FAILURE_EXCEPTION& exec) {
-    setStatus(FARSA_LINE_SEARCH_FAILURE);
   }
 
   // Print end of line
@@ -272,6 +544,15 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
     problem->finalizeSolution(quantities_.currentIterate()->vector()->values(),
                               quantities_.currentIterate()->objective(),
                               quantities_.currentIterate()->gradient()->values());
+
+    // Write solution file
+    if (!solution_file_.empty()) {
+      try {
+        quantities_.currentIterate()->vector()->writeToBinaryFile((char*)solution_file_.c_str());
+      } catch (FARSA_VECTOR_EXCEPTION& exec) {
+        reporter_.printf(R_SOLVER, R_BASIC, "Warning: Failed to write solution file '%s'.\n", solution_file_.c_str());
+      }
+    } // end if
   }
 
   // Finalize
@@ -280,8 +561,90 @@ void FaRSASolver::optimize(const std::shared_ptr<Problem> problem)
   // Print footer
   printFooter();
 
+  // Close event log
+  if (reporter_.eventLog()) {
+    reporter_.eventLog()->close();
+    reporter_.setEventLog(nullptr);
+  }
+
+  // Make output synchronous (all records written)
+  if (async_output_) {
+    reporter_.makeReportsSynchronous();
+  }
+
 } // end optimize
 
+// Read checkpoint
+bool FaRSASolver::readCheckpoint(const std::shared_ptr<Problem> problem)
+{
+
+  // Open file (no checkpoint to resume from if file does not exist)
+  FILE* file = fopen(checkpoint_file_.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  // Read and check header
+  std::string identifier;
+  int version;
+  bool success = (readBinary(file, identifier) && identifier == FARSA_CHECKPOINT_IDENTIFIER &&
+                  readBinary(file, version) && version == FARSA_CHECKPOINT_VERSION);
+
+  // Read quantities and strategy states
+  success = (success && quantities_.readCheckpoint(file));
+  success = (success && strategies_.readState(file));
+
+  // Close file
+  fclose(file);
+
+  // Check for success
+  if (!success || quantities_.workingSetActive() != working_set_) {
+    THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Checkpoint file is inconsistent with problem or options.");
+  }
+
+  // Restrict evaluations to working set
+  if (working_set_ && !problem->setWorkingGroups(quantities_.groupsWorking())) {
+    THROW_EXCEPTION(FARSA_INITIALIZATION_FAILURE_EXCEPTION, "Setting working groups failed.");
+  }
+
+  // Return
+  return true;
+
+} // end readCheckpoint
+
+// Write checkpoint
+bool FaRSASolver::writeCheckpoint()
+{
+
+  // Open temporary file
+  std::string temporary_file = checkpoint_file_ + ".tmp";
+  FILE* file = fopen(temporary_file.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  // Write header, quantities, and strategy states
+  bool success = (writeBinary(file, std::string(FARSA_CHECKPOINT_IDENTIFIER)) &&
+                  writeBinary(file, (int)FARSA_CHECKPOINT_VERSION) &&
+                  quantities_.writeCheckpoint(file) &&
+                  strategies_.writeState(file));
+
+  // Close file
+  success = (fclose(file) == 0 && success);
+
+  // Replace previous checkpoint (rename is atomic, so a preempted write leaves previous checkpoint intact)
+  if (success) {
+    success = (rename(temporary_file.c_str(), checkpoint_file_.c_str()) == 0);
+  }
+  else {
+    remove(temporary_file.c_str());
+  }
+
+  // Return
+  return success;
+
+} // end writeCheckpoint
+
 // Evaluate all functions at current iterate
 void FaRSASolver::evaluateFunctionsAtCurrentIterate()
 {
@@ -304,6 +667,32 @@ void FaRSASolver::evaluateFunctionsAtCurrentIterate()
 
 } // end evaluateFunctionsAtCurrentIterate
 
+// Expand working set
+bool FaRSASolver::expandWorkingSet(const std::shared_ptr<Problem> problem)
+{
+
+  // Evaluate over all groups (problem may restrict evaluations to working groups)
+  if (!problem->setWorkingGroups(std::vector<int>())) {
+    THROW_EXCEPTION(FARSA_GRADIENT_EVALUATION_FAILURE_EXCEPTION, "Setting working groups failed.");
+  }
+
+  // Reevaluate functions at (a copy of) current iterate
+  quantities_.setCurrentIterate(quantities_.currentIterate()->makeNewCopy());
+  evaluateFunctionsAtCurrentIterate();
+
+  // Check optimality conditions outside of working set and grow set
+  int number_added = quantities_.expandWorkingSet(working_set_growth_size_, stationarity_tolerance_);
+
+  // Restrict evaluations to (new) working set
+  if (!problem->setWorkingGroups(quantities_.groupsWorking())) {
+    THROW_EXCEPTION(FARSA_GRADIENT_EVALUATION_FAILURE_EXCEPTION, "Setting working groups failed.");
+  }
+
+  // Return
+  return (number_added > 0);
+
+} // end expandWorkingSet
+
 // Print footer
 void FaRSASolver::printFooter()
 {
@@ -407,9 +796,9 @@ void FaRSASolver::printIterationHeader()
 {
 
   if (quantities_.iterationCounter() == 0) {
-    reporter_.printf(R_SOLVER, R_PER_ITERATION, "\n");
+    FARSA_PRINTF(&reporter_, R_SOLVER, R_PER_ITERATION, "\n");
   }
-  if (quantities_.iterationCounter() % 20 == 0) {
+  if (quantities_.iterationCounter() % 20 == 0 && reporter_.accepts(R_SOLVER, R_PER_ITERATION)) {
     std::string b(quantities_.iterationHeader().length() + strategies_.iterationHeader().length(), '-');
     reporter_.printf(R_SOLVER, R_PER_ITERATION, "%s\n", (b + "\n" + quantities_.iterationHeader() + strategies_.iterationHeader() + "\n" + b).c_str());
   } // end if
@@ -9,6 +9,7 @@
 
 #include <ctime>
 #include <memory>
+#include <string>
 
 #include "FaRSAEnumerations.hpp"
 #include "FaRSAOptions.hpp"
@@ -16,6 +17,7 @@
 #include "FaRSAQuantities.hpp"
 #include "FaRSAReporter.hpp"
 #include "FaRSAStrategies.hpp"
+#include "FaRSAThreadPool.hpp"
 
 namespace FaRSA
 {
@@ -27,6 +29,7 @@ class Options;
 class Problem;
 class Quantities;
 class Reporter;
+class ThreadPool;
 class Strategies;
 
 /**
@@ -150,9 +153,25 @@ private:
 
   /** @name Private members */
   //@{
+  bool async_output_;
+  bool async_output_drop_;
+  bool checkpoint_resume_;
+  bool deterministic_reductions_;
+  bool numa_first_touch_;
+  bool pin_threads_;
+  bool working_set_;
+  double checkpoint_time_frequency_;
   double iterate_norm_tolerance_;
   double stationarity_tolerance_;
+  int async_output_capacity_;
+  int checkpoint_iteration_frequency_;
   int iteration_limit_;
+  int number_of_threads_;
+  int working_set_initial_size_;
+  int working_set_growth_size_;
+  std::string checkpoint_file_;
+  std::string event_log_file_;
+  std::string solution_file_;
   FaRSA_Status status_;
   //@}
 
@@ -162,12 +181,18 @@ private:
   Quantities quantities_;
   Reporter reporter_;
   Strategies strategies_;
+  std::shared_ptr<ThreadPool> thread_pool_;
   //@}
 
   /** @name Private methods */
   //@{
-  void addOptions();
+  static void addOptions(Options* options,
+                         const Reporter* reporter);
+  static const Options& optionSchema();
   void evaluateFunctionsAtCurrentIterate();
+  bool expandWorkingSet(const std::shared_ptr<Problem> problem);
+  bool readCheckpoint(const std::shared_ptr<Problem> problem);
+  bool writeCheckpoint();
   void printFooter();
   void printHeader();
   void printIterationHeader();
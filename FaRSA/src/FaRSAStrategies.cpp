@@ -5,8 +5,13 @@
 // Author(s) : Frank E. Curtis, Daniel P. Robinson
 
 #include "FaRSAStrategies.hpp"
+#include "FaRSABinaryIO.hpp"
+#include "FaRSADirectionComputationAcceleratedProximalGradient.hpp"
+#include "FaRSADirectionComputationLBFGS.hpp"
+#include "FaRSADirectionComputationNewtonCG.hpp"
 #include "FaRSADirectionComputationProximalGradient.hpp"
 #include "FaRSALineSearchBacktracking.hpp"
+#include "FaRSALineSearchNonmonotone.hpp"
 
 namespace FaRSA
 {
@@ -32,12 +37,20 @@ void Strategies::addOptions(Options* options,
   std::shared_ptr<DirectionComputation> direction_computation;
   direction_computation = std::make_shared<DirectionComputationProximalGradient>();
   direction_computation->addOptions(options, reporter);
+  direction_computation = std::make_shared<DirectionComputationAcceleratedProximalGradient>();
+  direction_computation->addOptions(options, reporter);
+  direction_computation = std::make_shared<DirectionComputationLBFGS>();
+  direction_computation->addOptions(options, reporter);
+  direction_computation = std::make_shared<DirectionComputationNewtonCG>();
+  direction_computation->addOptions(options, reporter);
   // ADD NEW DIRECTION COMPUTATION STRATEGIES HERE AND IN SWITCH BELOW //
 
   // Add options for line search strategies
   std::shared_ptr<LineSearch> line_search;
   line_search = std::make_shared<LineSearchBacktracking>();
   line_search->addOptions(options, reporter);
+  line_search = std::make_shared<LineSearchNonmonotone>();
+  line_search->addOptions(options, reporter);
   // ADD NEW LINE SEARCH STRATEGIES HERE AND IN SWITCH BELOW //
 
 } // end addOptions
@@ -59,6 +72,15 @@ void Strategies::getOptions(const Options* options,
   if (direction_computation_name.compare("ProximalGradient") == 0) {
     direction_computation_ = std::make_shared<DirectionComputationProximalGradient>();
   }
+  else if (direction_computation_name.compare("AcceleratedProximalGradient") == 0) {
+    direction_computation_ = std::make_shared<DirectionComputationAcceleratedProximalGradient>();
+  }
+  else if (direction_computation_name.compare("LBFGS") == 0) {
+    direction_computation_ = std::make_shared<DirectionComputationLBFGS>();
+  }
+  else if (direction_computation_name.compare("NewtonCG") == 0) {
+    direction_computation_ = std::make_shared<DirectionComputationNewtonCG>();
+  }
   else {
     direction_computation_ = std::make_shared<DirectionComputationProximalGradient>();
   }
@@ -67,6 +89,9 @@ void Strategies::getOptions(const Options* options,
   if (line_search_name.compare("Backtracking") == 0) {
     line_search_ = std::make_shared<LineSearchBacktracking>();
   }
+  else if (line_search_name.compare("Nonmonotone") == 0) {
+    line_search_ = std::make_shared<LineSearchNonmonotone>();
+  }
   else {
     line_search_ = std::make_shared<LineSearchBacktracking>();
   }
@@ -93,6 +118,35 @@ void Strategies::initialize(const Options* options,
 
 } // end initialize
 
+// Read state
+bool Strategies::readState(FILE* file)
+{
+
+  // Read and check strategy names
+  std::string direction_computation_name;
+  std::string line_search_name;
+  if (!readBinary(file, direction_computation_name) || direction_computation_name != direction_computation_->name() ||
+      !readBinary(file, line_search_name) || line_search_name != line_search_->name()) {
+    return false;
+  }
+
+  // Read strategy states
+  return (direction_computation_->readState(file) && line_search_->readState(file));
+
+} // end readState
+
+// Write state
+bool Strategies::writeState(FILE* file) const
+{
+
+  // Write strategy names and states
+  return (writeBinary(file, direction_computation_->name()) &&
+          writeBinary(file, line_search_->name()) &&
+          direction_computation_->writeState(file) &&
+          line_search_->writeState(file));
+
+} // end writeState
+
 // Set iteration header
 void Strategies::setIterationHeader()
 {
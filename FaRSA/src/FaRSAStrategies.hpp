@@ -7,6 +7,7 @@
 #ifndef __FARSASTRATEGIES_HPP__
 #define __FARSASTRATEGIES_HPP__
 
+#include <cstdio>
 #include <memory>
 #include <string>
 
@@ -48,12 +49,12 @@ public:
   /** @name Options handling methods */
   //@{
   /**
-   * Add options
+   * Add options (static, so that the option schema is built without an object)
    * \param[in,out] options is pointer to Options object from FaRSA
    * \param[in] reporter is pointer to Reporter object from FaRSA
    */
-  void addOptions(Options* options,
-                  const Reporter* reporter);
+  static void addOptions(Options* options,
+                         const Reporter* reporter);
   /**
    * Get options
    * \param[in] options is pointer to Options object from FaRSA
@@ -76,6 +77,22 @@ public:
                   const Reporter* reporter);
   //@}
 
+  /** @name Checkpoint methods */
+  //@{
+  /**
+   * Read strategy names and states from open binary file (written by writeState)
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure, e.g., due to different strategies (false)
+   */
+  bool readState(FILE* file);
+  /**
+   * Write strategy names and states to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeState(FILE* file) const;
+  //@}
+
   /** @name Get methods */
   //@{
   /**
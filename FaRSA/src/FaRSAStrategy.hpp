@@ -7,6 +7,7 @@
 #ifndef __FARSASTRATEGY_HPP__
 #define __FARSASTRATEGY_HPP__
 
+#include <cstdio>
 #include <string>
 
 #include "FaRSAOptions.hpp"
@@ -85,6 +86,23 @@ public:
   virtual std::string name() = 0;
   //@}
 
+  /** @name Checkpoint methods */
+  //@{
+  /**
+   * Read strategy state from open binary file (default: no state)
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  virtual bool readState(FILE* file) { return true; };
+  /**
+   * Write strategy state (e.g., quasi-Newton history) to open binary file
+   * (default: no state)
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  virtual bool writeState(FILE* file) const { return true; };
+  //@}
+
 private:
   /** @name Default compiler generated methods
    * (Hidden to avoid implicit creation/calling.)
@@ -0,0 +1,435 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "FaRSADefinitions.hpp"
+#include "FaRSATextParser.hpp"
+
+namespace FaRSA
+{
+
+// Constructor
+TextParser::TextParser()
+  : mapped_data_(nullptr),
+    mapped_length_(0),
+    position_(nullptr),
+    end_(nullptr),
+    released_(nullptr),
+    tail_read_(false) {}
+
+// Destructor
+TextParser::~TextParser()
+{
+
+  // Unmap file
+  if (mapped_data_ != nullptr) {
+    munmap(mapped_data_, mapped_length_);
+    mapped_data_ = nullptr;
+  }
+
+} // end destructor
+
+// Open file
+bool TextParser::open(const char* file_name)
+{
+
+  // Open file
+  int file_descriptor = ::open(file_name, O_RDONLY);
+  if (file_descriptor < 0) {
+    return false;
+  }
+
+  // Get file length
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0) {
+    close(file_descriptor);
+    return false;
+  }
+
+  // Map file (mapping persists after file is closed; empty file is not mapped)
+  size_t mapped_length = (size_t)file_status.st_size;
+  void* mapped_data = nullptr;
+  if (mapped_length > 0) {
+    mapped_data = mmap(nullptr, mapped_length, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  }
+  close(file_descriptor);
+  if (mapped_data == MAP_FAILED) {
+    return false;
+  }
+
+  // Advise kernel of sequential access (enables aggressive read-ahead)
+  if (mapped_data != nullptr) {
+    madvise(mapped_data, mapped_length, MADV_SEQUENTIAL);
+  }
+
+  // Replace previous mapping
+  if (mapped_data_ != nullptr) {
+    munmap(mapped_data_, mapped_length_);
+  }
+  mapped_data_ = mapped_data;
+  mapped_length_ = mapped_length;
+
+  // Set characters to parse in mapping (up to last whitespace, so numbers are never
+  // parsed past end of mapping) and tail (after last whitespace)
+  const char* begin = (const char*)mapped_data_;
+  const char* end = begin + mapped_length_;
+  while (end > begin && !isspace((unsigned char)end[-1])) {
+    end--;
+  }
+  position_ = begin;
+  end_ = end;
+  released_ = begin;
+  tail_.assign(end, begin + mapped_length_);
+  tail_read_ = false;
+
+  // Return
+  return true;
+
+} // end open
+
+// Read integer
+bool TextParser::readInteger(long long& value)
+{
+
+  // Skip whitespace
+  while (position_ < end_ && isspace((unsigned char)*position_)) {
+    position_++;
+  }
+
+  // Read from mapping
+  char* number_end;
+  if (position_ < end_) {
+    value = strtoll(position_, &number_end, 10);
+    if (number_end == position_) {
+      return false;
+    }
+    position_ = number_end;
+    return true;
+  } // end if
+
+  // Read from tail
+  if (!tail_read_ && !tail_.empty()) {
+    tail_read_ = true;
+    value = strtoll(tail_.c_str(), &number_end, 10);
+    return (number_end != tail_.c_str());
+  } // end if
+
+  // Return
+  return false;
+
+} // end readInteger
+
+// Read number
+bool TextParser::readNumber(double& value)
+{
+
+  // Skip whitespace
+  while (position_ < end_ && isspace((unsigned char)*position_)) {
+    position_++;
+  }
+
+  // Read from mapping
+  const char* number_end;
+  if (position_ < end_) {
+    value = parseNumber(position_, number_end);
+    if (number_end == position_) {
+      return false;
+    }
+    position_ = number_end;
+    releaseRead();
+    return true;
+  } // end if
+
+  // Read from tail
+  if (!tail_read_ && !tail_.empty()) {
+    tail_read_ = true;
+    value = parseNumber(tail_.c_str(), number_end);
+    return (number_end != tail_.c_str());
+  } // end if
+
+  // Return
+  return false;
+
+} // end readNumber
+
+// Skip number
+bool TextParser::skipNumber()
+{
+
+  // Skip whitespace
+  while (position_ < end_ && isspace((unsigned char)*position_)) {
+    position_++;
+  }
+
+  // Skip characters of number in mapping
+  if (position_ < end_) {
+    while (position_ < end_ && !isspace((unsigned char)*position_)) {
+      position_++;
+    }
+    releaseRead();
+    return true;
+  } // end if
+
+  // Skip tail
+  if (!tail_read_ && !tail_.empty()) {
+    tail_read_ = true;
+    return true;
+  }
+
+  // Return
+  return false;
+
+} // end skipNumber
+
+// Read line
+bool TextParser::readLine(std::string& line)
+{
+
+  // Check for end of file
+  if (position_ >= end_ && (tail_read_ || tail_.empty())) {
+    return false;
+  }
+
+  // Read from mapping, up to end of line
+  const char* line_end = (const char*)memchr(position_, '\n', end_ - position_);
+  if (line_end != nullptr) {
+    line.assign(position_, line_end);
+    position_ = line_end + 1;
+    return true;
+  } // end if
+
+  // Read from mapping and tail (no end of line before end of file)
+  line.assign(position_, end_);
+  if (!tail_read_) {
+    line += tail_;
+  }
+  position_ = end_;
+  tail_read_ = true;
+
+  // Return
+  return true;
+
+} // end readLine
+
+// Read records
+long long TextParser::readRecords(long long number_of_records,
+                                  int number_of_fields,
+                                  const std::function<void(long long, const double*)>& store,
+                                  ThreadPool* thread_pool)
+{
+
+  // Set chunk boundaries (at whitespace, e.g., line boundaries, so no number is split)
+  long long length = end_ - position_;
+  int number_of_chunks = (int)(1 + length / FARSA_TEXT_PARSER_CHUNK_SIZE);
+  std::vector<const char*> chunk_starts(number_of_chunks + 1);
+  chunk_starts[0] = position_;
+  for (int k = 1; k < number_of_chunks; k++) {
+    const char* start = std::max(position_ + k * (length / number_of_chunks), chunk_starts[k - 1]);
+    while (start < end_ && !isspace((unsigned char)*start)) {
+      start++;
+    }
+    chunk_starts[k] = start;
+  } // end for
+  chunk_starts[number_of_chunks] = end_;
+
+  // Set function to run body over chunks (on thread pool, if set, or on a pool started
+  // for this read, if there are several chunks, otherwise serially)
+  std::unique_ptr<ThreadPool> local_thread_pool;
+  if (thread_pool == nullptr && number_of_chunks > 1) {
+    int number_of_threads = std::min((int)std::thread::hardware_concurrency(), number_of_chunks);
+    if (number_of_threads > 1) {
+      local_thread_pool.reset(new ThreadPool(number_of_threads, false));
+      thread_pool = local_thread_pool.get();
+    }
+  } // end if
+  auto run = [&](const std::function<void(long long, long long)>& body) {
+    if (thread_pool != nullptr && number_of_chunks > 1) {
+      thread_pool->parallelFor(0, number_of_chunks, 1, body);
+    }
+    else {
+      body(0, number_of_chunks);
+    }
+  };
+
+  // Parse chunks, then tail (as last chunk)
+  std::vector<std::vector<double> > chunk_values(number_of_chunks + 1);
+  std::vector<char> chunk_complete(number_of_chunks + 1, 1);
+  run([&](long long chunk_begin, long long chunk_end) {
+    for (long long k = chunk_begin; k < chunk_end; k++) {
+      chunk_complete[k] = parseChunk(chunk_starts[k], chunk_starts[k + 1], chunk_values[k]);
+    }
+  });
+  if (!tail_read_) {
+    chunk_complete[number_of_chunks] = parseChunk(tail_.c_str(), tail_.c_str() + tail_.size(), chunk_values[number_of_chunks]);
+  }
+  position_ = end_;
+  tail_read_ = true;
+
+  // Set offsets of chunks (numbers after first invalid number are ignored)
+  std::vector<long long> chunk_offsets(number_of_chunks + 2, 0);
+  int number_of_used_chunks = number_of_chunks + 1;
+  for (int k = 0; k <= number_of_chunks; k++) {
+    chunk_offsets[k + 1] = chunk_offsets[k] + (long long)chunk_values[k].size();
+    if (!chunk_complete[k]) {
+      number_of_used_chunks = k + 1;
+      break;
+    }
+  } // end for
+  long long number_of_records_read = std::min(chunk_offsets[number_of_used_chunks] / number_of_fields, number_of_records);
+
+  // Store records, each by chunk with its first number (a record may continue in later chunks)
+  auto store_chunk = [&](long long chunk_begin, long long chunk_end) {
+    std::vector<double> fields(number_of_fields);
+    for (long long k = chunk_begin; k < chunk_end && k < number_of_used_chunks; k++) {
+      long long record_begin = (chunk_offsets[k] + number_of_fields - 1) / number_of_fields;
+      long long record_end = std::min((chunk_offsets[k + 1] + number_of_fields - 1) / number_of_fields, number_of_records_read);
+      for (long long record = record_begin; record < record_end; record++) {
+        long long chunk = k;
+        long long index = record * number_of_fields - chunk_offsets[k];
+        for (int field = 0; field < number_of_fields; field++, index++) {
+          while (index >= (long long)chunk_values[chunk].size()) {
+            index -= (long long)chunk_values[chunk].size();
+            chunk++;
+          }
+          fields[field] = chunk_values[chunk][index];
+        } // end for
+        store(record, fields.data());
+      } // end for
+    }   // end for
+  };
+  run(store_chunk);
+  store_chunk(number_of_chunks, number_of_chunks + 1);
+
+  // Return
+  return number_of_records_read;
+
+} // end readRecords
+
+// Release read pages
+void TextParser::releaseRead()
+{
+
+  // Release whole pages before position, once a chunk has been read
+  if (position_ - released_ < FARSA_TEXT_PARSER_CHUNK_SIZE) {
+    return;
+  }
+  long page_size = sysconf(_SC_PAGESIZE);
+  const char* release_end = (const char*)mapped_data_ + (position_ - (const char*)mapped_data_) / page_size * page_size;
+  const char* release_begin = (const char*)mapped_data_ + (released_ - (const char*)mapped_data_) / page_size * page_size;
+  madvise((void*)release_begin, (size_t)(release_end - release_begin), MADV_DONTNEED);
+  released_ = release_end;
+
+} // end releaseRead
+
+// Parse chunk
+bool TextParser::parseChunk(const char* begin,
+                            const char* end,
+                            std::vector<double>& values)
+{
+
+  // Parse numbers until end or invalid number
+  const char* position = begin;
+  while (true) {
+    while (position < end && isspace((unsigned char)*position)) {
+      position++;
+    }
+    if (position >= end) {
+      return true;
+    }
+    const char* number_end;
+    double value = parseNumber(position, number_end);
+    if (number_end == position) {
+      return false;
+    }
+    values.push_back(value);
+    position = number_end;
+  } // end while
+
+} // end parseChunk
+
+// Parse number
+double TextParser::parseNumber(const char* position,
+                               const char*& number_end)
+{
+
+  // Powers of ten that are exact in double precision
+  static const double powers_of_ten[] = {1e+00, 1e+01, 1e+02, 1e+03, 1e+04, 1e+05, 1e+06, 1e+07,
+                                         1e+08, 1e+09, 1e+10, 1e+11, 1e+12, 1e+13, 1e+14, 1e+15,
+                                         1e+16, 1e+17, 1e+18, 1e+19, 1e+20, 1e+21, 1e+22};
+
+  // Read sign, digits (at most 19 significant digits), and exponent
+  const char* p = position;
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+') {
+    p++;
+  }
+  unsigned long long mantissa = 0;
+  int number_of_digits = 0;
+  int number_of_significant_digits = 0;
+  int exponent = 0;
+  for (; *p >= '0' && *p <= '9'; p++, number_of_digits++) {
+    if (mantissa > 0 || *p != '0') {
+      mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+      number_of_significant_digits++;
+    }
+  } // end for
+  if (*p == '.') {
+    for (p++; *p >= '0' && *p <= '9'; p++, number_of_digits++, exponent--) {
+      if (mantissa > 0 || *p != '0') {
+        mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+        number_of_significant_digits++;
+      }
+    } // end for
+  }   // end if
+  if (number_of_digits > 0 && (*p == 'e' || *p == 'E')) {
+    const char* exponent_start = p++;
+    bool exponent_negative = (*p == '-');
+    if (*p == '-' || *p == '+') {
+      p++;
+    }
+    int exponent_value = 0;
+    for (; *p >= '0' && *p <= '9' && exponent_value < 10000; p++) {
+      exponent_value = exponent_value * 10 + (*p - '0');
+    }
+    exponent += (exponent_negative ? -exponent_value : exponent_value);
+    if (p == exponent_start + 1 || (p == exponent_start + 2 && (exponent_start[1] == '-' || exponent_start[1] == '+'))) {
+      number_of_digits = 0;
+    }
+  } // end if
+
+  // Compute value exactly rounded if mantissa and power of ten are exact (Clinger's fast
+  // path) and number ends at whitespace, otherwise use strtod (e.g., for long mantissas,
+  // large exponents, hexadecimal numbers, infinity, and nan)
+  if (number_of_digits > 0 && number_of_significant_digits <= 19 && (*p == '\0' || isspace((unsigned char)*p))) {
+    if (mantissa == 0) {
+      number_end = p;
+      return (negative ? -0.0 : 0.0);
+    }
+    if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+      double value = (double)mantissa;
+      value = (exponent >= 0) ? value * powers_of_ten[exponent] : value / powers_of_ten[-exponent];
+      number_end = p;
+      return (negative ? -value : value);
+    }
+  } // end if
+  char* strtod_end;
+  double value = strtod(position, &strtod_end);
+  number_end = strtod_end;
+  return value;
+
+} // end parseNumber
+
+} // namespace FaRSA
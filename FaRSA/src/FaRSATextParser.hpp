@@ -0,0 +1,150 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSATEXTPARSER_HPP__
+#define __FARSATEXTPARSER_HPP__
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FaRSAThreadPool.hpp"
+
+namespace FaRSA
+{
+
+/**
+  * TextParser class
+  * (parser of whitespace-separated numbers in a memory-mapped text file: header values
+  *  are read serially, then records are read in parallel by splitting the rest of the
+  *  file into chunks on line boundaries, parsing each chunk on a thread, and storing
+  *  records in file order; as with fscanf, reading stops at the first invalid number)
+  */
+class TextParser
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Constructor
+    */
+  TextParser();
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Destructor (unmaps file)
+    */
+  ~TextParser();
+  //@}
+
+  /** @name Read methods */
+  //@{
+  /**
+    * Open (map) file
+    * \param[in] file_name is name of file to read
+    * \return indicator of success (true) or failure (false)
+    */
+  bool open(const char* file_name);
+  /**
+    * Read integer (serially, e.g., for header)
+    * \param[out] value is value read
+    * \return indicator of success (true) or failure (false)
+    */
+  bool readInteger(long long& value);
+  /**
+    * Read number (serially)
+    * \param[out] value is value read
+    * \return indicator of success (true) or failure (false)
+    */
+  bool readNumber(double& value);
+  /**
+    * Skip number (serially, without parsing it)
+    * \return indicator of success (true) or failure, i.e., at end of file (false)
+    */
+  bool skipNumber();
+  /**
+    * Read rest of line (serially, e.g., for header or comment lines)
+    * \param[out] line is line read (without end of line)
+    * \return indicator of success (true) or failure, i.e., at end of file (false)
+    */
+  bool readLine(std::string& line);
+  /**
+    * Read records (in parallel if file is large) from rest of file
+    * \param[in] number_of_records is maximum number of records to read
+    * \param[in] number_of_fields is number of numbers per record
+    * \param[in] store is function called as store(record, fields) for each record read,
+    *            possibly concurrently for different records
+    * \param[in] thread_pool is pointer to pool on which to parse chunks (if nullptr,
+    *            a pool is started for large files)
+    * \return number of (complete) records read
+    */
+  long long readRecords(long long number_of_records,
+                        int number_of_fields,
+                        const std::function<void(long long, const double*)>& store,
+                        ThreadPool* thread_pool);
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Copy constructor
+    */
+  TextParser(const TextParser&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const TextParser&);
+  //@}
+
+  /** @name Private members */
+  //@{
+  void* mapped_data_;    /**< Memory-mapped file */
+  size_t mapped_length_; /**< Length of memory-mapped file */
+  const char* position_; /**< Position of next character to read */
+  const char* end_;      /**< End of mapped characters to parse (after last whitespace) */
+  const char* released_; /**< Start of mapped characters not released (by serial reads) */
+  std::string tail_;     /**< Characters after last whitespace (parsed from NUL-terminated copy) */
+  bool tail_read_;       /**< Indicator of tail read (by readInteger) */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+    * Release pages of mapping before position, if a chunk has been read serially since
+    * last release (so resident memory of serial reads stays bounded)
+    */
+  void releaseRead();
+  /**
+    * Parse numbers in [begin,end), which must end with whitespace or NUL
+    * \param[in] begin is first character
+    * \param[in] end is character after last character
+    * \param[out] values is vector of numbers parsed
+    * \return true if all numbers were parsed, false if an invalid number was found
+    */
+  static bool parseChunk(const char* begin,
+                         const char* end,
+                         std::vector<double>& values);
+  /**
+    * Parse number (as strtod, with exact fast path for short decimal numbers)
+    * \param[in] position is first character of number
+    * \param[out] number_end is character after number (position if no number parsed)
+    * \return number parsed
+    */
+  static double parseNumber(const char* position,
+                            const char*& number_end);
+  //@}
+
+}; // end TextParser
+
+} // namespace FaRSA
+
+#endif /* __FARSATEXTPARSER_HPP__ */
@@ -0,0 +1,391 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include <algorithm>
+#include <pthread.h>
+
+#include "FaRSAThreadPool.hpp"
+
+namespace FaRSA
+{
+
+// Indicator that calling thread is running a task (of any pool)
+static thread_local bool in_task = false;
+
+// Constructor
+ThreadPool::ThreadPool(int number_of_threads,
+                       bool pin_threads)
+  : number_of_threads_(std::max(number_of_threads, 1)),
+    pin_threads_(pin_threads),
+    deterministic_reductions_(false),
+    stop_(false),
+    number_of_tasks_(0)
+{
+
+  // Set allowed CPUs
+  CPU_ZERO(&caller_cpu_set_);
+  if (sched_getaffinity(0, sizeof(caller_cpu_set_), &caller_cpu_set_) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &caller_cpu_set_)) {
+        cpus_.push_back(cpu);
+      }
+    } // end for
+  }   // end if
+
+  // Create workers
+  for (int t = 0; t < number_of_threads_; t++) {
+    workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    workers_[t]->number_of_bound_tasks = 0;
+  }
+
+  // Pin calling thread
+  if (pin_threads_) {
+    pin(0);
+  }
+
+  // Start threads
+  for (int t = 1; t < number_of_threads_; t++) {
+    threads_.push_back(std::thread(&ThreadPool::loop, this, t));
+  }
+
+} // end constructor
+
+// Destructor
+ThreadPool::~ThreadPool()
+{
+
+  // Stop threads
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (int t = 0; t < (int)threads_.size(); t++) {
+    threads_[t].join();
+  }
+
+  // Restore affinity of calling thread
+  if (pin_threads_ && cpus_.size() > 0) {
+    pthread_setaffinity_np(pthread_self(), sizeof(caller_cpu_set_), &caller_cpu_set_);
+  }
+
+} // end destructor
+
+// Parallel for
+void ThreadPool::parallelFor(long long begin,
+                             long long end,
+                             long long grain_size,
+                             const std::function<void(long long, long long)>& body)
+{
+
+  // Check for empty range
+  if (end <= begin) {
+    return;
+  }
+
+  // Set number of chunks
+  grain_size = std::max(grain_size, 1LL);
+  long long number_of_chunks = (end - begin + grain_size - 1) / grain_size;
+
+  // Check for serial run
+  if (serial() || number_of_chunks == 1) {
+    body(begin, end);
+    return;
+  }
+
+  // Queue chunks, contiguous blocks of chunks per thread
+  std::shared_ptr<Job> job(new Job());
+  job->remaining = number_of_chunks;
+  for (long long c = 0; c < number_of_chunks; c++) {
+    long long chunk_begin = begin + c * grain_size;
+    long long chunk_end = std::min(chunk_begin + grain_size, end);
+    push((int)(c * number_of_threads_ / number_of_chunks), false, job, [&body, chunk_begin, chunk_end]() { body(chunk_begin, chunk_end); });
+  } // end for
+
+  // Run chunks
+  wakeThreads();
+  wait(job);
+
+} // end parallelFor
+
+// Parallel for over parts
+void ThreadPool::parallelForParts(const std::vector<long long>& part_starts,
+                                  const std::function<void(int, long long, long long)>& body)
+{
+
+  // Set number of parts
+  int number_of_parts = (int)part_starts.size() - 1;
+  if (number_of_parts <= 0) {
+    return;
+  }
+
+  // Check for serial run
+  if (serial() || number_of_parts == 1) {
+    for (int part = 0; part < number_of_parts; part++) {
+      body(part, part_starts[part], part_starts[part + 1]);
+    }
+    return;
+  } // end if
+
+  // Queue parts, part t to thread t
+  std::shared_ptr<Job> job(new Job());
+  job->remaining = number_of_parts;
+  for (int part = 0; part < number_of_parts; part++) {
+    long long part_begin = part_starts[part];
+    long long part_end = part_starts[part + 1];
+    push(part % number_of_threads_, false, job, [&body, part, part_begin, part_end]() { body(part, part_begin, part_end); });
+  } // end for
+
+  // Run parts
+  wakeThreads();
+  wait(job);
+
+} // end parallelForParts
+
+// Parallel sum
+double ThreadPool::parallelSum(long long begin,
+                               long long end,
+                               long long grain_size,
+                               const std::function<double(long long, long long)>& body)
+{
+
+  // Check for empty range
+  if (end <= begin) {
+    return 0.0;
+  }
+
+  // Set number of chunks (at most one per thread, unless deterministic)
+  grain_size = std::max(grain_size, 1LL);
+  long long number_of_chunks = (end - begin + grain_size - 1) / grain_size;
+  if (!deterministic_reductions_ && number_of_chunks > number_of_threads_) {
+    number_of_chunks = number_of_threads_;
+    grain_size = (end - begin + number_of_chunks - 1) / number_of_chunks;
+  }
+
+  // Compute chunk sums
+  std::vector<double> chunk_sums(number_of_chunks, 0.0);
+  parallelFor(0, number_of_chunks, 1, [&](long long chunk_begin, long long chunk_end) {
+    for (long long c = chunk_begin; c < chunk_end; c++) {
+      chunk_sums[c] = body(std::min(begin + c * grain_size, end), std::min(begin + (c + 1) * grain_size, end));
+    }
+  });
+
+  // Check for deterministic reductions
+  if (deterministic_reductions_) {
+    return pairwiseSum(chunk_sums.data(), number_of_chunks);
+  }
+
+  // Sum chunk sums in order
+  double sum = 0.0;
+  for (long long c = 0; c < number_of_chunks; c++) {
+    sum += chunk_sums[c];
+  }
+
+  // Return
+  return sum;
+
+} // end parallelSum
+
+// Run on each thread
+void ThreadPool::runOnEachThread(const std::function<void(int)>& function)
+{
+
+  // Check for serial run (each thread's function run by calling thread)
+  if (serial()) {
+    for (int t = 0; t < number_of_threads_; t++) {
+      function(t);
+    }
+    return;
+  } // end if
+
+  // Queue functions bound to threads
+  std::shared_ptr<Job> job(new Job());
+  job->remaining = number_of_threads_ - 1;
+  for (int t = 1; t < number_of_threads_; t++) {
+    push(t, true, job, [&function, t]() { function(t); });
+  }
+  wakeThreads();
+
+  // Run function of calling thread, then wait
+  run([&function]() { function(0); });
+  wait(job);
+
+} // end runOnEachThread
+
+// Pairwise sum
+double ThreadPool::pairwiseSum(const double* values,
+                               long long length)
+{
+
+  // Check for short array
+  if (length <= 2) {
+    return (length == 0) ? 0.0 : ((length == 1) ? values[0] : values[0] + values[1]);
+  }
+
+  // Sum halves
+  long long half = length / 2;
+  return pairwiseSum(values, half) + pairwiseSum(values + half, length - half);
+
+} // end pairwiseSum
+
+// Check for serial run
+bool ThreadPool::serial() const
+{
+  return (number_of_threads_ == 1 || in_task);
+}
+
+// Pin calling thread
+void ThreadPool::pin(int thread) const
+{
+
+  // Check for allowed CPUs
+  if (cpus_.size() == 0) {
+    return;
+  }
+
+  // Set affinity
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpus_[thread % cpus_.size()], &cpu_set);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+
+} // end pin
+
+// Queue task
+void ThreadPool::push(int thread,
+                      bool bound,
+                      const std::shared_ptr<Job>& job,
+                      const std::function<void()>& task)
+{
+
+  // Set task that marks job progress when finished
+  std::function<void()> job_task = [job, task]() {
+    task();
+    if (--job->remaining == 0) {
+      std::lock_guard<std::mutex> lock(job->mutex);
+      job->finished.notify_all();
+    }
+  };
+
+  // Add task to queue of thread
+  Worker& worker = *workers_[thread];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (bound) {
+    worker.bound_tasks.push_back(job_task);
+    worker.number_of_bound_tasks++;
+  }
+  else {
+    worker.tasks.push_back(job_task);
+    number_of_tasks_++;
+  }
+
+} // end push
+
+// Wake threads
+void ThreadPool::wakeThreads()
+{
+
+  // Notify while holding mutex (so no thread misses queued tasks)
+  std::lock_guard<std::mutex> lock(sleep_mutex_);
+  wake_.notify_all();
+
+} // end wakeThreads
+
+// Take task
+bool ThreadPool::pop(int thread,
+                     std::function<void()>& task)
+{
+
+  // Take own task (bound tasks first, then newest task)
+  {
+    Worker& worker = *workers_[thread];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.bound_tasks.empty()) {
+      task = worker.bound_tasks.front();
+      worker.bound_tasks.pop_front();
+      worker.number_of_bound_tasks--;
+      return true;
+    } // end if
+    if (!worker.tasks.empty()) {
+      task = worker.tasks.back();
+      worker.tasks.pop_back();
+      number_of_tasks_--;
+      return true;
+    } // end if
+  }
+
+  // Steal oldest task of another thread
+  for (int k = 1; k < number_of_threads_; k++) {
+    Worker& worker = *workers_[(thread + k) % number_of_threads_];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = worker.tasks.front();
+      worker.tasks.pop_front();
+      number_of_tasks_--;
+      return true;
+    } // end if
+  }   // end for
+
+  // Return
+  return false;
+
+} // end pop
+
+// Run task
+void ThreadPool::run(const std::function<void()>& task)
+{
+
+  // Mark calling thread as running task, then run
+  bool was_in_task = in_task;
+  in_task = true;
+  task();
+  in_task = was_in_task;
+
+} // end run
+
+// Loop of thread
+void ThreadPool::loop(int thread)
+{
+
+  // Pin thread
+  if (pin_threads_) {
+    pin(thread);
+  }
+
+  // Run tasks until stopped
+  Worker& worker = *workers_[thread];
+  while (true) {
+    std::function<void()> task;
+    if (pop(thread, task)) {
+      run(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [&]() { return stop_ || number_of_tasks_ > 0 || worker.number_of_bound_tasks > 0; });
+    if (stop_ && number_of_tasks_ == 0 && worker.number_of_bound_tasks == 0) {
+      return;
+    }
+  } // end while
+
+} // end loop
+
+// Wait for job
+void ThreadPool::wait(const std::shared_ptr<Job>& job)
+{
+
+  // Run tasks while job is not finished
+  std::function<void()> task;
+  while (job->remaining > 0 && pop(0, task)) {
+    run(task);
+  }
+
+  // Wait for tasks being run by other threads
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->finished.wait(lock, [&]() { return job->remaining == 0; });
+
+} // end wait
+
+} // namespace FaRSA
@@ -0,0 +1,243 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __FARSATHREADPOOL_HPP__
+#define __FARSATHREADPOOL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+namespace FaRSA
+{
+
+/**
+  * ThreadPool class
+  * (work-stealing pool shared by all parallel kernels: the calling thread is thread 0
+  *  and takes part in the work; each other thread takes tasks from the back of its own
+  *  queue and, when empty, steals from the front of the other queues; parallel calls
+  *  made from within a task run serially in that task, so components may nest calls
+  *  without oversubscribing the machine; calls should be made from one thread at a time)
+  */
+class ThreadPool
+{
+
+public:
+  /** @name Constructors */
+  //@{
+  /**
+    * Constructor (starts number_of_threads-1 threads)
+    * \param[in] number_of_threads is number of threads, including calling thread
+    * \param[in] pin_threads indicates whether thread t is pinned to t-th allowed CPU
+    *            (calling thread is pinned until destruction)
+    */
+  ThreadPool(int number_of_threads,
+             bool pin_threads);
+  //@}
+
+  /** @name Destructor */
+  //@{
+  /**
+    * Destructor (stops threads)
+    */
+  ~ThreadPool();
+  //@}
+
+  /** @name Get methods */
+  //@{
+  /**
+    * Get number of threads
+    * \return number of threads, including calling thread
+    */
+  inline int numberOfThreads() const { return number_of_threads_; };
+  /**
+    * Get indicator of pinning
+    * \return true if threads are pinned, false otherwise
+    */
+  inline bool pinThreads() const { return pin_threads_; };
+  /**
+    * Get indicator of deterministic reductions
+    * \return true if reductions do not depend on number of threads, false otherwise
+    */
+  inline bool deterministicReductions() const { return deterministic_reductions_; };
+  //@}
+
+  /** @name Set methods */
+  //@{
+  /**
+    * Set indicator of deterministic reductions
+    * \param[in] deterministic_reductions indicates whether reductions use a fixed shape,
+    *            independent of number of threads (see parallelSum)
+    */
+  inline void setDeterministicReductions(bool deterministic_reductions) { deterministic_reductions_ = deterministic_reductions; };
+  //@}
+
+  /** @name Parallel methods */
+  //@{
+  /**
+    * Run body over range [begin,end), split into chunks of (at most) grain_size indices
+    * \param[in] begin is first index
+    * \param[in] end is index after last index
+    * \param[in] grain_size is number of indices per chunk
+    * \param[in] body is function called as body(chunk_begin, chunk_end)
+    */
+  void parallelFor(long long begin,
+                   long long end,
+                   long long grain_size,
+                   const std::function<void(long long, long long)>& body);
+  /**
+    * Run body over given parts; part t is queued first to thread t (modulo number of
+    * threads), e.g., to process data placed by that thread, but may be stolen
+    * \param[in] part_starts is vector of part boundaries (number of parts plus one)
+    * \param[in] body is function called as body(part, part_begin, part_end)
+    */
+  void parallelForParts(const std::vector<long long>& part_starts,
+                        const std::function<void(int, long long, long long)>& body);
+  /**
+    * Sum body over range [begin,end), split into chunks of at least grain_size indices
+    * (if deterministic reductions, chunks have exactly grain_size indices (the last
+    *  possibly fewer) and chunk sums are added by blocked pairwise summation, so the
+    *  shape of the sum, and thus the result, depends only on the range and grain size;
+    *  otherwise, there is at most one chunk per thread and chunk sums are added in order)
+    * \param[in] begin is first index
+    * \param[in] end is index after last index
+    * \param[in] grain_size is number of indices per chunk (minimum if not deterministic)
+    * \param[in] body is function called as body(chunk_begin, chunk_end), returning chunk sum
+    * \return sum
+    */
+  double parallelSum(long long begin,
+                     long long end,
+                     long long grain_size,
+                     const std::function<double(long long, long long)>& body);
+  /**
+    * Run function on each thread, i.e., thread t calls function(t) (never stolen)
+    * \param[in] function is function to run
+    */
+  void runOnEachThread(const std::function<void(int)>& function);
+  //@}
+
+private:
+  /** @name Default compiler generated methods
+    * (Hidden to avoid implicit creation/calling.)
+    */
+  //@{
+  /**
+    * Copy constructor
+    */
+  ThreadPool(const ThreadPool&);
+  /**
+    * Overloaded equals operator
+    */
+  void operator=(const ThreadPool&);
+  //@}
+
+  /**
+    * Job (set of tasks submitted by one parallel call)
+    */
+  struct Job
+  {
+    std::atomic<long long> remaining; /**< Number of tasks not yet finished */
+    std::mutex mutex;                 /**< Mutex for completion */
+    std::condition_variable finished; /**< Condition for completion */
+  };
+
+  /**
+    * Worker (queues of one thread)
+    */
+  struct Worker
+  {
+    std::mutex mutex;                               /**< Mutex for queues */
+    std::deque<std::function<void()> > tasks;       /**< Tasks (may be stolen) */
+    std::deque<std::function<void()> > bound_tasks; /**< Tasks bound to this thread */
+    std::atomic<long long> number_of_bound_tasks;   /**< Number of bound tasks */
+  };
+
+  /** @name Private members */
+  //@{
+  int number_of_threads_;                        /**< Number of threads */
+  bool pin_threads_;                             /**< Indicator of pinning */
+  bool deterministic_reductions_;                /**< Indicator of deterministic reductions */
+  bool stop_;                                    /**< Indicator for threads to stop */
+  std::atomic<long long> number_of_tasks_;       /**< Number of queued tasks (may be stolen) */
+  std::mutex sleep_mutex_;                       /**< Mutex for sleeping threads */
+  std::condition_variable wake_;                 /**< Condition for waking threads */
+  std::vector<std::unique_ptr<Worker> > workers_; /**< Workers, one per thread */
+  std::vector<std::thread> threads_;             /**< Threads 1,...,number_of_threads-1 */
+  std::vector<int> cpus_;                        /**< Allowed CPUs (for pinning) */
+  cpu_set_t caller_cpu_set_;                     /**< Affinity of calling thread before pinning */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+    * Sum values by pairwise summation (halving recursively, so shape depends only on length)
+    * \param[in] values is array of values
+    * \param[in] length is length of array
+    * \return sum
+    */
+  static double pairwiseSum(const double* values,
+                            long long length);
+  /**
+    * Check whether parallel calls run serially (single thread or call from within a task)
+    * \return true if serial, false otherwise
+    */
+  bool serial() const;
+  /**
+    * Pin calling thread to CPU for thread
+    * \param[in] thread is index of thread
+    */
+  void pin(int thread) const;
+  /**
+    * Queue task of job for thread
+    * \param[in] thread is index of thread
+    * \param[in] bound indicates whether task is bound to thread
+    * \param[in] job is job of task
+    * \param[in] task is task to run
+    */
+  void push(int thread,
+            bool bound,
+            const std::shared_ptr<Job>& job,
+            const std::function<void()>& task);
+  /**
+    * Wake threads (after tasks have been queued)
+    */
+  void wakeThreads();
+  /**
+    * Take task for thread (own bound tasks, then own tasks, then stolen tasks)
+    * \param[in] thread is index of thread
+    * \param[out] task is task to run
+    * \return true if task taken, false otherwise
+    */
+  bool pop(int thread,
+           std::function<void()>& task);
+  /**
+    * Run task (parallel calls made within it run serially)
+    * \param[in] task is task to run
+    */
+  void run(const std::function<void()>& task);
+  /**
+    * Loop of thread (run tasks until stopped)
+    * \param[in] thread is index of thread
+    */
+  void loop(int thread);
+  /**
+    * Wait for job, running tasks in the meantime (calling thread)
+    * \param[in] job is job for which to wait
+    */
+  void wait(const std::shared_ptr<Job>& job);
+  //@}
+
+}; // end ThreadPool
+
+} // namespace FaRSA
+
+#endif /* __FARSATHREADPOOL_HPP__ */
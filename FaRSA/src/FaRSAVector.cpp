@@ -6,9 +6,20 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
 
 #include "FaRSABLASLAPACK.hpp"
+#include "FaRSABinaryIO.hpp"
 #include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSAFileCache.hpp"
+#include "FaRSATextParser.hpp"
 #include "FaRSAVector.hpp"
 
 namespace FaRSA
@@ -17,6 +28,8 @@ namespace FaRSA
 // Constructor with given length; values initialized to zero
 Vector::Vector(int length)
   : length_(length),
+    mapped_data_(nullptr),
+    mapped_length_(0),
     max_computed_(true),
     min_computed_(true),
     norm1_computed_(true),
@@ -43,6 +56,8 @@ Vector::Vector(int length)
 Vector::Vector(int length,
                double value)
   : length_(length),
+    mapped_data_(nullptr),
+    mapped_length_(0),
     max_computed_(true),
     min_computed_(true),
     norm1_computed_(true),
@@ -67,18 +82,32 @@ Vector::Vector(int length,
 
 } // end constructor
 
-// Destructor; values array deleted
+// Destructor; values array deleted (or unmapped)
 Vector::~Vector()
 {
 
   // Delete array
-  if (values_ != nullptr) {
-    delete[] values_;
-    values_ = nullptr;
-  } // end if
+  releaseValues();
 
 } // end destructor
 
+// Release values
+void Vector::releaseValues()
+{
+
+  // Unmap file or delete array
+  if (mapped_data_ != nullptr) {
+    munmap(mapped_data_, mapped_length_);
+    mapped_data_ = nullptr;
+    mapped_length_ = 0;
+  }
+  else if (values_ != nullptr) {
+    delete[] values_;
+  }
+  values_ = nullptr;
+
+} // end releaseValues
+
 // Print array with given name
 void Vector::print(const Reporter* reporter,
                    std::string name) const
@@ -95,8 +124,9 @@ void Vector::print(const Reporter* reporter,
 std::shared_ptr<Vector> Vector::makeNewCopy() const
 {
 
-  // Create new vector
+  // Create new vector (sharing thread pool)
   std::shared_ptr<Vector> vector(new Vector(length_));
+  vector->setThreadPool(thread_pool_);
 
   // Copy elements
   vector->copy(*this);
@@ -112,8 +142,9 @@ std::shared_ptr<Vector> Vector::makeNewLinearCombination(double scalar1,
                                                          const Vector& other_vector) const
 {
 
-  // Create new vector
+  // Create new vector (sharing thread pool)
   std::shared_ptr<Vector> vector(new Vector(length_));
+  vector->setThreadPool(thread_pool_);
 
   // Copy + add elements
   vector->linearCombination(scalar1, *this, scalar2, other_vector);
@@ -124,45 +155,232 @@ std::shared_ptr<Vector> Vector::makeNewLinearCombination(double scalar1,
 } // end makeNewLinearCombination
 
 // Set from file
-void Vector::setFromFile(char* file_name)
+void Vector::setFromFile(char* file_name,
+                         bool use_cache)
 {
 
-  // Open file
-  FILE* f_in = fopen(file_name, "r");
+  // Map binary file
+  if (isBinaryFile(file_name)) {
+    setFromBinaryFile(file_name);
+    return;
+  }
 
-  // Check for failed opening
-  if (f_in == NULL) {
+  // Map binary image from sidecar, if sidecar matches file (sidecar is ignored if invalid)
+  std::unique_ptr<FileCache> cache;
+  if (use_cache) {
+    cache.reset(new FileCache(file_name, C_VECTOR_DATA, 0));
+    if (cache->map()) {
+      size_t mapped_length;
+      void* mapped_data = cache->releaseMapping(mapped_length);
+      if (setFromMapping(mapped_data, mapped_length, FARSA_CACHE_HEADER_SIZE)) {
+        return;
+      }
+      munmap(mapped_data, mapped_length);
+    } // end if
+  }   // end if
+
+  // Open file
+  TextParser parser;
+  if (!parser.open(file_name)) {
     THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Failed to open input file.");
   }
 
   // Read length (assumed first entry in file)
-  int scan_value = fscanf(f_in, "%d", &length_);
-  if (scan_value == 0 || scan_value == EOF) {
+  long long length;
+  if (!parser.readInteger(length) || length < 0 || length > FARSA_INT_INFINITY) {
     THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Length not read.");
   }
 
-  // Allocate memory
+  // Allocate memory (through modifiable accessor to reset scalar values)
+  releaseValues();
+  length_ = (int)length;
   values_ = new double[length_];
+  valuesModifiable();
 
-  // Read file (assumes (index, value) format)
-  int counter = 0;
-  while (true) {
-    int scan_value = fscanf(f_in, "%lf", &values_[counter]);
-    if (scan_value == 0 || scan_value == EOF || counter >= length_-1) {
-      break;
-    }
-    counter++;
-  } // end while
+  // Read file in parallel chunks
+  long long number_of_elements_read = parser.readRecords(length_, 1, [&](long long i, const double* fields) {
+    values_[i] = fields[0];
+  }, thread_pool_.get());
 
   // Check if full vector has been read
-  if (counter < length_ - 1) {
+  if (number_of_elements_read < length_) {
     THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Not all vector elements have been read.");
   }
 
+  // Write binary image to sidecar (failure, e.g., in a read-only directory, is ignored)
+  if (use_cache) {
+    char header[FARSA_VECTOR_HEADER_SIZE];
+    setBinaryHeader(header);
+    std::vector<std::pair<const void*, size_t> > parts;
+    parts.push_back(std::make_pair((const void*)header, (size_t)FARSA_VECTOR_HEADER_SIZE));
+    parts.push_back(std::make_pair((const void*)values_, (size_t)length_ * sizeof(double)));
+    cache->write(parts);
+  } // end if
+
+} // end setFromFile
+
+// Set from binary file
+void Vector::setFromBinaryFile(char* file_name)
+{
+
+  // Open file
+  int file_descriptor = open(file_name, O_RDONLY);
+
+  // Check for failed opening
+  if (file_descriptor < 0) {
+    THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Failed to open input file.");
+  }
+
+  // Get file length
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size < FARSA_VECTOR_HEADER_SIZE) {
+    close(file_descriptor);
+    THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Binary vector file too short.");
+  }
+
+  // Map file (private and writable, so modified pages are copied, never written to file;
+  // mapping persists after file is closed)
+  size_t mapped_length = (size_t)file_status.st_size;
+  void* mapped_data = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+  close(file_descriptor);
+  if (mapped_data == MAP_FAILED) {
+    THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Failed to map binary vector file.");
+  }
+
+  // Set values, pointing into mapping
+  if (!setFromMapping(mapped_data, mapped_length, 0)) {
+    munmap(mapped_data, mapped_length);
+    THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Invalid binary vector file.");
+  }
+
+} // end setFromBinaryFile
+
+// Set from mapping
+bool Vector::setFromMapping(void* mapped_data,
+                            size_t mapped_length,
+                            size_t offset)
+{
+
+  // Check length of mapping
+  if (mapped_length < offset + FARSA_VECTOR_HEADER_SIZE) {
+    return false;
+  }
+
+  // Read header
+  char identifier[16];
+  int version;
+  long long length;
+  const char* header = (const char*)mapped_data + offset;
+  memcpy(identifier, header, 16);
+  memcpy(&version, header + 16, sizeof(int));
+  memcpy(&length, header + 24, sizeof(long long));
+
+  // Check header
+  if (strncmp(identifier, FARSA_VECTOR_IDENTIFIER, 16) != 0 ||
+      version != FARSA_VECTOR_VERSION ||
+      length < 0 || length > 2147483647LL ||
+      (long long)(mapped_length - offset) != FARSA_VECTOR_HEADER_SIZE + length * (long long)sizeof(double)) {
+    return false;
+  }
+
+  // Set values, pointing into mapping (through modifiable accessor to reset scalar values)
+  releaseValues();
+  mapped_data_ = mapped_data;
+  mapped_length_ = mapped_length;
+  length_ = (int)length;
+  values_ = (double*)(header + FARSA_VECTOR_HEADER_SIZE);
+  valuesModifiable();
+
+  // Return
+  return true;
+
+} // end setFromMapping
+
+// Set binary header
+void Vector::setBinaryHeader(char* header) const
+{
+
+  // Set identifier, version, and length (padded to header size, so values are aligned)
+  memset(header, 0, FARSA_VECTOR_HEADER_SIZE);
+  int version = FARSA_VECTOR_VERSION;
+  long long length = length_;
+  strncpy(header, FARSA_VECTOR_IDENTIFIER, 16);
+  memcpy(header + 16, &version, sizeof(int));
+  memcpy(header + 24, &length, sizeof(long long));
+
+} // end setBinaryHeader
+
+// Check for binary file
+bool Vector::isBinaryFile(char* file_name)
+{
+
+  // Open file
+  FILE* f_in = fopen(file_name, "rb");
+  if (f_in == NULL) {
+    return false;
+  }
+
+  // Read identifier
+  char identifier[16];
+  bool is_binary = (fread(identifier, 1, 16, f_in) == 16 && strncmp(identifier, FARSA_VECTOR_IDENTIFIER, 16) == 0);
+
   // Close file
   fclose(f_in);
 
-} // end setFromFile
+  // Return
+  return is_binary;
+
+} // end isBinaryFile
+
+// Read from binary file
+bool Vector::readFromBinaryFile(FILE* file)
+{
+
+  // Read and check length
+  int length;
+  if (!readBinary(file, length) || length != length_) {
+    return false;
+  }
+
+  // Read values (through modifiable accessor to reset scalar values)
+  return (length_ == 0 || fread(valuesModifiable(), sizeof(double), length_, file) == (size_t)length_);
+
+} // end readFromBinaryFile
+
+// Write to binary file
+bool Vector::writeToBinaryFile(FILE* file) const
+{
+
+  // Write length and values
+  return (writeBinary(file, length_) &&
+          (length_ == 0 || fwrite(values_, sizeof(double), length_, file) == (size_t)length_));
+
+} // end writeToBinaryFile
+
+// Write to binary file
+void Vector::writeToBinaryFile(char* file_name) const
+{
+
+  // Open file
+  FILE* f_out = fopen(file_name, "wb");
+  if (f_out == NULL) {
+    THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Failed to open output file.");
+  }
+
+  // Write header
+  char header[FARSA_VECTOR_HEADER_SIZE];
+  setBinaryHeader(header);
+  bool written = (fwrite(header, 1, FARSA_VECTOR_HEADER_SIZE, f_out) == FARSA_VECTOR_HEADER_SIZE);
+
+  // Write values
+  written = written && (length_ == 0 || fwrite(values_, sizeof(double), length_, f_out) == (size_t)length_);
+
+  // Close file
+  if (fclose(f_out) != 0 || !written) {
+    THROW_EXCEPTION(FARSA_VECTOR_EXCEPTION, "Failed to write binary vector file.");
+  }
+
+} // end writeToBinaryFile
 
 // Set length and initialize values to zero
 void Vector::setLength(int length)
@@ -171,11 +389,8 @@ void Vector::setLength(int length)
   // Store length
   length_ = length;
 
-  // Delete previous array, if exists
-  if (values_ != nullptr) {
-    delete[] values_;
-    values_ = nullptr;
-  } // end if
+  // Delete previous array (or unmap file), if exists
+  releaseValues();
 
   // Allocate array
   values_ = new double[length];
@@ -228,9 +443,11 @@ void Vector::copy(const Vector& other_vector)
   assert(length_ == other_vector.length());
 
   // Copy elements
-  for (int i = 0; i < length_; i++) {
-    values_[i] = other_vector.values()[i];
-  }
+  forElements([&](long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+      values_[i] = other_vector.values()[i];
+    }
+  });
 
   // Reset scalar value bools
   max_computed_ = false;
@@ -267,17 +484,21 @@ void Vector::scale(double scalar)
   if (scalar == 0.0) {
 
     // Scale elements
-    for (int i = 0; i < length_; i++) {
-      values_[i] = 0.0;
-    }
+    forElements([&](long long begin, long long end) {
+      for (long long i = begin; i < end; i++) {
+        values_[i] = 0.0;
+      }
+    });
 
   } // end if
   else if (scalar != 1.0) {
 
     // Scale elements
-    for (int i = 0; i < length_; i++) {
-      values_[i] = scalar * values_[i];
-    }
+    forElements([&](long long begin, long long end) {
+      for (long long i = begin; i < end; i++) {
+        values_[i] = scalar * values_[i];
+      }
+    });
 
   } // end else
 
@@ -329,9 +550,11 @@ void Vector::addScaledVector(double scalar,
   assert(length_ == other_vector.length());
 
   // Add scaled vector
-  for (int i = 0; i < length_; i++) {
-    values_[i] += scalar * other_vector.values()[i];
-  }
+  forElements([&](long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+      values_[i] += scalar * other_vector.values()[i];
+    }
+  });
 
   // Reset scalar value bools
   max_computed_ = false;
@@ -357,25 +580,31 @@ void Vector::linearCombination(double scalar1,
   if (scalar1 != 0.0 && scalar2 != 0.0) {
 
     // Set elements
-    for (int i = 0; i < length_; i++) {
-      values_[i] = scalar1 * vector1.values()[i] + scalar2 * vector2.values()[i];
-    }
+    forElements([&](long long begin, long long end) {
+      for (long long i = begin; i < end; i++) {
+        values_[i] = scalar1 * vector1.values()[i] + scalar2 * vector2.values()[i];
+      }
+    });
 
   } // end if
   else if (scalar1 != 0.0) {
 
     // Set elements
-    for (int i = 0; i < length_; i++) {
-      values_[i] = scalar1 * vector1.values()[i];
-    }
+    forElements([&](long long begin, long long end) {
+      for (long long i = begin; i < end; i++) {
+        values_[i] = scalar1 * vector1.values()[i];
+      }
+    });
 
   } // end else if
   else {
 
     // Set elements
-    for (int i = 0; i < length_; i++) {
-      values_[i] = scalar2 * vector2.values()[i];
-    }
+    forElements([&](long long begin, long long end) {
+      for (long long i = begin; i < end; i++) {
+        values_[i] = scalar2 * vector2.values()[i];
+      }
+    });
 
   } // end else
 
@@ -402,6 +631,29 @@ void Vector::linearCombination(double scalar1,
 
 } // end linearCombination
 
+// Place values for parallel kernels
+void Vector::place(Placement& placement,
+                   std::string name)
+{
+
+  // Set part boundaries
+  std::vector<long long> part_starts(placement.numberOfThreads() + 1);
+  for (int t = 0; t < placement.numberOfThreads(); t++) {
+    long long end;
+    placement.partition(length_, t, part_starts[t], end);
+  }
+  part_starts[placement.numberOfThreads()] = length_;
+
+  // Copy values, each part by its thread
+  double* values = placement.placedCopy(values_, part_starts);
+  releaseValues();
+  values_ = values;
+
+  // Record placement
+  placement.record(name, values_, sizeof(double), part_starts);
+
+} // end place
+
 // Inner product with other_vector
 double Vector::innerProduct(const Vector& other_vector) const
 {
@@ -410,10 +662,13 @@ double Vector::innerProduct(const Vector& other_vector) const
   assert(length_ == other_vector.length());
 
   // Compute inner product
-  double inner_product = 0.0;
-  for (int i = 0; i < length_; i++) {
-    inner_product += values_[i] * other_vector.values()[i];
-  }
+  double inner_product = sumElements([&](long long begin, long long end) {
+    double sum = 0.0;
+    for (long long i = begin; i < end; i++) {
+      sum += values_[i] * other_vector.values()[i];
+    }
+    return sum;
+  });
 
   // Return inner product
   return inner_product;
@@ -477,13 +732,14 @@ double Vector::norm1()
   // Check if computed
   if (!norm1_computed_) {
 
-    // Initialize 1-norm
-    norm1_value_ = fabs(values_[0]);
-
     // Determine 1-norm
-    for (int i = 1; i < length_; i++) {
-      norm1_value_ += fabs(values_[i]);
-    }
+    norm1_value_ = sumElements([&](long long begin, long long end) {
+      double sum = 0.0;
+      for (long long i = begin; i < end; i++) {
+        sum += fabs(values_[i]);
+      }
+      return sum;
+    });
 
     // Set to computed
     norm1_computed_ = true;
@@ -502,14 +758,14 @@ double Vector::norm2()
   // Check if computed
   if (!norm2_computed_) {
 
-    // Initialize 2-norm
-    norm2_value_ = pow(values_[0], 2.0);
-
     // Determine 2-norm
-    for (int i = 1; i < length_; i++) {
-      norm2_value_ += pow(values_[i], 2.0);
-    }
-    norm2_value_ = sqrt(norm2_value_);
+    norm2_value_ = sqrt(sumElements([&](long long begin, long long end) {
+      double sum = 0.0;
+      for (long long i = begin; i < end; i++) {
+        sum += pow(values_[i], 2.0);
+      }
+      return sum;
+    }));
 
     // Set to computed
     norm2_computed_ = true;
@@ -546,4 +802,32 @@ double Vector::normInf()
 
 } // end normInf
 
+// Run body over elements
+void Vector::forElements(const std::function<void(long long, long long)>& body) const
+{
+
+  // Run in parallel or serially, depending on thread pool and length
+  if (thread_pool_ != nullptr && length_ > FARSA_THREAD_POOL_GRAIN_SIZE) {
+    thread_pool_->parallelFor(0, length_, FARSA_THREAD_POOL_GRAIN_SIZE, body);
+  }
+  else {
+    body(0, length_);
+  }
+
+} // end forElements
+
+// Sum body over elements
+double Vector::sumElements(const std::function<double(long long, long long)>& body) const
+{
+
+  // Sum in parallel or serially, depending on thread pool and length
+  if (thread_pool_ != nullptr && length_ > FARSA_THREAD_POOL_GRAIN_SIZE) {
+    return thread_pool_->parallelSum(0, length_, FARSA_THREAD_POOL_GRAIN_SIZE, body);
+  }
+  else {
+    return body(0, length_);
+  }
+
+} // end sumElements
+
 } // namespace FaRSA
@@ -7,10 +7,14 @@
 #ifndef __FARSAVECTOR_HPP__
 #define __FARSAVECTOR_HPP__
 
+#include <cstdio>
+#include <functional>
 #include <memory>
 #include <string>
 
+#include "FaRSAPlacement.hpp"
 #include "FaRSAReporter.hpp"
+#include "FaRSAThreadPool.hpp"
 
 namespace FaRSA
 {
@@ -18,7 +22,9 @@ namespace FaRSA
 /**
  * Forward declarations
  */
+class Placement;
 class Reporter;
+class ThreadPool;
 
 /**
  * Vector class
@@ -35,6 +41,8 @@ public:
   Vector()
     : values_(nullptr),
       length_(-1),
+      mapped_data_(nullptr),
+      mapped_length_(0),
       max_computed_(false),
       min_computed_(false),
       norm1_computed_(false),
@@ -57,7 +65,7 @@ public:
   /** @name Destructor */
   //@{
   /**
-   * Destructor; values array deleted
+   * Destructor; values array deleted (or unmapped)
    */
   ~Vector();
   //@}
@@ -76,12 +84,13 @@ public:
   /** @name Make methods */
   //@{
   /**
-   * Make new Vector as a copy
+   * Make new Vector as a copy (sharing thread pool)
    * \return is pointer to new Vector
    */
   std::shared_ptr<Vector> makeNewCopy() const;
   /**
    * Make new Vector by adding "scalar1" times this Vector to "scalar2" times other_vector
+   * (sharing thread pool of this Vector)
    * \param[in] scalar1 is scalar value for linear combination
    * \param[in] scalar2 is scalar value for linear combination
    * \param[in] other_vector is reference to other Vector
@@ -104,6 +113,11 @@ public:
    * \return is pointer to array of Vector values
    */
   inline double* values() const { return values_; };
+  /**
+   * Get indicator of memory-mapped values
+   * \return true if values alias a binary file (see setFromBinaryFile), false otherwise
+   */
+  inline bool isMapped() const { return mapped_data_ != nullptr; };
   /**
    * Get values (modifiable)
    * \return is pointer to array of Vector values (to allow modification of array)
@@ -119,12 +133,67 @@ public:
   };
   //@}
 
+  /** @name Thread pool methods */
+  //@{
+  /**
+   * Set thread pool used by operations of this Vector (nullptr for serial operations);
+   * Vectors made from this Vector (see make methods) share its thread pool
+   * \param[in] thread_pool is pointer to ThreadPool, e.g., owned by the solver
+   */
+  inline void setThreadPool(const std::shared_ptr<ThreadPool>& thread_pool) { thread_pool_ = thread_pool; };
+  /**
+   * Get thread pool used by operations of this Vector
+   * \return pointer to ThreadPool (nullptr if operations are serial)
+   */
+  inline const std::shared_ptr<ThreadPool>& threadPool() const { return thread_pool_; };
+  //@}
+
   /** @name Set methods */
   //@{
   /**
-   * Set vector from file
+   * Set vector from file (binary file, see isBinaryFile, is memory-mapped; otherwise, text
+   * file with length followed by elements)
+   * \param[in] file_name is name of file
+   * \param[in] use_cache indicates whether to map text file from binary sidecar (see
+   *            FileCache) if sidecar matches file, and otherwise write sidecar after parsing
    */
-  void setFromFile(char* file_name);
+  void setFromFile(char* file_name,
+                   bool use_cache = false);
+  /**
+   * Set vector from binary file (written by writeToBinaryFile); values alias the file
+   * through a private mapping, so nothing is read or copied until elements are used and
+   * modified elements are never written to the file
+   * \param[in] file_name is name of binary file
+   */
+  void setFromBinaryFile(char* file_name);
+  /**
+   * Check for binary file
+   * \param[in] file_name is name of file
+   * \return true if file starts with binary vector identifier, false otherwise
+   */
+  static bool isBinaryFile(char* file_name);
+  /**
+   * Read elements from open binary file (written by writeToBinaryFile)
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure, e.g., due to incorrect length (false)
+   */
+  bool readFromBinaryFile(FILE* file);
+  //@}
+
+  /** @name Write methods */
+  //@{
+  /**
+   * Write length and elements to open binary file
+   * \param[in] file is pointer to open file
+   * \return indicator of success (true) or failure (false)
+   */
+  bool writeToBinaryFile(FILE* file) const;
+  /**
+   * Write to binary file (header followed by elements, aligned for memory mapping;
+   * read by setFromFile or setFromBinaryFile)
+   * \param[in] file_name is name of binary file
+   */
+  void writeToBinaryFile(char* file_name) const;
   //@}
 
   /** @name Modify methods */
@@ -174,6 +243,14 @@ public:
                          const Vector& vector1,
                          double scalar2,
                          const Vector& vector2);
+  /**
+   * Place values for parallel kernels: elements are split into one contiguous part
+   * per thread and each part is copied by its thread (first touch on its NUMA node)
+   * \param[in] placement is reference to Placement object
+   * \param[in] name is name of Vector in placement report
+   */
+  void place(Placement& placement,
+             std::string name);
   //@}
 
   /** @name Scalar functions */
@@ -222,8 +299,46 @@ private:
 
   /** @name Private members */
   //@{
-  double* values_; /**< Double array */
-  int length_;     /**< Length of array */
+  double* values_;                 /**< Double array */
+  int length_;                     /**< Length of array */
+  void* mapped_data_;              /**< Memory-mapped binary file (if values alias file) */
+  size_t mapped_length_;           /**< Length of memory-mapped binary file */
+  std::shared_ptr<ThreadPool> thread_pool_; /**< Thread pool for operations */
+  //@}
+
+  /** @name Private methods */
+  //@{
+  /**
+   * Release values (delete array or unmap file)
+   */
+  void releaseValues();
+  /**
+   * Set values from mapping of binary image (see writeToBinaryFile); values alias the
+   * mapping, which is unmapped when values are released
+   * \param[in] mapped_data is pointer to mapping
+   * \param[in] mapped_length is length of mapping
+   * \param[in] offset is offset of binary image in mapping
+   * \return true if image is valid (Vector owns mapping), false otherwise (Vector unchanged)
+   */
+  bool setFromMapping(void* mapped_data,
+                      size_t mapped_length,
+                      size_t offset);
+  /**
+   * Set header of binary image (identifier, version, and length)
+   * \param[out] header is array of length FARSA_VECTOR_HEADER_SIZE
+   */
+  void setBinaryHeader(char* header) const;
+  /**
+   * Run body over elements, in parallel if thread pool is set and Vector is long
+   * \param[in] body is function called as body(begin, end) for ranges of elements
+   */
+  void forElements(const std::function<void(long long, long long)>& body) const;
+  /**
+   * Sum body over elements, in parallel if thread pool is set and Vector is long
+   * \param[in] body is function called as body(begin, end) for ranges of elements
+   * \return sum
+   */
+  double sumElements(const std::function<double(long long, long long)>& body) const;
   //@}
 
   /** @name Private computed members */
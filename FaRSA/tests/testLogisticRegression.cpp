@@ -0,0 +1,13 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#include "testLogisticRegression.hpp"
+
+// Main function
+int main()
+{
+  return testLogisticRegressionImplementation(1);
+}
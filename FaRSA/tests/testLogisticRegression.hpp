@@ -0,0 +1,226 @@
+// Copyright (C) 2020 Frank E. Curtis, Daniel P. Robinson
+//
+// This code is published under the ??? License.
+//
+// Author(s) : Frank E. Curtis, Daniel P. Robinson
+
+#ifndef __TESTLOGISTICREGRESSION_HPP__
+#define __TESTLOGISTICREGRESSION_HPP__
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
+#include "FaRSAEnumerations.hpp"
+#include "FaRSAReporter.hpp"
+#include "FaRSASolver.hpp"
+#include "LogisticRegression.hpp"
+
+using namespace FaRSA;
+
+// Implementation of test
+int testLogisticRegressionImplementation(int option)
+{
+
+  // Initialize output
+  int result = 0;
+
+  // Declare reporter
+  Reporter reporter;
+
+  // Check option
+  if (option == 1) {
+
+    // Declare stream report
+    std::shared_ptr<StreamReport> s(new StreamReport("s", R_SOLVER, R_BASIC));
+
+    // Set stream report to standard output
+    s->setStream(&std::cout);
+
+    // Add stream report to reporter
+    reporter.addReport(s);
+
+  } // end if
+
+  // Declare problem (without sidecar caches)
+  LogisticRegression problem((char*)"logistic_features.txt",
+                             (char*)"logistic_labels.txt",
+                             (char*)"logistic_groups.txt",
+                             (char*)"logistic_initial_point.txt",
+                             M_VALUE_DOUBLE,
+                             false,
+                             1,
+                             false);
+
+  // Set point and direction
+  std::vector<double> x = {0.1, -0.2, 0.3, -0.4};
+  std::vector<int> groups = {0, 1};
+  std::vector<double> v = {1.0, -2.0, 0.5, 1.5};
+
+  // Evaluate Hessian-vector product, then gradient, then Hessian-vector product at same
+  // point (gradient must not overwrite curvature weights of products)
+  std::vector<double> Hv_before(4);
+  std::vector<double> g(4);
+  std::vector<double> Hv_after(4);
+  problem.evaluateHessianVectorProduct(x.data(), groups, v.data(), Hv_before.data());
+  problem.evaluateGradient(x.data(), g.data());
+  problem.evaluateHessianVectorProduct(x.data(), groups, v.data(), Hv_after.data());
+
+  // Check products (bitwise identical)
+  for (int i = 0; i < 4; i++) {
+    if (Hv_before[i] != Hv_after[i]) {
+      result = 1;
+    }
+  } // end for
+
+  // Print products
+  reporter.printf(R_SOLVER, R_BASIC, "Testing Hessian-vector products before and after gradient... should match:\n");
+  for (int i = 0; i < 4; i++) {
+    reporter.printf(R_SOLVER, R_BASIC, "%+e %+e\n", Hv_before[i], Hv_after[i]);
+  }
+
+  // Evaluate Hessian diagonal after gradient at same point and check against products
+  // with unit vectors
+  std::vector<double> d(4);
+  problem.evaluateHessianDiagonal(x.data(), groups, d.data());
+  for (int i = 0; i < 4; i++) {
+    std::vector<double> e(4, 0.0);
+    std::vector<double> He(4);
+    e[i] = 1.0;
+    problem.evaluateGradient(x.data(), g.data());
+    problem.evaluateHessianVectorProduct(x.data(), groups, e.data(), He.data());
+    if (d[i] < He[i] - 1e-12 || d[i] > He[i] + 1e-12) {
+      result = 1;
+    }
+  } // end for
+
+  // Declare problems for solves (one reused after a solve with working set)
+  std::shared_ptr<LogisticRegression> reused_problem = std::make_shared<LogisticRegression>((char*)"logistic_features.txt",
+                                                                                            (char*)"logistic_labels.txt",
+                                                                                            (char*)"logistic_groups.txt",
+                                                                                            (char*)"logistic_initial_point.txt",
+                                                                                            M_VALUE_DOUBLE,
+                                                                                            false,
+                                                                                            1,
+                                                                                            false);
+  std::shared_ptr<LogisticRegression> fresh_problem = std::make_shared<LogisticRegression>((char*)"logistic_features.txt",
+                                                                                           (char*)"logistic_labels.txt",
+                                                                                           (char*)"logistic_groups.txt",
+                                                                                           (char*)"logistic_initial_point.txt",
+                                                                                           M_VALUE_DOUBLE,
+                                                                                           false,
+                                                                                           1,
+                                                                                           false);
+
+  // Solve with working set of one group (initial point is zero), stopping while restricted
+  FaRSASolver solver;
+  solver.reporter()->deleteReports();
+  solver.options()->modifyBoolValue(solver.reporter(), "working_set", true);
+  solver.options()->modifyIntegerValue(solver.reporter(), "working_set_initial_size", 1);
+  solver.options()->modifyIntegerValue(solver.reporter(), "iteration_limit", 1);
+  solver.optimize(reused_problem);
+
+  // Solve again without working set (restriction of previous solve must be cleared)
+  solver.options()->modifyBoolValue(solver.reporter(), "working_set", false);
+  solver.options()->modifyIntegerValue(solver.reporter(), "iteration_limit", 100);
+  solver.optimize(reused_problem);
+  double reused_objective = solver.objective();
+
+  // Solve fresh problem without working set
+  FaRSASolver fresh_solver;
+  fresh_solver.reporter()->deleteReports();
+  fresh_solver.options()->modifyIntegerValue(fresh_solver.reporter(), "iteration_limit", 100);
+  fresh_solver.optimize(fresh_problem);
+  double fresh_objective = fresh_solver.objective();
+
+  // Check objectives (bitwise identical)
+  if (reused_objective != fresh_objective) {
+    result = 1;
+  }
+
+  // Print objectives
+  reporter.printf(R_SOLVER, R_BASIC, "Testing solve after solve with working set... should match: %+.16e %+.16e\n", reused_objective, fresh_objective);
+
+  // Solve with default (backtracking) line search for increasing iteration limits, from
+  // a large initial stepsize that overshoots and with a large sufficient decrease constant
+  // (Armijo condition, so objective must not increase between iterations)
+  FaRSASolver backtracking_solver;
+  backtracking_solver.reporter()->deleteReports();
+  backtracking_solver.options()->modifyDoubleValue(backtracking_solver.reporter(), "LSB_stepsize_initial", 1e+02);
+  backtracking_solver.options()->modifyDoubleValue(backtracking_solver.reporter(), "LSB_stepsize_sufficient_decrease_threshold", 5e-01);
+  std::vector<double> objectives;
+  for (int k = 0; k <= 10; k++) {
+    backtracking_solver.options()->modifyIntegerValue(backtracking_solver.reporter(), "iteration_limit", k);
+    backtracking_solver.optimize(fresh_problem);
+    objectives.push_back(backtracking_solver.objective());
+    if (k > 0 && objectives[k] > objectives[k - 1]) {
+      result = 1;
+    }
+  } // end for
+  if (objectives[10] >= objectives[0]) {
+    result = 1;
+  }
+
+  // Print objectives
+  reporter.printf(R_SOLVER, R_BASIC, "Testing objectives with backtracking line search... should not increase:\n");
+  for (int k = 0; k <= 10; k++) {
+    reporter.printf(R_SOLVER, R_BASIC, "%2d %+.16e\n", k, objectives[k]);
+  }
+
+  // Solve with default options (must converge)
+  backtracking_solver.options()->modifyDoubleValue(backtracking_solver.reporter(), "LSB_stepsize_initial", 1.0);
+  backtracking_solver.options()->modifyDoubleValue(backtracking_solver.reporter(), "LSB_stepsize_sufficient_decrease_threshold", 1e-10);
+  backtracking_solver.options()->modifyIntegerValue(backtracking_solver.reporter(), "iteration_limit", 10000);
+  backtracking_solver.optimize(fresh_problem);
+  if (backtracking_solver.status() != FARSA_SUCCESS) {
+    result = 1;
+  }
+
+  // Print status
+  reporter.printf(R_SOLVER, R_BASIC, "Testing default solve... should converge: status %d after %d iterations\n", (int)backtracking_solver.status(), backtracking_solver.iterations());
+
+  // Declare problem with data points sharded over two processes
+  std::shared_ptr<LogisticRegression> sharded_problem = std::make_shared<LogisticRegression>((char*)"logistic_features.txt",
+                                                                                             (char*)"logistic_labels.txt",
+                                                                                             (char*)"logistic_groups.txt",
+                                                                                             (char*)"logistic_initial_point.txt",
+                                                                                             M_VALUE_DOUBLE,
+                                                                                             false,
+                                                                                             2,
+                                                                                             false);
+
+  // Solve sharded problem with default options (sums over shards differ only by rounding)
+  FaRSASolver sharded_solver;
+  sharded_solver.reporter()->deleteReports();
+  sharded_solver.options()->modifyIntegerValue(sharded_solver.reporter(), "iteration_limit", 10000);
+  sharded_solver.optimize(sharded_problem);
+  if (sharded_solver.status() != FARSA_SUCCESS ||
+      fabs(sharded_solver.objective() - backtracking_solver.objective()) > 1e-08 * fmax(1.0, fabs(backtracking_solver.objective()))) {
+    result = 1;
+  }
+
+  // Print objectives
+  reporter.printf(R_SOLVER, R_BASIC, "Testing solve with two processes... should match: %+.16e %+.16e\n", sharded_solver.objective(), backtracking_solver.objective());
+
+  // Check option
+  if (option == 1) {
+
+    // Print final message
+    if (result == 0) {
+      reporter.printf(R_SOLVER, R_BASIC, "TEST WAS SUCCESSFUL.\n");
+    }
+    else {
+      reporter.printf(R_SOLVER, R_BASIC, "TEST FAILED.\n");
+    }
+
+  } // end if
+
+  // Return
+  return result;
+
+} // end testLogisticRegressionImplementation
+
+#endif /* __TESTLOGISTICREGRESSION_HPP__ */
@@ -7,8 +7,13 @@
 #ifndef __TESTMATRIX_HPP__
 #define __TESTMATRIX_HPP__
 
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <string>
 
+#include "FaRSADeclarations.hpp"
+#include "FaRSADefinitions.hpp"
 #include "FaRSAEnumerations.hpp"
 #include "FaRSAReporter.hpp"
 #include "FaRSAMatrix.hpp"
@@ -112,6 +117,483 @@ int testMatrixImplementation(int option)
   // Print product
   c.print(&reporter,"Testing matrix-transpose-vector product:");
 
+  // Declare matrix (compressed sparse column)
+  Matrix B;
+
+  // Read from file
+  B.setFromFile(file_name, M_COMPRESSED_SPARSE_COLUMN);
+
+  // Compute matrix-vector product
+  B.matrixVectorProduct(x,b);
+
+  // Check values
+  for (int i = 0; i < 3; i++) {
+    if (b.values()[i] < -1e-12 || b.values()[i] > 1e-12) {
+      result = 1;
+    }
+  } // end for
+
+  // Print product
+  b.print(&reporter,"Testing matrix-vector product (compressed sparse column):");
+
+  // Compute matrix-transpose-vector product
+  B.matrixTransposeVectorProduct(y,c);
+
+  // Check values
+  if (c.values()[0] < 1.357400000000000e+02 - 1e-12 || c.values()[0] > 1.357400000000000e+02 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[4] < -2.376550000000000e+03 - 1e-12 || c.values()[4] > -2.376550000000000e+03 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[5] < 8.144399999999999e+02 - 1e-12 || c.values()[5] > 8.144399999999999e+02 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  c.print(&reporter,"Testing matrix-transpose-vector product (compressed sparse column):");
+
+  // Declare column view
+  std::vector<int> columns;
+  columns.push_back(1);
+  columns.push_back(4);
+
+  // Create vectors for column view products
+  Vector z(2, 1.0);
+  Vector d(2);
+
+  // Compute column-view-vector product
+  B.matrixVectorProductColumns(columns, z, b);
+
+  // Check values
+  if (b.values()[0] < -1e-12 || b.values()[0] > 1e-12) {
+    result = 1;
+  }
+  if (b.values()[1] < 7.7 - 1e-12 || b.values()[1] > 7.7 + 1e-12) {
+    result = 1;
+  }
+  if (b.values()[2] < -1e-12 || b.values()[2] > 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  b.print(&reporter,"Testing column-view-vector product:");
+
+  // Compute column-view-transpose-vector product
+  B.matrixTransposeVectorProductColumns(columns, y, d);
+
+  // Check values
+  if (d.values()[0] < -9.506200000000001e+02 - 1e-12 || d.values()[0] > -9.506200000000001e+02 + 1e-12) {
+    result = 1;
+  }
+  if (d.values()[1] < -2.376550000000000e+03 - 1e-12 || d.values()[1] > -2.376550000000000e+03 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  d.print(&reporter,"Testing column-view-transpose-vector product:");
+
+  // Declare matrix (compressed sparse column, single precision values)
+  Matrix C;
+
+  // Read from file
+  C.setFromFile(file_name, M_COMPRESSED_SPARSE_COLUMN, M_VALUE_FLOAT);
+
+  // Check value type
+  if (C.valueType() != M_VALUE_FLOAT) {
+    result = 1;
+  }
+
+  // Compute matrix-transpose-vector product
+  C.matrixTransposeVectorProduct(y,c);
+
+  // Check values (to single precision accuracy)
+  if (c.values()[0] < 1.357400000000000e+02 - 1e-4 || c.values()[0] > 1.357400000000000e+02 + 1e-4) {
+    result = 1;
+  }
+  if (c.values()[4] < -2.376550000000000e+03 - 1e-3 || c.values()[4] > -2.376550000000000e+03 + 1e-3) {
+    result = 1;
+  }
+
+  // Compute column-view-vector product
+  C.matrixVectorProductColumns(columns, z, b);
+
+  // Check values (to single precision accuracy)
+  if (b.values()[1] < 7.7 - 1e-6 || b.values()[1] > 7.7 + 1e-6) {
+    result = 1;
+  }
+
+  // Print product
+  c.print(&reporter,"Testing matrix-transpose-vector product (single precision values):");
+
+  // Declare matrix (compressed sparse column, detect pattern)
+  Matrix D;
+
+  // Read from file with non-unit values
+  D.setFromFile(file_name, M_COMPRESSED_SPARSE_COLUMN, M_VALUE_DOUBLE, true);
+
+  // Check value type (pattern not detected)
+  if (D.valueType() != M_VALUE_DOUBLE) {
+    result = 1;
+  }
+
+  // Declare matrix (compressed sparse column, detect pattern)
+  Matrix P;
+
+  // Read from file with unit values
+  P.setFromFile((char*)"matrix_pattern.txt", M_COMPRESSED_SPARSE_COLUMN, M_VALUE_DOUBLE, true);
+
+  // Check value type (pattern detected)
+  if (P.valueType() != M_VALUE_PATTERN) {
+    result = 1;
+  }
+
+  // Compute matrix-vector product
+  P.matrixVectorProduct(x,b);
+
+  // Check values
+  if (b.values()[0] < 55.5 - 1e-12 || b.values()[0] > 55.5 + 1e-12) {
+    result = 1;
+  }
+  if (b.values()[1] < -33.3 - 1e-12 || b.values()[1] > -33.3 + 1e-12) {
+    result = 1;
+  }
+  if (b.values()[2] < 11.1 - 1e-12 || b.values()[2] > 11.1 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  b.print(&reporter,"Testing matrix-vector product (pattern):");
+
+  // Compute matrix-transpose-vector product
+  P.matrixTransposeVectorProduct(y,c);
+
+  // Check values
+  if (c.values()[0] < 123.4 - 1e-12 || c.values()[0] > 123.4 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[3] < 121.2 - 1e-12 || c.values()[3] > 121.2 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[4] < -432.1 - 1e-12 || c.values()[4] > -432.1 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  c.print(&reporter,"Testing matrix-transpose-vector product (pattern):");
+
+  // Declare matrix (compressed sparse column, blocked by groups)
+  Matrix E;
+
+  // Read from file
+  E.setFromFile(file_name, M_COMPRESSED_SPARSE_COLUMN);
+
+  // Block columns by groups
+  std::vector<std::vector<int> > groups(2);
+  groups[0].push_back(4);
+  groups[0].push_back(1);
+  groups[1].push_back(0);
+  groups[1].push_back(5);
+  E.blockColumnsByGroups(groups);
+
+  // Compute matrix-transpose-vector product (ordered by original columns)
+  E.matrixTransposeVectorProduct(y,c);
+
+  // Check values
+  if (c.values()[0] < 1.357400000000000e+02 - 1e-12 || c.values()[0] > 1.357400000000000e+02 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[4] < -2.376550000000000e+03 - 1e-12 || c.values()[4] > -2.376550000000000e+03 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[5] < 8.144399999999999e+02 - 1e-12 || c.values()[5] > 8.144399999999999e+02 + 1e-12) {
+    result = 1;
+  }
+
+  // Compute column-view-vector product (ordered by original columns)
+  E.matrixVectorProductColumns(columns, z, b);
+
+  // Check values
+  if (b.values()[1] < 7.7 - 1e-12 || b.values()[1] > 7.7 + 1e-12) {
+    result = 1;
+  }
+
+  // Declare group view
+  std::vector<int> group_view;
+  group_view.push_back(1);
+  group_view.push_back(0);
+
+  // Compute group-view-transpose-vector product (ordered by concatenation of groups)
+  Vector e(4);
+  E.matrixTransposeVectorProductGroups(group_view, y, e);
+
+  // Check values
+  if (e.values()[0] < 1.357400000000000e+02 - 1e-12 || e.values()[0] > 1.357400000000000e+02 + 1e-12) {
+    result = 1;
+  }
+  if (e.values()[1] < 8.144399999999999e+02 - 1e-12 || e.values()[1] > 8.144399999999999e+02 + 1e-12) {
+    result = 1;
+  }
+  if (e.values()[2] < -2.376550000000000e+03 - 1e-12 || e.values()[2] > -2.376550000000000e+03 + 1e-12) {
+    result = 1;
+  }
+  if (e.values()[3] < -9.506200000000001e+02 - 1e-12 || e.values()[3] > -9.506200000000001e+02 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  e.print(&reporter,"Testing group-view-transpose-vector product:");
+
+  // Compute group-view-vector product
+  group_view.erase(group_view.begin());
+  E.matrixVectorProductGroups(group_view, z, b);
+
+  // Check values
+  if (b.values()[0] < -1e-12 || b.values()[0] > 1e-12) {
+    result = 1;
+  }
+  if (b.values()[1] < 7.7 - 1e-12 || b.values()[1] > 7.7 + 1e-12) {
+    result = 1;
+  }
+  if (b.values()[2] < -1e-12 || b.values()[2] > 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  b.print(&reporter,"Testing group-view-vector product:");
+
+  // Place matrix (three parts, each copied by its thread)
+  ThreadPool thread_pool(3, false);
+  Placement placement(&thread_pool);
+  E.place(placement, "E");
+
+  // Check column partition
+  if (E.columnPartition().size() != 4 || E.columnPartition()[0] != 0 || E.columnPartition()[3] != 6) {
+    result = 1;
+  }
+
+  // Compute matrix-transpose-vector product (unchanged by placement)
+  E.matrixTransposeVectorProduct(y,c);
+
+  // Check values
+  if (c.values()[0] < 1.357400000000000e+02 - 1e-12 || c.values()[0] > 1.357400000000000e+02 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[4] < -2.376550000000000e+03 - 1e-12 || c.values()[4] > -2.376550000000000e+03 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  c.print(&reporter,"Testing matrix-transpose-vector product (placed):");
+
+  // Write matrix to binary file
+  char* binary_file_name = (char*)"matrix_test.bin";
+  B.writeToBinaryFile(binary_file_name);
+
+  // Declare matrix (compressed sparse row, out-of-core)
+  Matrix F;
+
+  // Check binary file
+  if (!Matrix::isBinaryFile(binary_file_name) || Matrix::isBinaryFile(file_name)) {
+    result = 1;
+  }
+
+  // Read from binary file (small block size so that rows are streamed in several blocks)
+  F.setFromBinaryFile(binary_file_name, 16);
+
+  // Compute matrix-vector product
+  F.matrixVectorProduct(x,b);
+
+  // Check values
+  for (int i = 0; i < 3; i++) {
+    if (b.values()[i] < -1e-12 || b.values()[i] > 1e-12) {
+      result = 1;
+    }
+  } // end for
+
+  // Compute matrix-transpose-vector product
+  F.matrixTransposeVectorProduct(y,c);
+
+  // Check values
+  if (c.values()[0] < 1.357400000000000e+02 - 1e-12 || c.values()[0] > 1.357400000000000e+02 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[1] < -9.506200000000001e+02 - 1e-12 || c.values()[1] > -9.506200000000001e+02 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[5] < 8.144399999999999e+02 - 1e-12 || c.values()[5] > 8.144399999999999e+02 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  c.print(&reporter,"Testing matrix-transpose-vector product (out-of-core):");
+
+  // Remove binary file
+  remove(binary_file_name);
+
+  // Declare matrices (Matrix Market file, compressed sparse column and row)
+  Matrix G;
+  Matrix H;
+
+  // Read from file
+  G.setFromFile((char*)"matrix.mtx", M_COMPRESSED_SPARSE_COLUMN);
+  H.setFromMatrixMarketFile((char*)"matrix.mtx", M_COMPRESSED_SPARSE_ROW);
+
+  // Compute matrix-vector products
+  G.matrixVectorProduct(x,b);
+  H.matrixVectorProduct(x,y);
+
+  // Check values
+  for (int i = 0; i < 3; i++) {
+    if (b.values()[i] < -1e-12 || b.values()[i] > 1e-12 || y.values()[i] < -1e-12 || y.values()[i] > 1e-12) {
+      result = 1;
+    }
+  } // end for
+
+  // Compute matrix-transpose-vector products
+  y.valuesModifiable()[0] =  123.4;
+  y.valuesModifiable()[1] = -432.1;
+  y.valuesModifiable()[2] =  121.2;
+  G.matrixTransposeVectorProduct(y,c);
+  H.matrixTransposeVectorProduct(y,x);
+
+  // Check values
+  if (c.values()[1] < -9.506200000000001e+02 - 1e-12 || c.values()[1] > -9.506200000000001e+02 + 1e-12 ||
+      x.values()[1] < -9.506200000000001e+02 - 1e-12 || x.values()[1] > -9.506200000000001e+02 + 1e-12) {
+    result = 1;
+  }
+  if (c.values()[4] < -2.376550000000000e+03 - 1e-12 || c.values()[4] > -2.376550000000000e+03 + 1e-12 ||
+      x.values()[4] < -2.376550000000000e+03 - 1e-12 || x.values()[4] > -2.376550000000000e+03 + 1e-12) {
+    result = 1;
+  }
+
+  // Print product
+  x.print(&reporter,"Testing matrix-transpose-vector product (Matrix Market, compressed sparse row):");
+
+  // Declare matrix (coordinate text file, compressed sparse row)
+  Matrix R;
+
+  // Read from file
+  R.setFromFile(file_name, M_COMPRESSED_SPARSE_ROW);
+
+  // Compute matrix-transpose-vector product
+  R.matrixTransposeVectorProduct(y,x);
+
+  // Check values (bitwise identical to compressed sparse row from Matrix Market file)
+  H.matrixTransposeVectorProduct(y,c);
+  if (R.sparseFormat() != M_COMPRESSED_SPARSE_ROW) {
+    result = 1;
+  }
+  for (int j = 0; j < 6; j++) {
+    if (x.values()[j] != c.values()[j]) {
+      result = 1;
+    }
+  } // end for
+
+  // Print product
+  x.print(&reporter,"Testing matrix-transpose-vector product (compressed sparse row):");
+
+  // Declare matrix (symmetric Matrix Market pattern file, lower triangle mirrored)
+  Matrix S;
+
+  // Read from file
+  S.setFromFile((char*)"matrix_symmetric.mtx", M_COMPRESSED_SPARSE_COLUMN);
+
+  // Compute matrix-vector product
+  Vector s(3);
+  y.valuesModifiable()[0] = 1.0;
+  y.valuesModifiable()[1] = 2.0;
+  y.valuesModifiable()[2] = 3.0;
+  S.matrixVectorProduct(y,s);
+
+  // Check values (pattern [1 1 0; 1 0 1; 0 1 0] times (1,2,3))
+  if (S.valueType() != M_VALUE_PATTERN || S.numberOfNonzeros() != 5 ||
+      s.values()[0] != 3.0 || s.values()[1] != 4.0 || s.values()[2] != 2.0) {
+    result = 1;
+  }
+
+  // Print product
+  s.print(&reporter,"Testing matrix-vector product (symmetric Matrix Market pattern):");
+
+  // Declare matrix (compressed sparse column, pattern requested for non-unit values)
+  Matrix Q;
+
+  // Read from file (should fail)
+  bool pattern_rejected = false;
+  try {
+    Q.setFromFile(file_name, M_COMPRESSED_SPARSE_COLUMN, M_VALUE_PATTERN);
+  } catch (FARSA_MATRIX_EXCEPTION& exec) {
+    pattern_rejected = true;
+  }
+  if (!pattern_rejected) {
+    result = 1;
+  }
+
+  // Declare matrices (read with cache: sidecar written, then sidecar read)
+  Matrix C1;
+  Matrix C2;
+
+  // Read from file twice
+  C1.setFromFile((char*)"matrix.mtx", M_COMPRESSED_SPARSE_COLUMN, M_VALUE_FLOAT, false, true);
+  C2.setFromFile((char*)"matrix.mtx", M_COMPRESSED_SPARSE_COLUMN, M_VALUE_FLOAT, false, true);
+  std::string cache_file_name = std::string("matrix.mtx") + FARSA_CACHE_SUFFIX;
+  FILE* cache_file = fopen(cache_file_name.c_str(), "rb");
+  if (cache_file == NULL) {
+    result = 1;
+  }
+  else {
+    fclose(cache_file);
+  }
+  remove(cache_file_name.c_str());
+
+  // Compute matrix-transpose-vector products
+  C1.matrixTransposeVectorProduct(y,c);
+  C2.matrixTransposeVectorProduct(y,x);
+
+  // Check values (bitwise identical)
+  if (C2.valueType() != M_VALUE_FLOAT || C2.numberOfNonzeros() != C1.numberOfNonzeros()) {
+    result = 1;
+  }
+  for (int i = 0; i < c.length(); i++) {
+    if (c.values()[i] != x.values()[i]) {
+      result = 1;
+    }
+  } // end for
+
+  // Print product
+  x.print(&reporter,"Testing matrix-transpose-vector product (read from cache):");
+
+  // Check column and row norms (computed when matrix was read)
+  std::vector<int> norm_columns = {0, 5};
+  for (int j = 0; j < 6; j++) {
+    if (A.columnNorms()[j] < 1.1 * (j + 1) - 1e-12 || A.columnNorms()[j] > 1.1 * (j + 1) + 1e-12) {
+      result = 1;
+    }
+  } // end for
+  if (A.rowNorms()[0] < sqrt(1.1 * 1.1 + 6.6 * 6.6) - 1e-12 || A.rowNorms()[0] > sqrt(1.1 * 1.1 + 6.6 * 6.6) + 1e-12 ||
+      A.spectralNormBound(norm_columns) != A.rowNorms()[0]) {
+    result = 1;
+  }
+
+  // Print norms
+  reporter.printf(R_SOLVER, R_BASIC, "Testing norms... should be 1.1, 6.6, and 6.691039: %+e %+e %+e\n", A.columnNorms()[0], A.columnNorms()[5], A.spectralNormBound(norm_columns));
+
+  // Estimate squared spectral norms (rows have disjoint columns, so squared spectral norm
+  // is largest squared row norm; submatrix of columns 0 and 5 has rank one)
+  double squared_norm = 0.0;
+  double squared_norm_columns = 0.0;
+  if (!A.estimateSquaredSpectralNorm(std::vector<int>(), 50, 1e-06, nullptr, squared_norm) ||
+      squared_norm < 0.99 * 44.77 || squared_norm > 44.77 + 1e-10) {
+    result = 1;
+  }
+  if (!G.estimateSquaredSpectralNorm(std::vector<int>(1, 4), 50, 1e-06, nullptr, squared_norm_columns) ||
+      squared_norm_columns < G.columnNorms()[4] * G.columnNorms()[4] - 1e-10 || squared_norm_columns > G.columnNorms()[4] * G.columnNorms()[4] + 1e-10) {
+    result = 1;
+  }
+
+  // Print estimates
+  reporter.printf(R_SOLVER, R_BASIC, "Testing spectral norm estimates... should be near 44.77 and %+e: %+e %+e\n", G.columnNorms()[4] * G.columnNorms()[4], squared_norm, squared_norm_columns);
+
   // Check option
   if (option == 1) {
 
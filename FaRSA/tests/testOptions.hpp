@@ -182,6 +182,7 @@ int testOptionsImplementation(int option)
   bool b;
   double d;
   int i;
+  int j;
   std::string s;
 
   // Get values
@@ -337,6 +338,30 @@ int testOptionsImplementation(int option)
     result = 1;
   }
 
+  // Share schema (modified values start at defaults and are kept separately)
+  reporter.printf(R_SOLVER, R_BASIC, "Sharing schema... should be no error message:\n");
+  Options o2;
+  o2.shareSchema(o);
+  o2.valueAsInteger(&reporter, "i", i);
+  if (o2.numberOfOptions() != o.numberOfOptions() || o2.valueAsInteger(&reporter, "z", j) || i != 1) {
+    result = 1;
+  }
+  o2.modifyIntegerValue(&reporter, "i", 2);
+  o.valueAsInteger(&reporter, "i", i);
+  if (i != 0) {
+    result = 1;
+  }
+
+  // Add option to shared schema (schema copied, so other Options are not affected)
+  temp = o2.addIntegerOption(&reporter, "j", 1, 0, 2, "Option added after sharing");
+  if (temp == false || !o2.valueAsInteger(&reporter, "j", j) || o.valueAsInteger(&reporter, "j", j)) {
+    result = 1;
+  }
+  o2.valueAsInteger(&reporter, "i", i);
+  if (i != 2) {
+    result = 1;
+  }
+
   // Check option
   if (option == 1) {
     // Print final message
@@ -157,6 +157,91 @@ int testReporterImplementation(int option)
   remove("FaRSA_filereport_SOLVER.txt");
   remove("FaRSA_filereport_SUBSOLVER.txt");
 
+  // Declare reporter with asynchronous file report (small ring, so caller must wait)
+  Reporter ra;
+  ra.addFileReport("a", "FaRSA_filereport_ASYNC.txt", R_SOLVER, R_PER_ITERATION);
+  ra.makeReportsAsync(4, R_BLOCK_WHEN_FULL);
+
+  // Print lines, including one longer than a slot
+  std::string long_line(3 * FARSA_ASYNC_REPORT_SLOT_SIZE + 7, 'x');
+  for (int i = 0; i < 1000; i++) {
+    ra.printf(R_SOLVER, R_PER_ITERATION, "Line %d\n", i);
+    ra.flushBuffer();
+  }
+  ra.printf(R_SOLVER, R_PER_ITERATION, "%s\n", long_line.c_str());
+  ra.printf(R_SOLVER, R_PER_INNER_ITERATION, "NOT ACCEPTED\n");
+
+  // Make report synchronous, then print line directly
+  ra.makeReportsSynchronous();
+  ra.printf(R_SOLVER, R_BASIC, "Last line\n");
+  ra.deleteReports();
+
+  // Read FaRSA_filereport_ASYNC.txt and check values
+  std::ifstream infile3("FaRSA_filereport_ASYNC.txt");
+  std::string line3;
+  for (int i = 0; i < 1000; i++) {
+    std::getline(infile3, line3);
+    if (line3.compare("Line " + std::to_string(i)) != 0) {
+      result = 1;
+    }
+  } // end for
+  std::getline(infile3, line3);
+  if (line3.compare(long_line) != 0) {
+    result = 1;
+  }
+  std::getline(infile3, line3);
+  if (line3.compare("Last line") != 0) {
+    result = 1;
+  }
+
+  // Delete file
+  remove("FaRSA_filereport_ASYNC.txt");
+
+  // Declare reporter with event log
+  Reporter re;
+  std::shared_ptr<EventLog> event_log(new EventLog());
+  event_log->open("FaRSA_eventlog.bin");
+  re.setEventLog(event_log);
+
+  // Print and record (printed arguments not evaluated, since no report accepts)
+  int evaluations = 0;
+  int custom = event_log->defineEvent("custom", {"count", "value"}, {E_FIELD_INT, E_FIELD_DOUBLE});
+  FARSA_PRINTF(&re, R_SOLVER, R_PER_ITERATION, "%d\n", ++evaluations);
+  FARSA_EVENT(&re, E_ITERATION, 3, 0.25);
+  FARSA_EVENT(&re, E_STEPSIZE, 0.5);
+  FARSA_EVENT(&re, custom, 7);
+  if (evaluations != 0 || re.accepts(R_SOLVER, R_BASIC)) {
+    result = 1;
+  }
+
+  // Close event log and decode
+  event_log->close();
+  FILE* decoded = fopen("FaRSA_eventlog.txt", "w");
+  if (!EventLog::decode("FaRSA_eventlog.bin", decoded)) {
+    result = 1;
+  }
+  fclose(decoded);
+
+  // Read FaRSA_eventlog.txt and check values
+  std::ifstream infile4("FaRSA_eventlog.txt");
+  std::string line4;
+  std::getline(infile4, line4);
+  if (line4.compare("iteration iteration=3 objective=0.25") != 0) {
+    result = 1;
+  }
+  std::getline(infile4, line4);
+  if (line4.compare("stepsize stepsize=0.5") != 0) {
+    result = 1;
+  }
+  std::getline(infile4, line4);
+  if (line4.compare("custom count=7 value=0") != 0) {
+    result = 1;
+  }
+
+  // Delete files
+  remove("FaRSA_eventlog.bin");
+  remove("FaRSA_eventlog.txt");
+
   // Check option
   if (option == 1) {
     // Print final message
@@ -8,8 +8,12 @@
 #define __TESTVECTOR_HPP__
 
 #include <iostream>
+#include <memory>
+#include <thread>
 
+#include "FaRSADefinitions.hpp"
 #include "FaRSAReporter.hpp"
+#include "FaRSAThreadPool.hpp"
 #include "FaRSAVector.hpp"
 
 using namespace FaRSA;
@@ -290,6 +294,134 @@ int testVectorImplementation(int option)
   // Print matrix
   b.print(&reporter,"Testing read from file:");
 
+  // Write binary file, then map it
+  char* binary_file_name = (char*)"vector.bin";
+  b.writeToBinaryFile(binary_file_name);
+  Vector c;
+  c.setFromFile(binary_file_name);
+
+  // Check values (aliasing file)
+  if (!Vector::isBinaryFile(binary_file_name) || !c.isMapped() || c.length() != b.length()) {
+    result = 1;
+  }
+  for (int i = 0; i < b.length() && i < c.length(); i++) {
+    if (c.values()[i] != b.values()[i]) {
+      result = 1;
+    }
+  }
+
+  // Modify mapped vector, then map file again (file not modified)
+  c.set(0, -1.0);
+  double norm1_mapped = c.norm1();
+  Vector d;
+  d.setFromBinaryFile(binary_file_name);
+  if (d.values()[0] != b.values()[0] || norm1_mapped < 22.5 - 1e-12 || norm1_mapped > 22.5 + 1e-12) {
+    result = 1;
+  }
+  remove(binary_file_name);
+
+  // Print values
+  reporter.printf(R_SOLVER, R_BASIC, "Testing binary file... should be -1 and 1.6: %+e %+e\n", c.values()[0], d.values()[0]);
+
+  // Read from file with cache twice (sidecar written, then sidecar mapped)
+  Vector e;
+  Vector f;
+  e.setFromFile(file_name, true);
+  f.setFromFile(file_name, true);
+  std::string cache_file_name = std::string(file_name) + FARSA_CACHE_SUFFIX;
+  remove(cache_file_name.c_str());
+
+  // Check values (aliasing sidecar)
+  if (e.isMapped() || !f.isMapped() || f.length() != b.length()) {
+    result = 1;
+  }
+  for (int i = 0; i < b.length() && i < f.length(); i++) {
+    if (f.values()[i] != b.values()[i]) {
+      result = 1;
+    }
+  }
+
+  // Declare long vectors (operations split into several chunks)
+  Vector p(100000, 1.0);
+  Vector q(100000, 2.0);
+
+  // Run operations on thread pool
+  std::shared_ptr<ThreadPool> thread_pool = std::make_shared<ThreadPool>(4, false);
+  p.setThreadPool(thread_pool);
+  p.addScaledVector(2.0, q);
+  double inner_product = p.innerProduct(q);
+  double norm1 = p.norm1();
+
+  // Check thread pool of made vector (shared) and of other vector (unset)
+  if (p.makeNewCopy()->threadPool() != thread_pool || q.threadPool() != nullptr) {
+    result = 1;
+  }
+  p.setThreadPool(nullptr);
+
+  // Check values
+  if (p.values()[0] < 5.0 - 1e-12 || p.values()[0] > 5.0 + 1e-12 || p.values()[99999] < 5.0 - 1e-12 || p.values()[99999] > 5.0 + 1e-12) {
+    result = 1;
+  }
+  if (inner_product < 1e+06 - 1e-06 || inner_product > 1e+06 + 1e-06) {
+    result = 1;
+  }
+  if (norm1 < 5e+05 - 1e-06 || norm1 > 5e+05 + 1e-06) {
+    result = 1;
+  }
+
+  // Print values
+  reporter.printf(R_SOLVER, R_BASIC, "Testing operations on thread pool... should be 1e+06 and 5e+05: %e %e\n", inner_product, norm1);
+
+  // Set vector with values that are not exactly summed
+  for (int i = 0; i < p.length(); i++) {
+    p.set(i, 1.0 / (1.0 + i));
+  }
+
+  // Compute inner products with deterministic reductions on pools of different sizes
+  std::shared_ptr<ThreadPool> other_thread_pool = std::make_shared<ThreadPool>(3, false);
+  thread_pool->setDeterministicReductions(true);
+  other_thread_pool->setDeterministicReductions(true);
+  p.setThreadPool(thread_pool);
+  double inner_product_4 = p.innerProduct(p);
+  p.setThreadPool(other_thread_pool);
+  double inner_product_3 = p.innerProduct(p);
+  p.setThreadPool(nullptr);
+
+  // Check values (bitwise identical)
+  if (inner_product_4 != inner_product_3) {
+    result = 1;
+  }
+
+  // Print values
+  reporter.printf(R_SOLVER, R_BASIC, "Testing deterministic reductions... should be equal: %.17e %.17e\n", inner_product_4, inner_product_3);
+
+  // Compute inner products concurrently in two threads, each with vectors on its own pool
+  // (e.g., two solvers), releasing pools as threads finish
+  double concurrent_inner_products[2] = {0.0, 0.0};
+  std::thread threads[2];
+  for (int k = 0; k < 2; k++) {
+    threads[k] = std::thread([&, k]() {
+      Vector r(100000, 1.0 + k);
+      r.setThreadPool(std::make_shared<ThreadPool>(2 + k, false));
+      for (int repeat = 0; repeat < 100; repeat++) {
+        concurrent_inner_products[k] = r.innerProduct(r);
+      }
+      r.setThreadPool(nullptr);
+    });
+  } // end for
+  for (int k = 0; k < 2; k++) {
+    threads[k].join();
+  }
+
+  // Check values
+  if (concurrent_inner_products[0] < 1e+05 - 1e-06 || concurrent_inner_products[0] > 1e+05 + 1e-06 ||
+      concurrent_inner_products[1] < 4e+05 - 1e-06 || concurrent_inner_products[1] > 4e+05 + 1e-06) {
+    result = 1;
+  }
+
+  // Print values
+  reporter.printf(R_SOLVER, R_BASIC, "Testing operations on concurrent thread pools... should be 1e+05 and 4e+05: %e %e\n", concurrent_inner_products[0], concurrent_inner_products[1]);
+
   // Check option
   if (option == 1) {
 